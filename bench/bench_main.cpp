@@ -0,0 +1,716 @@
+/**
+ * Benchmarks of the command, telemetry and scheduling paths on the host
+ *
+ * Build and run with: pio run -e native -t exec
+ *
+ * Each benchmark reports the average wall time and heap allocations per
+ * operation for several problem sizes n.
+ */
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <TaskScheduler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bench_services.h"
+#include "bench_types.h"
+#include "benchmark.h"
+#include "managers/message_batcher.h"
+#include "managers/message_parser.h"
+#include "managers/services.h"
+#include "managers/telemetry_journal.h"
+#include "peripheral/adc/adc_calibration.h"
+#include "peripheral/adc/adc_engine.h"
+#include "peripheral/adc/synthetic_source.h"
+#include "tasks/get_values_task/get_values_task.h"
+#include "tasks/poll_group/poll_group.h"
+#include "tasks/poll_sensor/poll_sensor.h"
+#include "tasks/read_sensor/read_sensor.h"
+#include "utils/json_document_pool.h"
+#include "utils/filter.h"
+#include "utils/flash_storage.h"
+#include "utils/piecewise_linear.h"
+#include "utils/spsc_queue.h"
+#include "utils/worker_thread.h"
+
+namespace bernd_box {
+namespace bench {
+namespace {
+
+/// Problem sizes each benchmark is run with
+const size_t sizes[] = {1, 4, 16};
+/// Number of measured operations per benchmark and size
+const size_t iterations = 2000;
+/// Capacity of the JSON docs holding the benchmark commands
+const size_t command_doc_size = 16 * 1024;
+
+std::vector<String> makeUUIDs(size_t n) {
+  std::vector<String> uuids;
+  for (size_t i = 0; i < n; i++) {
+    uuids.push_back(utils::UUID().toString());
+  }
+  return uuids;
+}
+
+void makePeripheralCommand(const char* command,
+                           const std::vector<String>& uuids,
+                           unsigned int data_point_count,
+                           DynamicJsonDocument& doc) {
+  doc["type"] = "cmd";
+  JsonArray commands =
+      doc.createNestedObject("peripheral").createNestedArray(command);
+  for (const auto& uuid : uuids) {
+    JsonObject peripheral = commands.createNestedObject();
+    peripheral["uuid"] = uuid;
+    peripheral["type"] = BenchSensor::type();
+    peripheral["data_point_count"] = data_point_count;
+  }
+}
+
+void makeTaskCommand(const char* command, const std::vector<String>& uuids,
+                     DynamicJsonDocument& doc) {
+  doc["type"] = "cmd";
+  JsonArray commands =
+      doc.createNestedObject("task").createNestedArray(command);
+  for (const auto& uuid : uuids) {
+    JsonObject task = commands.createNestedObject();
+    task["uuid"] = uuid;
+    task["type"] = BenchTask::type();
+  }
+}
+
+/**
+ * Deserializes a command adding n peripherals as received from the server
+ *
+ * Copying deserializes the read-only frame into a fixed doc as before, while
+ * the parser deserializes a copy in place and skips the unused keys.
+ */
+Result benchParse(size_t n, bool use_parser) {
+  DynamicJsonDocument command_doc(command_doc_size);
+  makePeripheralCommand("add", makeUUIDs(n), 1, command_doc);
+  command_doc["origin"] = "bench";
+  std::vector<char> frame(measureJson(command_doc));
+  serializeJson(command_doc, frame.data(), frame.size());
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(frame.data());
+
+  MessageParser parser(BB_JSON_PAYLOAD_SIZE, command_doc_size);
+  peripheral::PeripheralController::addFilterKeys(parser.getFilter());
+  std::vector<char> buffer;
+  std::unique_ptr<DynamicJsonDocument> doc;
+  DynamicJsonDocument copy_doc(command_doc_size);
+
+  const char* name = use_parser ? "parse.zero_copy+filter" : "parse.copy";
+  Result result = measure(name, n, iterations, [&]() {
+    if (use_parser) {
+      parser.parse(data, frame.size(), WireFormat::kJson, buffer, doc);
+    } else {
+      deserializeJson(copy_doc, data, frame.size());
+    }
+  });
+  result.bytes_per_op = frame.size();
+  return result;
+}
+
+/// Adds and removes n peripherals per operation
+Result benchPeripheralCommands(size_t n) {
+  const std::vector<String> uuids = makeUUIDs(n);
+  DynamicJsonDocument add_doc(command_doc_size);
+  makePeripheralCommand("add", uuids, 1, add_doc);
+  DynamicJsonDocument remove_doc(command_doc_size);
+  makePeripheralCommand("remove", uuids, 1, remove_doc);
+
+  auto& controller = Services::getPeripheralController();
+  return measure("peripheral.add+remove", n, iterations, [&]() {
+    controller.handleCallback(add_doc.as<JsonObjectConst>());
+    controller.handleCallback(remove_doc.as<JsonObjectConst>());
+  });
+}
+
+/**
+ * Looks up each of n peripherals per operation, either by its UUID or by the
+ * handle of an earlier lookup
+ */
+Result benchPeripheralLookup(size_t n, bool use_handle) {
+  const std::vector<String> uuid_strings = makeUUIDs(n);
+  DynamicJsonDocument add_doc(command_doc_size);
+  makePeripheralCommand("add", uuid_strings, 1, add_doc);
+  DynamicJsonDocument remove_doc(command_doc_size);
+  makePeripheralCommand("remove", uuid_strings, 1, remove_doc);
+  auto& controller = Services::getPeripheralController();
+  controller.handleCallback(add_doc.as<JsonObjectConst>());
+
+  std::vector<utils::UUID> uuids;
+  std::vector<peripheral::PeripheralHandle> handles;
+  for (const auto& uuid_string : uuid_strings) {
+    uuids.emplace_back(uuid_string.c_str());
+    handles.push_back(controller.getPeripheral(uuids.back()).getHandle());
+  }
+
+  const char* name =
+      use_handle ? "peripheral.lookup.handle" : "peripheral.lookup.uuid";
+  volatile size_t sink = 0;
+  Result result = measure(name, n, iterations * 10, [&]() {
+    for (size_t i = 0; i < n; i++) {
+      auto peripheral = use_handle ? controller.getPeripheral(handles[i])
+                                   : controller.getPeripheral(uuids[i]);
+      sink = sink + bool(peripheral);
+    }
+  });
+
+  controller.handleCallback(remove_doc.as<JsonObjectConst>());
+  return result;
+}
+
+/// Starts and stops n tasks per operation, including their removal
+Result benchTaskCommands(size_t n) {
+  const std::vector<String> uuids = makeUUIDs(n);
+  DynamicJsonDocument start_doc(command_doc_size);
+  makeTaskCommand("start", uuids, start_doc);
+  DynamicJsonDocument stop_doc(command_doc_size);
+  makeTaskCommand("stop", uuids, stop_doc);
+
+  return measure("task.start+stop", n, iterations, [&]() {
+    getTaskController().handleCallback(start_doc.as<JsonObjectConst>());
+    getTaskController().handleCallback(stop_doc.as<JsonObjectConst>());
+    Services::getScheduler().execute();
+  });
+}
+
+/**
+ * Starts n single reading PollSensor tasks per operation and runs them
+ *
+ * Each start command either carries the full parameters or references a
+ * template, which looked up the peripheral once.
+ */
+Result benchTaskStart(size_t n, bool use_template) {
+  const std::vector<String> peripheral_uuids = makeUUIDs(1);
+  DynamicJsonDocument add_doc(command_doc_size);
+  makePeripheralCommand("add", peripheral_uuids, 1, add_doc);
+  DynamicJsonDocument remove_doc(command_doc_size);
+  makePeripheralCommand("remove", peripheral_uuids, 1, remove_doc);
+  Services::getPeripheralController().handleCallback(
+      add_doc.as<JsonObjectConst>());
+
+  DynamicJsonDocument template_doc(command_doc_size);
+  JsonObject task_template = template_doc.createNestedObject("task")
+                                 .createNestedArray("template")
+                                 .createNestedObject();
+  task_template["template"] = 0;
+  task_template["type"] = tasks::poll_sensor::PollSensor::type();
+  task_template["peripheral"] = peripheral_uuids[0];
+  task_template["interval_ms"] = 1000;
+  task_template["duration_ms"] = 0;
+  getTaskController().handleCallback(template_doc.as<JsonObjectConst>());
+
+  DynamicJsonDocument start_doc(command_doc_size);
+  start_doc["type"] = "cmd";
+  JsonArray commands =
+      start_doc.createNestedObject("task").createNestedArray("start");
+  for (const auto& uuid : makeUUIDs(n)) {
+    JsonObject task = commands.createNestedObject();
+    task["uuid"] = uuid;
+    if (use_template) {
+      task["template"] = 0;
+    } else {
+      task["type"] = tasks::poll_sensor::PollSensor::type();
+      task["peripheral"] = peripheral_uuids[0];
+      task["interval_ms"] = 1000;
+      task["duration_ms"] = 0;
+    }
+  }
+
+  // The tasks end after their first reading and are removed in the next pass
+  const char* name = use_template ? "task.start.template" : "task.start.json";
+  Result result = measure(name, n, iterations, [&]() {
+    getTaskController().handleCallback(start_doc.as<JsonObjectConst>());
+    Services::getScheduler().execute();
+    Services::getScheduler().execute();
+  });
+
+  Services::getPeripheralController().handleCallback(
+      remove_doc.as<JsonObjectConst>());
+  return result;
+}
+
+/// Runs one scheduler pass with n running tasks
+Result benchSchedulerPass(size_t n) {
+  const std::vector<String> uuids = makeUUIDs(n);
+  DynamicJsonDocument start_doc(command_doc_size);
+  makeTaskCommand("start", uuids, start_doc);
+  DynamicJsonDocument stop_doc(command_doc_size);
+  makeTaskCommand("stop", uuids, stop_doc);
+
+  getTaskController().handleCallback(start_doc.as<JsonObjectConst>());
+  Result result = measure("scheduler.pass", n, iterations * 10,
+                          []() { Services::getScheduler().execute(); });
+  getTaskController().handleCallback(stop_doc.as<JsonObjectConst>());
+  Services::getScheduler().execute();
+  return result;
+}
+
+/**
+ * Looks up tasks with n other tasks running: requests the status of all tasks
+ * and stops an unknown task
+ */
+Result benchTaskLookup(size_t n) {
+  const std::vector<String> uuids = makeUUIDs(n);
+  DynamicJsonDocument start_doc(command_doc_size);
+  makeTaskCommand("start", uuids, start_doc);
+  DynamicJsonDocument stop_doc(command_doc_size);
+  makeTaskCommand("stop", uuids, stop_doc);
+  DynamicJsonDocument lookup_doc(command_doc_size);
+  makeTaskCommand("stop", makeUUIDs(1), lookup_doc);
+  lookup_doc["task"]["status"] = true;
+
+  getTaskController().handleCallback(start_doc.as<JsonObjectConst>());
+  Result result = measure("task.stop+status", n, iterations, [&]() {
+    getTaskController().handleCallback(lookup_doc.as<JsonObjectConst>());
+  });
+  getTaskController().handleCallback(stop_doc.as<JsonObjectConst>());
+  Services::getScheduler().execute();
+  return result;
+}
+
+/**
+ * Reads n sensors and sends their telemetry, either with a PollSensor task per
+ * sensor or with a single PollGroup task
+ */
+Result benchPollGroup(size_t n, bool use_group) {
+  const std::vector<String> peripheral_uuids = makeUUIDs(n);
+  DynamicJsonDocument add_doc(command_doc_size);
+  makePeripheralCommand("add", peripheral_uuids, 1, add_doc);
+  DynamicJsonDocument remove_doc(command_doc_size);
+  makePeripheralCommand("remove", peripheral_uuids, 1, remove_doc);
+  Services::getPeripheralController().handleCallback(
+      add_doc.as<JsonObjectConst>());
+
+  std::vector<tasks::BaseTask*> tasks;
+  DynamicJsonDocument task_doc(command_doc_size);
+  task_doc["interval_ms"] = 1000;
+  if (use_group) {
+    task_doc["type"] = tasks::poll_group::PollGroup::type();
+    task_doc["uuid"] = utils::UUID();
+    JsonArray peripherals = task_doc.createNestedArray("peripherals");
+    for (const auto& uuid : peripheral_uuids) {
+      peripherals.add(uuid);
+    }
+    tasks.push_back(getTaskFactory().startTask(task_doc.as<JsonObjectConst>()));
+  } else {
+    task_doc["type"] = tasks::poll_sensor::PollSensor::type();
+    for (const auto& uuid : peripheral_uuids) {
+      task_doc["uuid"] = utils::UUID();
+      task_doc["peripheral"] = uuid;
+      tasks.push_back(
+          getTaskFactory().startTask(task_doc.as<JsonObjectConst>()));
+    }
+  }
+
+  getFakeServer().reset();
+  const char* name = use_group ? "poll.group" : "poll.sensors";
+  Result result = measure(name, n, iterations, [&]() {
+    for (tasks::BaseTask* task : tasks) {
+      task->TaskCallback();
+    }
+  });
+  getFakeServer().flush();
+  // Include the warm-up call of measure()
+  result.bytes_per_op =
+      static_cast<double>(getFakeServer().getByteCount()) / (iterations + 1);
+
+  // Remove the tasks before the peripherals they are using
+  for (tasks::BaseTask* task : tasks) {
+    task->disable();
+  }
+  Services::getScheduler().execute();
+  Services::getPeripheralController().handleCallback(
+      remove_doc.as<JsonObjectConst>());
+  return result;
+}
+
+/// How the telemetry benchmark sends the telemetry
+struct TelemetryOptions {
+  const char* name;
+  /// Whether to also serialize the telemetry for the server
+  bool send;
+  /// The wire format the telemetry is sent in
+  WireFormat format;
+  /// Whether the UUIDs are referenced by handles
+  bool use_uuid_handles;
+};
+
+/**
+ * Creates telemetry for a peripheral with n data points
+ *
+ * \param options How the telemetry is sent
+ */
+Result benchTelemetry(size_t n, const TelemetryOptions& options) {
+  const std::vector<String> uuids = makeUUIDs(2);
+  DynamicJsonDocument add_doc(command_doc_size);
+  makePeripheralCommand("add", {uuids[0]}, n, add_doc);
+  DynamicJsonDocument remove_doc(command_doc_size);
+  makePeripheralCommand("remove", {uuids[0]}, n, remove_doc);
+  Services::getPeripheralController().handleCallback(
+      add_doc.as<JsonObjectConst>());
+
+  DynamicJsonDocument task_doc(command_doc_size);
+  task_doc["type"] = tasks::read_sensor::ReadSensor::type();
+  task_doc["uuid"] = uuids[1];
+  task_doc["peripheral"] = uuids[0];
+  tasks::BaseTask* task =
+      getTaskFactory().startTask(task_doc.as<JsonObjectConst>());
+  auto* get_values_task =
+      static_cast<tasks::get_values_task::GetValuesTask*>(task);
+
+  getFakeServer().setWireFormat(options.format);
+  getFakeServer().setUUIDHandles(options.use_uuid_handles);
+  getFakeServer().reset();
+  Result result = measure(options.name, n, iterations, [&]() {
+    auto result_doc_lease =
+        utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+    DynamicJsonDocument& result_doc = *result_doc_lease;
+    JsonObject result_object = result_doc.to<JsonObject>();
+    get_values_task->makeTelemetryJson(result_object);
+    if (options.send) {
+      Services::getServer().send(task->getType(), result_doc);
+    }
+  });
+  if (options.send) {
+    getFakeServer().flush();
+    // Include the warm-up call of measure() and any announced UUID handles
+    result.bytes_per_op =
+        static_cast<double>(getFakeServer().getByteCount()) / (iterations + 1);
+  }
+  getFakeServer().setWireFormat(WireFormat::kJson);
+  getFakeServer().setUUIDHandles(false);
+
+  // Remove the task before the peripheral it is using
+  task->disable();
+  Services::getScheduler().execute();
+  Services::getPeripheralController().handleCallback(
+      remove_doc.as<JsonObjectConst>());
+  return result;
+}
+
+/**
+ * Encodes a telemetry message with n data points without batching
+ *
+ * \param format The wire format to encode the message in
+ */
+Result benchEncoding(size_t n, WireFormat format) {
+  DynamicJsonDocument doc(command_doc_size);
+  doc["type"] = "tel";
+  doc["task_id"] = utils::UUID();
+  doc["peripheral"] = utils::UUID();
+  JsonArray data_points = doc.createNestedArray("data_points");
+  for (size_t i = 0; i < n; i++) {
+    JsonObject data_point = data_points.createNestedObject();
+    data_point["value"] = 21.5f + i;
+    data_point["data_point_type"] = utils::UUID();
+  }
+
+  char buffer[BB_JSON_PAYLOAD_SIZE];
+  size_t size = 0;
+  const bool is_json = format == WireFormat::kJson;
+  const char* name = is_json ? "encode.json" : "encode.msgpack";
+  Result result = measure(name, n, iterations * 10, [&]() {
+    size = is_json ? serializeJson(doc, buffer)
+                   : serializeMsgPack(doc, buffer);
+  });
+  result.bytes_per_op = size;
+  return result;
+}
+
+/**
+ * Writes n UUIDs into a JSON array through the UUID converter
+ */
+Result benchUUIDFormat(size_t n) {
+  std::vector<utils::UUID> uuids(n);
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(n) + n * utils::UUID::string_size);
+  return measure("uuid.format", n, iterations, [&]() {
+    doc.clear();
+    JsonArray array = doc.to<JsonArray>();
+    for (const auto& uuid : uuids) {
+      array.add(uuid);
+    }
+  });
+}
+
+/**
+ * Reads n UUIDs from a JSON array through the UUID converter
+ */
+Result benchUUIDParse(size_t n) {
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(n) + n * utils::UUID::string_size);
+  JsonArray array = doc.to<JsonArray>();
+  for (size_t i = 0; i < n; i++) {
+    array.add(utils::UUID());
+  }
+
+  // Keeps the compiler from dropping the parsing
+  volatile size_t sink = 0;
+  return measure("uuid.parse", n, iterations, [&]() {
+    for (JsonVariantConst uuid : doc.as<JsonArrayConst>()) {
+      sink = sink + uuid.as<utils::UUID>().hash();
+    }
+  });
+}
+
+/**
+ * Hands n frames to a consumer thread and waits until all were consumed
+ *
+ * Models the outbound path from the scheduler to the network thread.
+ */
+Result benchFrameQueue(size_t n) {
+  utils::SpscQueue<std::vector<char>> queue(8);
+  std::atomic<size_t> consumed{0};
+  utils::WorkerThread consumer("consumer", 0, 0);
+  consumer.start([&]() {
+    while (std::vector<char>* frame = queue.getReadSlot()) {
+      consumed.fetch_add(1);
+      queue.pop();
+    }
+  });
+
+  const std::vector<char> frame(256, 'x');
+  size_t produced = 0;
+  Result result = measure("queue.frames", n, iterations, [&]() {
+    for (size_t i = 0; i < n; i++) {
+      std::vector<char>* slot = queue.getWriteSlot();
+      while (!slot) {
+        std::this_thread::yield();
+        slot = queue.getWriteSlot();
+      }
+      slot->assign(frame.begin(), frame.end());
+      queue.push();
+      produced++;
+    }
+    while (consumed.load() != produced) {
+      std::this_thread::yield();
+    }
+  });
+  consumer.stop();
+  return result;
+}
+
+/**
+ * Drains full ring buffers of n scanned pins from an unpaced source
+ */
+Result benchAdcDrain(size_t n) {
+  const size_t buffer_size = 512;
+  peripheral::adc::SyntheticSource source(
+      [](uint8_t pin, uint32_t index) -> uint16_t { return pin + index; },
+      false);
+  Scheduler scheduler;
+  peripheral::adc::AdcEngine engine(scheduler, source, 1000, buffer_size,
+                                    std::chrono::milliseconds(10));
+  for (size_t i = 0; i < n; i++) {
+    engine.addChannel(32 + i % 8);
+  }
+
+  Result result =
+      measure("adc.drain", n, iterations, [&]() { engine.handle(); });
+  result.bytes_per_op = buffer_size * n * sizeof(uint16_t);
+  return result;
+}
+
+/**
+ * Averages the newest samples of a pin n times
+ */
+Result benchAdcAverage(size_t n) {
+  peripheral::adc::SyntheticSource source(
+      [](uint8_t pin, uint32_t index) -> uint16_t { return index; }, false);
+  Scheduler scheduler;
+  peripheral::adc::AdcEngine engine(scheduler, source, 1000, 512,
+                                    std::chrono::milliseconds(10));
+  engine.addChannel(32);
+  engine.handle();
+
+  volatile float sink = 0;
+  return measure("adc.average", n, iterations, [&]() {
+    for (size_t i = 0; i < n; i++) {
+      float average;
+      engine.getAverage(32, 64, average);
+      sink = sink + average;
+    }
+  });
+}
+
+/**
+ * Converts n averaged raw values to corrected voltages
+ *
+ * The correction table has 32 points, the most a peripheral accepts.
+ */
+Result benchAdcConvert(size_t n) {
+  peripheral::adc::AdcCalibration calibration(
+      peripheral::adc::Attenuation::k11dB, 1100);
+  std::vector<utils::PiecewiseLinear::Point> points;
+  for (size_t i = 0; i < 32; i++) {
+    points.push_back({i * 0.1f, i * 0.1f * 1.01f + 0.02f});
+  }
+  utils::PiecewiseLinear correction(points);
+
+  volatile float sink = 0;
+  return measure("adc.convert", n, iterations, [&]() {
+    for (size_t i = 0; i < n; i++) {
+      const float raw = (i * 37 % 4096) + 0.5f;
+      sink = sink + correction.evaluate(calibration.toVolts(raw));
+    }
+  });
+}
+
+/**
+ * Takes the median of a sliding window for each of n samples
+ *
+ * Compares the sliding median filter to sorting a copy of the window per
+ * sample.
+ */
+Result benchMedian(size_t n, bool use_filter) {
+  const size_t window = 31;
+  utils::SlidingMedian median(window);
+  std::vector<float> samples(window);
+  std::vector<float> sorted(window);
+  uint32_t state = 1;
+
+  volatile float sink = 0;
+  const char* name = use_filter ? "median.sliding" : "median.sort";
+  return measure(name, n, iterations, [&]() {
+    for (size_t i = 0; i < n; i++) {
+      state = state * 1664525 + 1013904223;
+      const float sample = state >> 20;
+      if (use_filter) {
+        sink = sink + median.add(sample);
+      } else {
+        samples[i % window] = sample;
+        sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        sink = sink + sorted[window / 2];
+      }
+    }
+  });
+}
+
+/**
+ * Journals n frames during an outage and replays them afterwards
+ *
+ * The journal wraps around the emulated flash, so that erasing is included.
+ */
+Result benchJournal(size_t n) {
+  utils::RamStorage storage(32, 4096);
+  TelemetryJournal journal(storage, 1024, std::chrono::milliseconds(5000));
+  journal.begin();
+
+  const std::vector<char> frame(256, 'x');
+  std::vector<char> replayed;
+  Result result = measure("journal.append+replay", n, iterations, [&]() {
+    for (size_t i = 0; i < n; i++) {
+      journal.append(frame.data(), frame.size(), WireFormat::kJson);
+    }
+    WireFormat format;
+    while (journal.peek(replayed, format)) {
+      journal.pop();
+    }
+  });
+  result.bytes_per_op = frame.size() * n;
+  return result;
+}
+
+}  // namespace
+}  // namespace bench
+}  // namespace bernd_box
+
+int main() {
+  using namespace bernd_box::bench;
+  using bernd_box::WireFormat;
+
+  // Errors are expected to be rare, but printing would distort the results
+  Serial.setOutputEnabled(false);
+
+  printHeader();
+  for (size_t n : sizes) {
+    printResult(benchParse(n, false));
+  }
+  for (size_t n : sizes) {
+    printResult(benchParse(n, true));
+  }
+  for (size_t n : sizes) {
+    printResult(benchPeripheralCommands(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchPeripheralLookup(n, false));
+  }
+  for (size_t n : sizes) {
+    printResult(benchPeripheralLookup(n, true));
+  }
+  for (size_t n : sizes) {
+    printResult(benchTaskCommands(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchTaskStart(n, false));
+  }
+  for (size_t n : sizes) {
+    printResult(benchTaskStart(n, true));
+  }
+  for (size_t n : sizes) {
+    printResult(benchTaskLookup(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchSchedulerPass(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchPollGroup(n, false));
+  }
+  for (size_t n : sizes) {
+    printResult(benchPollGroup(n, true));
+  }
+  const TelemetryOptions telemetry_options[] = {
+      {"telemetry.make", false, WireFormat::kJson, false},
+      {"telemetry.make+send.json", true, WireFormat::kJson, false},
+      {"telemetry.make+send.msgpack", true, WireFormat::kMsgPack, false},
+      {"telemetry.make+send.json+handles", true, WireFormat::kJson, true},
+      {"telemetry.make+send.msgpack+handles", true, WireFormat::kMsgPack,
+       true},
+  };
+  for (const auto& options : telemetry_options) {
+    for (size_t n : sizes) {
+      printResult(benchTelemetry(n, options));
+    }
+  }
+  for (size_t n : sizes) {
+    printResult(benchEncoding(n, WireFormat::kJson));
+  }
+  for (size_t n : sizes) {
+    printResult(benchEncoding(n, WireFormat::kMsgPack));
+  }
+  for (size_t n : sizes) {
+    printResult(benchUUIDFormat(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchUUIDParse(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchFrameQueue(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchAdcDrain(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchAdcAverage(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchAdcConvert(n));
+  }
+  for (size_t n : sizes) {
+    printResult(benchMedian(n, false));
+  }
+  for (size_t n : sizes) {
+    printResult(benchMedian(n, true));
+  }
+  for (size_t n : sizes) {
+    printResult(benchJournal(n));
+  }
+
+  return 0;
+}
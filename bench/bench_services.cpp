@@ -0,0 +1,49 @@
+/**
+ * Host definitions of the services used by the controller core
+ *
+ * Replaces managers/services.cpp, which owns the WiFi, MQTT and WebSocket
+ * instances. Only the services that the core depends on are defined.
+ */
+
+#include "bench_services.h"
+
+#include "managers/services.h"
+
+namespace bernd_box {
+namespace {
+
+bench::FakeServer fake_server;
+Scheduler scheduler;
+Scheduler high_priority_scheduler;
+peripheral::PeripheralFactory peripheral_factory{fake_server};
+peripheral::PeripheralController peripheral_controller{fake_server,
+                                                       peripheral_factory};
+tasks::TaskFactory task_factory{fake_server, scheduler,
+                                high_priority_scheduler, 32};
+tasks::TaskController task_controller{scheduler, task_factory, fake_server};
+tasks::TaskRemovalTask task_removal_task{scheduler, fake_server};
+
+}  // namespace
+
+Server& Services::getServer() { return fake_server; }
+
+peripheral::PeripheralController& Services::getPeripheralController() {
+  return peripheral_controller;
+}
+
+Scheduler& Services::getScheduler() { return scheduler; }
+
+Scheduler& Services::getHighPriorityScheduler() {
+  return high_priority_scheduler;
+}
+
+namespace bench {
+
+FakeServer& getFakeServer() { return fake_server; }
+
+tasks::TaskFactory& getTaskFactory() { return task_factory; }
+
+tasks::TaskController& getTaskController() { return task_controller; }
+
+}  // namespace bench
+}  // namespace bernd_box
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "fake_server.h"
+#include "tasks/task_controller.h"
+#include "tasks/task_factory.h"
+
+namespace bernd_box {
+namespace bench {
+
+/**
+ * Host instances of the services that are not exposed through Services
+ *
+ * They are defined in the same translation unit as the scheduler so that
+ * they are constructed after it.
+ */
+FakeServer& getFakeServer();
+tasks::TaskFactory& getTaskFactory();
+tasks::TaskController& getTaskController();
+
+}  // namespace bench
+}  // namespace bernd_box
@@ -0,0 +1,115 @@
+#include "bench_types.h"
+
+namespace bernd_box {
+namespace bench {
+
+BenchSensor::BenchSensor(const JsonObjectConst& parameters) {
+  addCapability<peripheral::capabilities::GetValues>(this);
+
+  JsonVariantConst data_point_count = parameters["data_point_count"];
+  const unsigned int count =
+      data_point_count.is<unsigned int>() ? data_point_count : 1;
+
+  for (unsigned int i = 0; i < count; i++) {
+    data_point_types_.push_back(utils::UUID());
+  }
+}
+
+const String& BenchSensor::getType() const { return type(); }
+
+const String& BenchSensor::type() {
+  static const String name{type_name_};
+  return name;
+}
+
+peripheral::capabilities::GetValues::Result BenchSensor::getValues() {
+  peripheral::capabilities::GetValues::Result result;
+  for (const auto& data_point_type : data_point_types_) {
+    result.values.push_back(
+        utils::ValueUnit{.value = 21.5, .data_point_type = data_point_type});
+  }
+  return result;
+}
+
+std::unique_ptr<peripheral::Peripheral> BenchSensor::factory(
+    const JsonObjectConst& parameters) {
+  return std::unique_ptr<peripheral::Peripheral>(new BenchSensor(parameters));
+}
+
+BenchTask::BenchTask(const JsonObjectConst& parameters, Scheduler& scheduler)
+    : BaseTask(scheduler, parameters) {
+  if (!isValid()) {
+    return;
+  }
+
+  setIterations(TASK_FOREVER);
+  setInterval(0);
+}
+
+const String& BenchTask::getType() const { return type(); }
+
+const String& BenchTask::type() {
+  static const String name{type_name_};
+  return name;
+}
+
+bool BenchTask::TaskCallback() { return true; }
+
+tasks::BaseTask* BenchTask::factory(const JsonObjectConst& parameters,
+                                    Scheduler& scheduler,
+                                    tasks::TaskPool& pool) {
+  return new (pool) BenchTask(parameters, scheduler);
+}
+
+}  // namespace bench
+
+// The native build has its own type tables of the tasks and peripherals it is
+// built with instead of src/peripheral/peripheral_types.cpp and
+// src/tasks/task_types.cpp
+namespace {
+
+constexpr peripheral::PeripheralFactory::Entry peripheral_types[] = {
+    {peripheral::InvalidPeripheral::type_name_,
+     peripheral::InvalidPeripheral::factory},
+    {bench::BenchSensor::type_name_, bench::BenchSensor::factory},
+};
+
+constexpr auto peripheral_types_hash = utils::makePerfectHash(peripheral_types);
+static_assert(peripheral_types_hash.isValid(),
+              "The names of the peripheral types are not unique");
+
+constexpr tasks::TaskFactory::Entry task_types[] = {
+    {tasks::aggregate_sensor::AggregateSensor::type_name_,
+     tasks::aggregate_sensor::AggregateSensor::factory,
+     sizeof(tasks::aggregate_sensor::AggregateSensor), 8,
+     tasks::Priority::kHigh, nullptr},
+    {tasks::poll_group::PollGroup::type_name_,
+     tasks::poll_group::PollGroup::factory,
+     sizeof(tasks::poll_group::PollGroup), 8, tasks::Priority::kHigh,
+     nullptr},
+    {tasks::poll_sensor::PollSensor::type_name_,
+     tasks::poll_sensor::PollSensor::factory,
+     sizeof(tasks::poll_sensor::PollSensor), 32, tasks::Priority::kHigh,
+     tasks::poll_sensor::PollSensor::templateFactory},
+    {tasks::read_sensor::ReadSensor::type_name_,
+     tasks::read_sensor::ReadSensor::factory,
+     sizeof(tasks::read_sensor::ReadSensor), 8, tasks::Priority::kNormal,
+     tasks::read_sensor::ReadSensor::templateFactory},
+    {bench::BenchTask::type_name_, bench::BenchTask::factory,
+     sizeof(bench::BenchTask), 32, tasks::Priority::kNormal, nullptr},
+};
+
+constexpr auto task_types_hash = utils::makePerfectHash(task_types);
+static_assert(task_types_hash.isValid(),
+              "The names of the task types are not unique");
+
+}  // namespace
+
+const utils::TypeTable<peripheral::PeripheralFactory::Entry>
+    peripheral::PeripheralFactory::types_{peripheral_types,
+                                          peripheral_types_hash};
+
+const utils::TypeTable<tasks::TaskFactory::Entry> tasks::TaskFactory::types_{
+    task_types, task_types_hash};
+
+}  // namespace bernd_box
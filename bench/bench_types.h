@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include <vector>
+
+#include "peripheral/capabilities/get_values.h"
+#include "peripheral/invalid_peripheral.h"
+#include "peripheral/peripheral.h"
+#include "peripheral/peripheral_factory.h"
+#include "tasks/aggregate_sensor/aggregate_sensor.h"
+#include "tasks/base_task.h"
+#include "tasks/poll_group/poll_group.h"
+#include "tasks/poll_sensor/poll_sensor.h"
+#include "tasks/read_sensor/read_sensor.h"
+#include "tasks/task_factory.h"
+#include "utils/type_table.h"
+
+namespace bernd_box {
+namespace bench {
+
+/**
+ * Sensor returning a configurable number of constant data points
+ *
+ * Takes the optional data_point_count parameter [default: 1].
+ */
+class BenchSensor : public peripheral::Peripheral,
+                    public peripheral::capabilities::GetValues {
+ public:
+  BenchSensor(const JsonObjectConst& parameters);
+  virtual ~BenchSensor() = default;
+
+  const String& getType() const final;
+  static constexpr const char* type_name_ = "BenchSensor";
+  static const String& type();
+  static std::unique_ptr<peripheral::Peripheral> factory(
+      const JsonObjectConst& parameters);
+
+  peripheral::capabilities::GetValues::Result getValues() final;
+
+ private:
+  std::vector<utils::UUID> data_point_types_;
+};
+
+/**
+ * Task that runs forever without doing any work
+ *
+ * Used to measure the overhead of the task life cycle and the scheduler.
+ */
+class BenchTask : public tasks::BaseTask {
+ public:
+  BenchTask(const JsonObjectConst& parameters, Scheduler& scheduler);
+  virtual ~BenchTask() = default;
+
+  const String& getType() const final;
+  static constexpr const char* type_name_ = "BenchTask";
+  static const String& type();
+  static tasks::BaseTask* factory(const JsonObjectConst& parameters,
+                                  Scheduler& scheduler,
+                                  tasks::TaskPool& pool);
+
+  bool TaskCallback() final;
+};
+
+}  // namespace bench
+}  // namespace bernd_box
@@ -0,0 +1,49 @@
+#include "benchmark.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> allocation_count{0};
+
+void* countedAllocate(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+}  // namespace
+
+// Replace the global allocation functions to count heap allocations
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace bernd_box {
+namespace bench {
+
+size_t getAllocationCount() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+void printHeader() {
+  printf("%-40s %6s %14s %12s %12s\n", "benchmark", "n", "ns/op",
+         "allocs/op", "bytes/op");
+}
+
+void printResult(const Result& result) {
+  printf("%-40s %6zu %14.1f %12.2f %12.1f\n", result.name, result.n,
+         result.ns_per_op, result.allocations_per_op, result.bytes_per_op);
+}
+
+}  // namespace bench
+}  // namespace bernd_box
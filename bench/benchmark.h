@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace bernd_box {
+namespace bench {
+
+/**
+ * Number of heap allocations made by the process so far
+ *
+ * Counted by the replaced global operator new in benchmark.cpp.
+ *
+ * \return The total count of allocations
+ */
+size_t getAllocationCount();
+
+/**
+ * Measurement of a single benchmark
+ */
+struct Result {
+  /// Name of the benchmarked operation
+  const char* name;
+  /// Problem size, e.g. the number of commands or tasks
+  size_t n;
+  /// Average wall time per operation in nanoseconds
+  double ns_per_op;
+  /// Average heap allocations per operation
+  double allocations_per_op;
+  /// Average bytes produced per operation, set by benchmarks that encode
+  double bytes_per_op;
+};
+
+/**
+ * Runs the function repeatedly and measures its time and allocations
+ *
+ * \param name Name of the benchmarked operation
+ * \param n Problem size which is only used for reporting
+ * \param iterations How often the function is called
+ * \param function The operation to measure
+ * \return The averaged measurement
+ */
+template <typename Function>
+Result measure(const char* name, size_t n, size_t iterations,
+               Function function) {
+  // Warm up caches and lazily allocated state
+  function();
+
+  const size_t allocations_start = getAllocationCount();
+  const auto time_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    function();
+  }
+  const auto time_end = std::chrono::steady_clock::now();
+  const size_t allocations = getAllocationCount() - allocations_start;
+
+  const double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        time_end - time_start)
+                        .count();
+  return Result{name, n, ns / iterations,
+                static_cast<double>(allocations) / iterations, 0};
+}
+
+/**
+ * Prints the header of the results table to stdout
+ */
+void printHeader();
+
+/**
+ * Prints a result as a row of the results table to stdout
+ *
+ * \param result The result to print
+ */
+void printResult(const Result& result);
+
+}  // namespace bench
+}  // namespace bernd_box
@@ -0,0 +1,124 @@
+#include "fake_server.h"
+
+namespace bernd_box {
+namespace bench {
+
+using namespace std::placeholders;
+
+FakeServer::FakeServer()
+    : batcher_(std::bind(&FakeServer::sendFrame, this, _1, _2, _3, _4),
+               std::chrono::milliseconds(250), 1400),
+      uuid_handles_(256) {}
+
+void FakeServer::connect() {}
+
+bool FakeServer::isConnected() { return true; }
+
+void FakeServer::handle() { batcher_.handle(); }
+
+void FakeServer::send(const String& name, double value) { message_count_++; }
+
+void FakeServer::send(const String& name, int value) { message_count_++; }
+
+void FakeServer::send(const String& name, bool value) { message_count_++; }
+
+void FakeServer::send(const String& name, DynamicJsonDocument& doc) {
+  doc[Server::type_key_] = Server::telemetry_type_;
+  doc["name"] = name;
+  serialize(doc.as<JsonObjectConst>());
+}
+
+void FakeServer::send(const String& name, const char* value, size_t length) {
+  message_count_++;
+  frame_count_++;
+  byte_count_ += length;
+}
+
+void FakeServer::sendTelemetry(const utils::UUID& task_id, JsonObject data) {
+  data[Server::type_key_] = Server::telemetry_type_;
+  addUUID(data, Server::task_id_key_, task_id);
+  serialize(data);
+}
+
+void FakeServer::sendRegister() { message_count_++; }
+
+void FakeServer::sendError(const String& who, const String& message) {
+  error_count_++;
+  message_count_++;
+}
+
+void FakeServer::sendError(const ErrorResult& error,
+                           const String& request_id) {
+  error_count_++;
+  message_count_++;
+}
+
+void FakeServer::sendResults(JsonObjectConst results) { serialize(results); }
+
+void FakeServer::sendSystem(JsonObject data) {
+  data[Server::type_key_] = Server::system_type_;
+  serialize(data);
+}
+
+void FakeServer::addUUID(JsonObject object, const __FlashStringHelper* key,
+                         const utils::UUID& uuid) {
+  // Mirror the WebSocket which announces new handles in a message of their own
+  if (use_uuid_handles_) {
+    utils::UUIDDictionary::Handle handle = uuid_handles_.getHandle(uuid);
+    if (handle.is_valid) {
+      if (handle.is_new) {
+        StaticJsonDocument<JSON_OBJECT_SIZE(3) + 40> doc;
+        doc["type"] = "uuid";
+        doc["handle"] = handle.id;
+        doc["uuid"] = uuid;
+        serialize(doc.as<JsonObjectConst>());
+      }
+      object[key] = handle.id;
+      return;
+    }
+  }
+
+  object[key] = uuid;
+}
+
+size_t FakeServer::getMessageCount() const { return message_count_; }
+
+size_t FakeServer::getFrameCount() const { return frame_count_; }
+
+size_t FakeServer::getByteCount() const { return byte_count_; }
+
+size_t FakeServer::getErrorCount() const { return error_count_; }
+
+void FakeServer::flush() { batcher_.flush(); }
+
+void FakeServer::reset() {
+  batcher_.flush();
+  message_count_ = 0;
+  frame_count_ = 0;
+  byte_count_ = 0;
+  error_count_ = 0;
+}
+
+void FakeServer::serialize(JsonObjectConst message) {
+  // Mirror the WebSocket which batches the messages into frames
+  batcher_.add(message);
+  message_count_++;
+}
+
+void FakeServer::setWireFormat(WireFormat format) {
+  batcher_.setFormat(format);
+}
+
+void FakeServer::setUUIDHandles(bool use_uuid_handles) {
+  use_uuid_handles_ = use_uuid_handles;
+  uuid_handles_.clear();
+}
+
+void FakeServer::sendFrame(const char* frame, size_t length,
+                           WireFormat format, Fragment fragment) {
+  frame_count_++;
+  byte_count_ += length;
+}
+
+}  // namespace bench
+}  // namespace bernd_box
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <vector>
+
+#include "managers/message_batcher.h"
+#include "managers/server.h"
+#include "utils/uuid_dictionary.h"
+
+namespace bernd_box {
+namespace bench {
+
+/**
+ * Server that serializes messages like the WebSocket but never sends them
+ *
+ * Serialization and batching are kept so that benchmarks include the cost of
+ * encoding the outbound messages. The sizes are accumulated to report bytes
+ * per operation.
+ */
+class FakeServer : public Server {
+ public:
+  FakeServer();
+  virtual ~FakeServer() = default;
+
+  void connect() final;
+  bool isConnected() final;
+
+  void handle() final;
+
+  void send(const String& name, double value) final;
+  void send(const String& name, int value) final;
+  void send(const String& name, bool value) final;
+  void send(const String& name, DynamicJsonDocument& doc) final;
+  void send(const String& name, const char* value, size_t length) final;
+
+  void sendTelemetry(const utils::UUID& uuid, JsonObject data) final;
+  void sendRegister() final;
+  void sendError(const String& who, const String& message) final;
+  void sendError(const ErrorResult& error, const String& request_id = "") final;
+
+  void sendResults(JsonObjectConst results) final;
+  void sendSystem(JsonObject data) final;
+
+  void addUUID(JsonObject object, const __FlashStringHelper* key,
+               const utils::UUID& uuid) final;
+
+  /// Number of messages that would have been sent
+  size_t getMessageCount() const;
+  /// Number of frames that would have been sent
+  size_t getFrameCount() const;
+  /// Number of serialized bytes that would have been sent
+  size_t getByteCount() const;
+  /// Number of errors that would have been sent
+  size_t getErrorCount() const;
+
+  /// Sends the pending batch
+  void flush();
+
+  /// Resets all counters after sending the pending batch
+  void reset();
+
+  /// Changes the encoding of the batched messages
+  void setWireFormat(WireFormat format);
+
+  /// Enables referencing UUIDs by handles and clears the known handles
+  void setUUIDHandles(bool use_uuid_handles);
+
+ private:
+  void serialize(JsonObjectConst message);
+  void sendFrame(const char* frame, size_t length, WireFormat format,
+                 Fragment fragment);
+
+  MessageBatcher batcher_;
+  utils::UUIDDictionary uuid_handles_;
+  bool use_uuid_handles_ = false;
+
+  size_t message_count_ = 0;
+  size_t frame_count_ = 0;
+  size_t byte_count_ = 0;
+  size_t error_count_ = 0;
+};
+
+}  // namespace bench
+}  // namespace bernd_box
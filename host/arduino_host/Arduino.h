@@ -0,0 +1,80 @@
+/**
+ * Host stand-in for the Arduino and ESP32 core
+ *
+ * Provides the subset of the Arduino API that the controller core (task and
+ * peripheral controllers, factories, UUIDs and value units) depends on, so
+ * that it can be built and benchmarked on a workstation. Hardware access
+ * (GPIO, ADC, WiFi) is intentionally missing.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Print.h"
+#include "WString.h"
+
+// Flash access is plain memory access on the host
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+#define pgm_read_float(addr) (*reinterpret_cast<const float*>(addr))
+#define pgm_read_ptr(addr) (*reinterpret_cast<void* const*>(addr))
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define memcpy_P memcpy
+
+typedef uint8_t byte;
+typedef unsigned int uint;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+uint32_t esp_random();
+
+/**
+ * Serial port that writes to the standard output
+ */
+class HardwareSerial : public Print {
+ public:
+  void begin(unsigned long baud);
+
+  /**
+   * Silences the output, for example while benchmarking
+   *
+   * \param enabled False to drop everything written to the serial port
+   */
+  void setOutputEnabled(bool enabled);
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+ private:
+  bool output_enabled_ = true;
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * Chip level functions. A restart terminates the host process
+ */
+class EspClass {
+ public:
+  [[noreturn]] void restart();
+  uint32_t getFreeHeap();
+};
+
+extern EspClass ESP;
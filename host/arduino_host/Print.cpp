@@ -0,0 +1,85 @@
+#include "Print.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::write(const char* str) {
+  if (!str) {
+    return 0;
+  }
+  return write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+}
+
+size_t Print::write(const char* buffer, size_t size) {
+  return write(reinterpret_cast<const uint8_t*>(buffer), size);
+}
+
+size_t Print::printf(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  va_list args_copy;
+  va_copy(args_copy, args);
+  const int length = vsnprintf(nullptr, 0, format, args_copy);
+  va_end(args_copy);
+  if (length <= 0) {
+    va_end(args);
+    return 0;
+  }
+
+  std::vector<char> buffer(length + 1);
+  vsnprintf(buffer.data(), buffer.size(), format, args);
+  va_end(args);
+  return write(buffer.data(), length);
+}
+
+size_t Print::print(const __FlashStringHelper* str) {
+  return write(reinterpret_cast<const char*>(str));
+}
+
+size_t Print::print(const String& str) {
+  return write(str.c_str(), str.length());
+}
+
+size_t Print::print(const char* str) { return write(str); }
+
+size_t Print::print(char c) { return write(static_cast<uint8_t>(c)); }
+
+size_t Print::print(unsigned char value, int base) {
+  return print(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(int value, int base) {
+  return print(static_cast<long>(value), base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+  return print(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(long value, int base) {
+  return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(unsigned long value, int base) {
+  return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(double value, int digits) {
+  return print(String(value, static_cast<unsigned int>(digits)));
+}
+
+size_t Print::print(const Printable& printable) {
+  return printable.printTo(*this);
+}
+
+size_t Print::println() { return write("\r\n"); }
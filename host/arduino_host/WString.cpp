@@ -0,0 +1,162 @@
+#include "WString.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+String::String(const char* str) : string_(str ? str : "") {}
+
+String::String(const char* str, size_t length) : string_(str, length) {}
+
+String::String(const __FlashStringHelper* str)
+    : String(reinterpret_cast<const char*>(str)) {}
+
+String::String(const std::string& str) : string_(str) {}
+
+String::String(char c) : string_(1, c) {}
+
+String::String(int value, unsigned char base) {
+  if (base == 10) {
+    string_ = std::to_string(value);
+  } else {
+    string_ = toBase(static_cast<unsigned int>(value), base);
+  }
+}
+
+String::String(unsigned int value, unsigned char base)
+    : string_(toBase(value, base)) {}
+
+String::String(long value, unsigned char base) {
+  if (base == 10) {
+    string_ = std::to_string(value);
+  } else {
+    string_ = toBase(static_cast<unsigned long>(value), base);
+  }
+}
+
+String::String(unsigned long value, unsigned char base)
+    : string_(toBase(value, base)) {}
+
+String::String(unsigned char value, unsigned char base)
+    : string_(toBase(value, base)) {}
+
+String::String(float value, unsigned int decimal_places)
+    : String(static_cast<double>(value), decimal_places) {}
+
+String::String(double value, unsigned int decimal_places) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", decimal_places, value);
+  string_ = buffer;
+}
+
+unsigned char String::reserve(unsigned int size) {
+  string_.reserve(size);
+  return 1;
+}
+
+unsigned char String::concat(const String& str) {
+  string_ += str.string_;
+  return 1;
+}
+
+unsigned char String::concat(const char* str) {
+  if (!str) {
+    return 0;
+  }
+  string_ += str;
+  return 1;
+}
+
+unsigned char String::concat(const char* str, unsigned int length) {
+  if (!str) {
+    return 0;
+  }
+  string_.append(str, length);
+  return 1;
+}
+
+unsigned char String::concat(char c) {
+  string_ += c;
+  return 1;
+}
+
+unsigned char String::concat(const __FlashStringHelper* str) {
+  return concat(reinterpret_cast<const char*>(str));
+}
+
+String& String::operator+=(const String& rhs) {
+  concat(rhs);
+  return *this;
+}
+
+String& String::operator+=(const char* rhs) {
+  concat(rhs);
+  return *this;
+}
+
+String& String::operator+=(const __FlashStringHelper* rhs) {
+  concat(rhs);
+  return *this;
+}
+
+String& String::operator+=(char rhs) {
+  concat(rhs);
+  return *this;
+}
+
+String& String::operator+=(int rhs) { return *this += String(rhs); }
+
+String& String::operator+=(unsigned int rhs) { return *this += String(rhs); }
+
+String& String::operator+=(long rhs) { return *this += String(rhs); }
+
+String& String::operator+=(unsigned long rhs) { return *this += String(rhs); }
+
+void String::toUpperCase() {
+  std::transform(string_.begin(), string_.end(), string_.begin(), ::toupper);
+}
+
+void String::toLowerCase() {
+  std::transform(string_.begin(), string_.end(), string_.begin(), ::tolower);
+}
+
+std::string String::toBase(unsigned long value, unsigned char base) {
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+
+  // Arduino prints digits above 9 in lower case
+  char buffer[8 * sizeof(value) + 1];
+  char* str = &buffer[sizeof(buffer) - 1];
+  *str = '\0';
+  do {
+    const unsigned long digit = value % base;
+    *--str = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= base;
+  } while (value);
+  return std::string(str);
+}
+
+String operator+(const String& lhs, const String& rhs) {
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const String& lhs, const __FlashStringHelper* rhs) {
+  String result(lhs);
+  result += rhs;
+  return result;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+  String result(lhs);
+  result += rhs;
+  return result;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Stand-in for the Arduino flash string helper
+ *
+ * The host has no separate flash address space, so F() strings are plain
+ * pointers to constant C strings.
+ */
+class __FlashStringHelper;
+
+#define F(string_literal) \
+  (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+/**
+ * Host implementation of the Arduino String class backed by std::string
+ *
+ * Only covers the subset of the API used by the controller core and by
+ * ArduinoJson's Arduino string adapters.
+ */
+class String {
+ public:
+  String() = default;
+  String(const char* str);
+  String(const char* str, size_t length);
+  String(const __FlashStringHelper* str);
+  String(const std::string& str);
+  explicit String(char c);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(float value, unsigned int decimal_places = 2);
+  explicit String(double value, unsigned int decimal_places = 2);
+
+  const char* c_str() const { return string_.c_str(); }
+  unsigned int length() const { return string_.length(); }
+  bool isEmpty() const { return string_.empty(); }
+  unsigned char reserve(unsigned int size);
+
+  unsigned char concat(const String& str);
+  unsigned char concat(const char* str);
+  unsigned char concat(const char* str, unsigned int length);
+  unsigned char concat(char c);
+  unsigned char concat(const __FlashStringHelper* str);
+
+  String& operator+=(const String& rhs);
+  String& operator+=(const char* rhs);
+  String& operator+=(const __FlashStringHelper* rhs);
+  String& operator+=(char rhs);
+  String& operator+=(int rhs);
+  String& operator+=(unsigned int rhs);
+  String& operator+=(long rhs);
+  String& operator+=(unsigned long rhs);
+
+  bool operator==(const String& rhs) const { return string_ == rhs.string_; }
+  bool operator==(const char* rhs) const { return string_ == rhs; }
+  bool operator!=(const String& rhs) const { return !(*this == rhs); }
+  bool operator!=(const char* rhs) const { return !(*this == rhs); }
+  bool operator<(const String& rhs) const { return string_ < rhs.string_; }
+  bool operator>(const String& rhs) const { return string_ > rhs.string_; }
+  bool operator<=(const String& rhs) const { return string_ <= rhs.string_; }
+  bool operator>=(const String& rhs) const { return string_ >= rhs.string_; }
+
+  char operator[](unsigned int index) const { return string_[index]; }
+  char& operator[](unsigned int index) { return string_[index]; }
+
+  void toUpperCase();
+  void toLowerCase();
+
+ private:
+  static std::string toBase(unsigned long value, unsigned char base);
+
+  std::string string_;
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const String& lhs, const __FlashStringHelper* rhs);
+String operator+(const char* lhs, const String& rhs);
@@ -0,0 +1,72 @@
+#include "Arduino.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+namespace {
+
+const std::chrono::steady_clock::time_point start_time =
+    std::chrono::steady_clock::now();
+
+}  // namespace
+
+unsigned long millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start_time)
+      .count();
+}
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start_time)
+      .count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {}
+
+uint32_t esp_random() {
+  static std::mt19937 generator{std::random_device{}()};
+  return generator();
+}
+
+void HardwareSerial::begin(unsigned long) {}
+
+void HardwareSerial::setOutputEnabled(bool enabled) {
+  output_enabled_ = enabled;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (output_enabled_) {
+    fputc(c, stdout);
+  }
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  if (output_enabled_) {
+    fwrite(buffer, 1, size, stdout);
+  }
+  return size;
+}
+
+HardwareSerial Serial;
+
+void EspClass::restart() {
+  fflush(stdout);
+  fprintf(stderr, "ESP.restart() called on the host. Aborting\n");
+  std::abort();
+}
+
+uint32_t EspClass::getFreeHeap() { return 0; }
+
+EspClass ESP;
@@ -16,13 +16,17 @@ std::initializer_list<AccessPoint> access_points = {
     {F("SDGintern"), F("8037473183859244")},
     {F("PROTOHAUS"), F("PH-Wlan-2016#")}};
 const std::chrono::seconds wifi_connect_timeout(20);
+// Delay between the attempts to connect to WiFi. Doubles per failed attempt
+const std::chrono::milliseconds wifi_reconnect_min_delay{1000};
+const std::chrono::milliseconds wifi_reconnect_max_delay{60000};
+// Time to wait for the NTP time before connecting to the server regardless
+const std::chrono::seconds time_sync_timeout{30};
 
 // MQTT
 const char* client_id = "bernd_box_1";
 const uint mqtt_connection_attempts = 3;  // Maximum attempts before aborting
 
 // Server certificate authorities TLS certificates
-const std::chrono::seconds server_connect_timeout{30};
 const char* core_domain = "core.openfarming.ai";
 const char* ws_token = "token_d143aa073cc6c0c27cb62515b3894b0b68c89435";
 const char* root_cas = 
@@ -78,4 +82,49 @@ const char* root_cas =
     "Ob8VZRzI9neWagqNdwvYkQsEjgfbKbYK7p2CNTUQ\n"
     "-----END CERTIFICATE-----\n";
 
+// Delay between the attempts to connect to the server. Doubles per failed
+// attempt
+const std::chrono::milliseconds server_reconnect_min_delay{1000};
+const std::chrono::milliseconds server_reconnect_max_delay{60000};
+
+// Outbound messages are batched into one frame until either limit is reached
+const std::chrono::milliseconds server_batch_max_latency{250};
+const size_t server_batch_max_bytes = 1400;
+// Maximum number of UUIDs referenced by handles per connection
+const size_t server_uuid_handle_capacity = 256;
+// Received messages and outbound frames queued between the network thread and
+// the scheduler
+const size_t server_inbound_queue_size = 4;
+const size_t server_outbound_queue_size = 16;
+// Largest doc a received message is deserialized into. The doc is sized from
+// the length of the message
+const size_t server_inbound_doc_max_size = 32 * 1024;
+// Largest message reassembled from received fragments
+const size_t server_inbound_message_max_size = 16 * 1024;
+
+// Background sampling of the analog inputs. The sample rate is per pin
+const uint32_t adc_sample_rate = 2000;
+const size_t adc_buffer_size = 512;
+const std::chrono::milliseconds adc_drain_interval{20};
+// Default number of samples averaged per analog reading
+const size_t adc_default_average_samples = 64;
+// Reference voltage of the ADC if the chip has none burnt into its eFuses
+const uint32_t adc_default_vref_mv = 1100;
+
+// The WebSocket and TLS stack run in a thread on the core not used by loop()
+const int network_thread_core = 0;
+const uint32_t network_thread_stack_size = 8192;
+
+// Frames which could not be sent are journaled in a flash partition. Appended
+// frames are written together once the buffer is full or after the interval
+const char* journal_partition_label = "journal";
+const size_t journal_write_buffer_size = 1024;
+const std::chrono::milliseconds journal_flush_interval{5000};
+// Minimum time between two replayed frames after reconnecting
+const std::chrono::milliseconds journal_replay_interval{100};
+
+// Number of task templates which can be stored at once. Handles range from 0
+// to the capacity - 1
+const size_t task_template_capacity = 32;
+
 }  // namespace bernd_box
@@ -19,15 +19,63 @@ extern const std::chrono::milliseconds check_connectivity_period;
 // WiFi
 extern std::initializer_list<AccessPoint> access_points;
 extern const std::chrono::seconds wifi_connect_timeout;
+// Delay between the attempts to connect to WiFi. Doubles per failed attempt
+extern const std::chrono::milliseconds wifi_reconnect_min_delay;
+extern const std::chrono::milliseconds wifi_reconnect_max_delay;
+// Time to wait for the NTP time before connecting to the server regardless
+extern const std::chrono::seconds time_sync_timeout;
 
 // MQTT
 extern const char* client_id;
 extern const uint mqtt_connection_attempts;  // Maximum attempts before aborting
 
 // Server certificate authorities TLS certificates
-extern const std::chrono::seconds server_connect_timeout;
 extern const char* core_domain;
 extern const char* ws_token;
 extern const char* root_cas;
+// Delay between the attempts to connect to the server. Doubles per failed
+// attempt
+extern const std::chrono::milliseconds server_reconnect_min_delay;
+extern const std::chrono::milliseconds server_reconnect_max_delay;
+
+// Outbound messages are batched into one frame until either limit is reached
+extern const std::chrono::milliseconds server_batch_max_latency;
+extern const size_t server_batch_max_bytes;
+// Maximum number of UUIDs referenced by handles per connection
+extern const size_t server_uuid_handle_capacity;
+// Received messages and outbound frames queued between the network thread and
+// the scheduler
+extern const size_t server_inbound_queue_size;
+extern const size_t server_outbound_queue_size;
+// Largest doc a received message is deserialized into. The doc is sized from
+// the length of the message
+extern const size_t server_inbound_doc_max_size;
+// Largest message reassembled from received fragments
+extern const size_t server_inbound_message_max_size;
+
+// Background sampling of the analog inputs. The sample rate is per pin
+extern const uint32_t adc_sample_rate;
+extern const size_t adc_buffer_size;
+extern const std::chrono::milliseconds adc_drain_interval;
+// Default number of samples averaged per analog reading
+extern const size_t adc_default_average_samples;
+// Reference voltage of the ADC if the chip has none burnt into its eFuses
+extern const uint32_t adc_default_vref_mv;
+
+// The WebSocket and TLS stack run in a thread on the core not used by loop()
+extern const int network_thread_core;
+extern const uint32_t network_thread_stack_size;
+
+// Frames which could not be sent are journaled in a flash partition. Appended
+// frames are written together once the buffer is full or after the interval
+extern const char* journal_partition_label;
+extern const size_t journal_write_buffer_size;
+extern const std::chrono::milliseconds journal_flush_interval;
+// Minimum time between two replayed frames after reconnecting
+extern const std::chrono::milliseconds journal_replay_interval;
+
+// Number of task templates which can be stored at once. Handles range from 0
+// to the capacity - 1
+extern const size_t task_template_capacity;
 
 }  // namespace bernd_box
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace bernd_box {
+
+class ErrorResult {
+ public:
+  /**
+   * No error present
+   */
+  ErrorResult() {}
+
+  /**
+   * Specify where the error occured and any details pertaining to it
+   *
+   * \param who Where the error occured
+   * \param detail Why the error occured
+   */
+  ErrorResult(String who, String detail) : who_(who), detail_(detail) {}
+
+  /**
+   * Checks if an error occured or not
+   *
+   * \return True if an error state exists
+   */
+  bool isError() const { return !who_.isEmpty() || !detail_.isEmpty(); }
+
+  /**
+   * Returns the who and detail in one string
+   *
+   * \return String with who and detail
+   */
+  String toString() { return who_ + F(": ") + detail_; }
+
+  String who_;
+  String detail_;
+};
+
+}  // namespace bernd_box
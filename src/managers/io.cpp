@@ -21,6 +21,14 @@ Result Io::init() {
     pinMode(it.second.enable_pin_id, OUTPUT);
   }
 
+  // analogRead() conflicts with the ADC engine's DMA scan, so the analog
+  // sensors are sampled by the engine as well
+  for (const auto& it : adcs_) {
+    if (!Services::getAdcEngine().addChannel(it.second.pin_id)) {
+      result = Result::kFailure;
+    }
+  }
+
   disableAllAnalog();
 
   // Check that the addresses match and then init the BME280 sensors
@@ -147,8 +155,12 @@ float Io::readAnalog(int sensor_id) {
   auto it = adcs_.find(sensor_id);
   if (it != adcs_.end()) {
     enableAnalog(it->first);
-    value = analogRead(it->second.pin_id);
-    value *= it->second.scaling_factor;
+    float raw_value;
+    if (waitForAnalogSamples(it->second) &&
+        Services::getAdcEngine().getAverage(
+            it->second.pin_id, analog_average_samples_, raw_value)) {
+      value = raw_value * it->second.scaling_factor;
+    }
   }
 
   return value;
@@ -184,6 +196,10 @@ Result Io::enableAnalog(const AdcSensor& adc) {
 
   if (adc.enable_pin_id >= 0) {
     digitalWrite(adc.enable_pin_id, HIGH);
+    if (analog_enabled_at_.find(adc.pin_id) == analog_enabled_at_.end()) {
+      analog_enabled_at_[adc.pin_id] =
+          Services::getAdcEngine().getSampleCount(adc.pin_id);
+    }
   } else {
     result = Result::kInvalidPin;
   }
@@ -207,6 +223,7 @@ void Io::disableAnalog(int sensor_id) {
 void Io::disableAnalog(const AdcSensor& adc) {
   if (adc.enable_pin_id >= 0) {
     digitalWrite(adc.enable_pin_id, LOW);
+    analog_enabled_at_.erase(adc.pin_id);
   }
 }
 
@@ -216,6 +233,28 @@ void Io::disableAllAnalog() {
   }
 }
 
+bool Io::waitForAnalogSamples(const AdcSensor& adc) {
+  peripheral::adc::AdcEngine& adc_engine = Services::getAdcEngine();
+
+  // Sensors without an enable pin are always powered
+  uint32_t first_sample = 0;
+  auto enabled_at = analog_enabled_at_.find(adc.pin_id);
+  if (enabled_at != analog_enabled_at_.end()) {
+    first_sample = enabled_at->second;
+  }
+
+  const unsigned long start_ms = millis();
+  while (adc_engine.getSampleCount(adc.pin_id) - first_sample <
+         analog_average_samples_) {
+    if (millis() - start_ms > analog_samples_timeout_ms_) {
+      return false;
+    }
+    delay(1);
+    adc_engine.handle();
+  }
+  return true;
+}
+
 Result Io::setPumpState(bool state) {
   Result result = Result::kSuccess;
 
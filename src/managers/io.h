@@ -80,6 +80,10 @@ class Io {
   };
   const uint analog_raw_range_ = 4096;
   const float analog_reference_v_ = 3.3;
+  /// Number of the ADC engine's newest samples averaged per analog reading
+  const size_t analog_average_samples_ = 16;
+  /// How long an analog reading waits for the samples after powering a sensor
+  const uint analog_samples_timeout_ms_ = 100;
 
   Io(Mqtt& mqtt);
 
@@ -144,6 +148,9 @@ class Io {
   /**
    * Reads the raw value of the sensor with the given ID
    *
+   * Powers the sensor on if needed and blocks until the ADC engine took enough
+   * samples since then.
+   *
    * \param sensor_id The id of the sensor
    * \return Value in specified unit. NAN on error or not found
    */
@@ -270,6 +277,17 @@ class Io {
   Result addI2cInterface(const JsonObjectConst& doc);
   Result removeI2cInterface(const JsonObjectConst& doc);
 
+  /**
+   * Waits for the samples of an analog sensor taken after powering it on
+   *
+   * The scheduler doesn't drain the ADC engine while waiting, so it is
+   * drained here.
+   *
+   * \param adc The analog sensor
+   * \return False if the samples did not arrive in time
+   */
+  bool waitForAnalogSamples(const AdcSensor& adc);
+
   Mqtt& mqtt_;
 
   /// Mapping of 16 PWM channels to pins. Index = channel, value = pin
@@ -277,6 +295,10 @@ class Io {
   /// -1 means the channel is not being used
   std::array<int8_t, 16> pwm_channels_;
 
+  /// The ADC engine's sample count of a pin when its sensor was powered on.
+  /// Older samples were taken while it was off
+  std::map<int, uint32_t> analog_enabled_at_;
+
   /// The higher the frequency, the lower the resolution. 5 kHz is the lowest
   /// and results in 13 bits of resultion.
   /// https://docs.espressif.com/projects/esp-idf/en/latest/api-reference/peripherals/ledc.html
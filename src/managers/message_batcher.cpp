@@ -0,0 +1,158 @@
+#include "message_batcher.h"
+
+namespace bernd_box {
+
+MessageBatcher::MessageBatcher(Transport transport,
+                               std::chrono::milliseconds max_latency,
+                               size_t max_bytes, Reserve reserve)
+    : transport_(transport),
+      reserve_(reserve),
+      max_latency_(max_latency),
+      max_bytes_(max_bytes) {
+  // Include space for the closing bracket and the null terminator
+  buffer_.reserve(max_bytes_ + 2);
+}
+
+void MessageBatcher::add(JsonObjectConst message) {
+  // A JSON message adds a separator (or the opening bracket) and the batch is
+  // closed with a bracket. MessagePack only has the header of the array
+  const bool is_json = format_ == WireFormat::kJson;
+  const size_t length =
+      is_json ? measureJson(message) : measureMsgPack(message);
+  const size_t separator = is_json ? 1 : 0;
+  const size_t closing = is_json ? 1 : 0;
+
+  // The array header is one byte for JSON and three for MessagePack
+  const size_t header = is_json ? 1 : 3;
+  if (header + length + closing > max_bytes_) {
+    flush();
+    const size_t frame_count =
+        (header + length + closing + max_bytes_ - 1) / max_bytes_;
+    if (!reserve_ || reserve_(frame_count)) {
+      sendFragmented(message);
+    }
+    return;
+  }
+
+  if (message_count_ > 0 &&
+      buffer_.size() + separator + length + closing > max_bytes_) {
+    flush();
+  }
+
+  if (message_count_ == 0) {
+    if (is_json) {
+      buffer_.push_back('[');
+    } else {
+      // array16 header. The count is filled in when flushing
+      buffer_.insert(buffer_.end(), {'\xdc', 0, 0});
+    }
+    batch_start_ = std::chrono::milliseconds(millis());
+  } else if (is_json) {
+    buffer_.push_back(',');
+  }
+
+  // Serialize in place. ArduinoJson may add a null terminator, which is
+  // dropped
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + length + 1);
+  size_t n = is_json ? serializeJson(message, &buffer_[offset], length + 1)
+                     : serializeMsgPack(message, &buffer_[offset], length + 1);
+  buffer_.resize(offset + n);
+  message_count_++;
+
+  if (max_latency_.count() == 0 || buffer_.size() + closing >= max_bytes_) {
+    flush();
+  }
+}
+
+void MessageBatcher::handle() {
+  if (message_count_ > 0 &&
+      std::chrono::milliseconds(millis()) - batch_start_ >= max_latency_) {
+    flush();
+  }
+}
+
+void MessageBatcher::flush() {
+  if (message_count_ == 0) {
+    return;
+  }
+
+  if (format_ == WireFormat::kJson) {
+    buffer_.push_back(']');
+  } else {
+    buffer_[1] = static_cast<char>(message_count_ >> 8);
+    buffer_[2] = static_cast<char>(message_count_ & 0xFF);
+  }
+  transport_(buffer_.data(), buffer_.size(), format_, Fragment::kNone);
+
+  // Clearing keeps the capacity, so the buffer is only allocated once
+  buffer_.clear();
+  message_count_ = 0;
+}
+
+size_t MessageBatcher::getMessageCount() const { return message_count_; }
+
+void MessageBatcher::setFormat(WireFormat format) {
+  if (format == format_) {
+    return;
+  }
+
+  flush();
+  format_ = format;
+}
+
+WireFormat MessageBatcher::getFormat() const { return format_; }
+
+void MessageBatcher::sendFragmented(JsonObjectConst message) {
+  // The buffer is empty after flushing and holds one fragment at a time
+  FragmentWriter writer(transport_, format_, buffer_, max_bytes_);
+  if (format_ == WireFormat::kJson) {
+    writer.write('[');
+    serializeJson(message, writer);
+    writer.write(']');
+  } else {
+    const uint8_t header[] = {0xdc, 0, 1};
+    writer.write(header, sizeof(header));
+    serializeMsgPack(message, writer);
+  }
+  writer.finish();
+}
+
+FragmentWriter::FragmentWriter(const MessageBatcher::Transport& transport,
+                               WireFormat format, std::vector<char>& buffer,
+                               size_t fragment_size)
+    : transport_(transport),
+      format_(format),
+      buffer_(buffer),
+      fragment_size_(fragment_size) {
+  buffer_.clear();
+}
+
+size_t FragmentWriter::write(uint8_t c) { return write(&c, 1); }
+
+size_t FragmentWriter::write(const uint8_t* data, size_t length) {
+  size_t remaining = length;
+  while (remaining > 0) {
+    // Only send a full fragment once more output follows
+    if (buffer_.size() == fragment_size_) {
+      transport_(buffer_.data(), buffer_.size(), format_,
+                 fragment_count_ == 0 ? Fragment::kFirst : Fragment::kMiddle);
+      fragment_count_++;
+      buffer_.clear();
+    }
+
+    const size_t count = std::min(remaining, fragment_size_ - buffer_.size());
+    buffer_.insert(buffer_.end(), data, data + count);
+    data += count;
+    remaining -= count;
+  }
+  return length;
+}
+
+void FragmentWriter::finish() {
+  transport_(buffer_.data(), buffer_.size(), format_,
+             fragment_count_ == 0 ? Fragment::kNone : Fragment::kLast);
+  buffer_.clear();
+}
+
+}  // namespace bernd_box
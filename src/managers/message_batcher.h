@@ -0,0 +1,152 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace bernd_box {
+
+/// Encoding of the messages exchanged with the server
+enum class WireFormat { kJson, kMsgPack };
+
+/// Position of a frame in a message sent as several fragments
+enum class Fragment { kNone, kFirst, kMiddle, kLast };
+
+/**
+ * Coalesces outbound messages into a single array frame
+ *
+ * Messages are serialized directly into a preallocated buffer. The batch is
+ * handed to the transport once the oldest message has waited for the maximum
+ * latency or once the next message would exceed the maximum batch size. This
+ * reduces the per-frame WebSocket and TLS overhead of many small messages.
+ *
+ * A frame is an array of messages in the current wire format. For JSON it has
+ * the form [<message>, <message>, ...], for MessagePack it is an array16
+ * header followed by the messages. A message larger than the maximum batch
+ * size is sent on its own and serialized straight into fragments of the
+ * maximum batch size, so the buffer never grows beyond it.
+ */
+class MessageBatcher {
+ public:
+  /// Callback to send a serialized frame or a fragment of a message
+  using Transport = std::function<void(const char* frame, size_t length,
+                                       WireFormat format, Fragment fragment)>;
+
+  /**
+   * Callback to check that the transport can take all fragments of a message
+   * before the first one is sent. The message is dropped if it returns false
+   */
+  using Reserve = std::function<bool(size_t frame_count)>;
+
+  /**
+   * Creates a batcher and allocates its buffer
+   *
+   * \param transport Callback to send a frame
+   * \param max_latency Maximum time a message is held back. Zero disables
+   *                    batching
+   * \param max_bytes Maximum size of a frame in bytes
+   * \param reserve Optional callback to reserve the fragments of a message
+   */
+  MessageBatcher(Transport transport, std::chrono::milliseconds max_latency,
+                 size_t max_bytes, Reserve reserve = nullptr);
+  virtual ~MessageBatcher() = default;
+
+  /**
+   * Serializes the message into the current batch
+   *
+   * Flushes the current batch first if the message would not fit.
+   *
+   * \param message The message to be sent
+   */
+  void add(JsonObjectConst message);
+
+  /**
+   * Flushes the batch if the oldest message reached the maximum latency
+   *
+   * Has to be called regularly, for example from Server::handle()
+   */
+  void handle();
+
+  /**
+   * Sends all batched messages as one frame
+   */
+  void flush();
+
+  /// Number of messages in the current batch
+  size_t getMessageCount() const;
+
+  /**
+   * Changes the encoding of the following frames
+   *
+   * Flushes the current batch in the previous format first.
+   *
+   * \param format The new wire format
+   */
+  void setFormat(WireFormat format);
+
+  /// The encoding of the frames
+  WireFormat getFormat() const;
+
+ private:
+  /**
+   * Sends a message in a frame of its own, split into fragments
+   *
+   * \param message The message to be sent
+   */
+  void sendFragmented(JsonObjectConst message);
+
+  Transport transport_;
+  Reserve reserve_;
+  std::chrono::milliseconds max_latency_;
+  size_t max_bytes_;
+  WireFormat format_ = WireFormat::kJson;
+
+  /// Serialized batch, starting with the array header once a message was added
+  std::vector<char> buffer_;
+  /// Number of messages in the current batch
+  size_t message_count_ = 0;
+  /// When the first message of the current batch was added
+  std::chrono::milliseconds batch_start_{0};
+};
+
+/**
+ * Writer for ArduinoJson splitting the output into fragments
+ *
+ * A fragment is handed to the transport once it is full and more output
+ * follows, so the last fragment is never empty. If the whole output fits into
+ * one fragment, it is handed over as a complete frame instead.
+ */
+class FragmentWriter {
+ public:
+  /**
+   * \param transport Callback to send the fragments
+   * \param format The wire format of the output
+   * \param buffer Holds the current fragment. Cleared before use
+   * \param fragment_size The size of the fragments in bytes
+   */
+  FragmentWriter(const MessageBatcher::Transport& transport, WireFormat format,
+                 std::vector<char>& buffer, size_t fragment_size);
+
+  size_t write(uint8_t c);
+  size_t write(const uint8_t* data, size_t length);
+
+  /**
+   * Sends the remaining output as the last fragment
+   */
+  void finish();
+
+ private:
+  const MessageBatcher::Transport& transport_;
+  const WireFormat format_;
+  std::vector<char>& buffer_;
+  const size_t fragment_size_;
+
+  /// Number of fragments sent so far
+  size_t fragment_count_ = 0;
+};
+
+}  // namespace bernd_box
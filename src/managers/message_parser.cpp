@@ -0,0 +1,81 @@
+#include "message_parser.h"
+
+namespace bernd_box {
+
+MessageParser::MessageParser(size_t min_doc_size, size_t max_doc_size)
+    : min_doc_size_(min_doc_size),
+      max_doc_size_(max_doc_size),
+      filter_(filter_size_) {
+  filter_.to<JsonObject>();
+}
+
+JsonObject MessageParser::getFilter() { return filter_.as<JsonObject>(); }
+
+DeserializationError MessageParser::parse(
+    const uint8_t* message, size_t length, WireFormat format,
+    std::vector<char>& buffer, std::unique_ptr<DynamicJsonDocument>& doc) {
+  size_t doc_size = prepareDoc(length, doc);
+  DeserializationError error = deserialize(message, length, format, buffer,
+                                           *doc);
+  while (error == DeserializationError::NoMemory && doc_size < max_doc_size_) {
+    doc_size = std::min(doc_size * 2, max_doc_size_);
+    doc.reset(new DynamicJsonDocument(doc_size));
+    error = deserialize(message, length, format, buffer, *doc);
+  }
+  return error;
+}
+
+DeserializationError MessageParser::parseInPlace(
+    std::vector<char>& buffer, WireFormat format,
+    std::unique_ptr<DynamicJsonDocument>& doc) {
+  prepareDoc(buffer.size(), doc);
+  return deserializeInPlace(buffer, format, *doc);
+}
+
+size_t MessageParser::getDocSize(size_t length) const {
+  return std::min(std::max(length * doc_size_ratio_, min_doc_size_),
+                  max_doc_size_);
+}
+
+size_t MessageParser::getMaxDocSize() const { return max_doc_size_; }
+
+size_t MessageParser::prepareDoc(size_t length,
+                                 std::unique_ptr<DynamicJsonDocument>& doc) {
+  // Grow the doc for larger messages and shrink it again, so that a single
+  // large message does not hold on to the memory
+  const size_t doc_size = getDocSize(length);
+  if (!doc || doc->capacity() < doc_size || doc->capacity() > 4 * doc_size) {
+    doc.reset(new DynamicJsonDocument(doc_size));
+  }
+  return doc->capacity();
+}
+
+DeserializationError MessageParser::deserialize(const uint8_t* message,
+                                               size_t length,
+                                               WireFormat format,
+                                               std::vector<char>& buffer,
+                                               DynamicJsonDocument& doc) {
+  // Assigning reuses the capacity of the buffer
+  buffer.assign(message, message + length);
+  return deserializeInPlace(buffer, format, doc);
+}
+
+DeserializationError MessageParser::deserializeInPlace(
+    std::vector<char>& buffer, WireFormat format, DynamicJsonDocument& doc) {
+  // Passing a mutable buffer selects the zero-copy mode
+  if (filter_.as<JsonObjectConst>().size() == 0) {
+    return format == WireFormat::kJson
+               ? deserializeJson(doc, buffer.data(), buffer.size())
+               : deserializeMsgPack(doc, buffer.data(), buffer.size());
+  }
+
+  const DeserializationOption::Filter filter(filter_);
+  return format == WireFormat::kJson
+             ? deserializeJson(doc, buffer.data(), buffer.size(), filter)
+             : deserializeMsgPack(doc, buffer.data(), buffer.size(), filter);
+}
+
+const size_t MessageParser::doc_size_ratio_ = 2;
+const size_t MessageParser::filter_size_ = 512;
+
+}  // namespace bernd_box
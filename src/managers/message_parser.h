@@ -0,0 +1,126 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "message_batcher.h"
+
+namespace bernd_box {
+
+/**
+ * Deserializes the messages received from the server
+ *
+ * Messages are copied into a buffer and deserialized in place (zero-copy).
+ * The doc only holds the nodes and references the strings in the buffer,
+ * which has to outlive the doc. The doc is sized from the length of the
+ * message, so that large command batches fit.
+ *
+ * The message handlers add the keys they read to the filter. All other keys
+ * are skipped while deserializing. An empty filter keeps all keys.
+ */
+class MessageParser {
+ public:
+  /**
+   * \param min_doc_size The smallest capacity of a doc
+   * \param max_doc_size The largest capacity of a doc
+   */
+  MessageParser(size_t min_doc_size, size_t max_doc_size);
+  virtual ~MessageParser() = default;
+
+  /**
+   * The filter of the keys to keep
+   *
+   * A key set to true keeps its value including all nested values. A key set
+   * to an object only keeps the keys of the object.
+   *
+   * \return The root object of the filter
+   */
+  JsonObject getFilter();
+
+  /**
+   * Deserializes a message in place
+   *
+   * If the doc runs out of memory, the message is deserialized again with
+   * twice the capacity up to the largest capacity.
+   *
+   * \param message The received message
+   * \param length The length of the message in bytes
+   * \param format The wire format of the message
+   * \param buffer Holds the message referenced by the doc
+   * \param doc The doc to deserialize into. Replaced if its capacity does not
+   *            match the length of the message
+   * \return The deserialization error, if any
+   */
+  DeserializationError parse(const uint8_t* message, size_t length,
+                             WireFormat format, std::vector<char>& buffer,
+                             std::unique_ptr<DynamicJsonDocument>& doc);
+
+  /**
+   * Deserializes a message already held in the buffer in place
+   *
+   * Used for messages reassembled from fragments. As deserializing modifies
+   * the buffer, it is not retried if the doc runs out of memory.
+   *
+   * \param buffer Holds the message referenced by the doc
+   * \param format The wire format of the message
+   * \param doc The doc to deserialize into. Replaced if its capacity does not
+   *            match the length of the message
+   * \return The deserialization error, if any
+   */
+  DeserializationError parseInPlace(std::vector<char>& buffer,
+                                    WireFormat format,
+                                    std::unique_ptr<DynamicJsonDocument>& doc);
+
+  /**
+   * Capacity of a doc holding a message
+   *
+   * \param length The length of the message in bytes
+   * \return The capacity in bytes
+   */
+  size_t getDocSize(size_t length) const;
+
+  /// The largest capacity of a doc
+  size_t getMaxDocSize() const;
+
+ private:
+  /**
+   * Replaces the doc if its capacity does not match the message length
+   *
+   * \return The capacity of the doc
+   */
+  size_t prepareDoc(size_t length, std::unique_ptr<DynamicJsonDocument>& doc);
+
+  /**
+   * Copies the message into the buffer and deserializes it
+   *
+   * \return The deserialization error, if any
+   */
+  DeserializationError deserialize(const uint8_t* message, size_t length,
+                                   WireFormat format, std::vector<char>& buffer,
+                                   DynamicJsonDocument& doc);
+
+  /**
+   * Deserializes the message in the buffer in place
+   *
+   * \return The deserialization error, if any
+   */
+  DeserializationError deserializeInPlace(std::vector<char>& buffer,
+                                          WireFormat format,
+                                          DynamicJsonDocument& doc);
+
+  const size_t min_doc_size_;
+  const size_t max_doc_size_;
+
+  DynamicJsonDocument filter_;
+
+  /// Capacity per byte of a message. Without copying the strings, the
+  /// nodes of a typical command take about twice its length
+  static const size_t doc_size_ratio_;
+  static const size_t filter_size_;
+};
+
+}  // namespace bernd_box
@@ -9,7 +9,8 @@ Mqtt::Mqtt(WiFiClient& wifi_client,
     : client_(wifi_client),
       peripheral_callback_(peripheral_callback),
       task_callback_(task_callback),
-      get_factory_names_(get_factory_names) {
+      get_factory_names_(get_factory_names),
+      parser_(BB_JSON_PAYLOAD_SIZE, server_inbound_doc_max_size) {
   // Callback from the PubSubClient MQTT library
   client_.setCallback(std::bind(&Mqtt::handleCallback, this, _1, _2, _3));
 }
@@ -244,17 +245,18 @@ void Mqtt::sendError(const String& who, const String& message,
 void Mqtt::handleCallback(char* topic, uint8_t* message, unsigned int length) {
   const __FlashStringHelper* who = F(__PRETTY_FUNCTION__);
   
-  // Deserialize the JSON object into allocated memory
-  DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
-  const DeserializationError error = deserializeJson(doc, message, length);
+  // Deserialize the JSON object into a doc sized from the message
+  const DeserializationError error =
+      parser_.parse(message, length, WireFormat::kJson, payload_, doc_);
   if (error) {
     sendError(who, String(F("Deserialize failed: ")) + error.c_str());
     return;
   }
 
   // Pass the message to the peripheral and task handlers
-  peripheral_callback_(doc.as<JsonObjectConst>());
-  task_callback_(doc.as<JsonObjectConst>());
+  peripheral_callback_(doc_->as<JsonObjectConst>());
+  task_callback_(doc_->as<JsonObjectConst>());
+  doc_->clear();
 }
 
 const String Mqtt::getMacString() {
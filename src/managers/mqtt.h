@@ -6,8 +6,11 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 
+#include "configuration.h"
+#include "managers/message_parser.h"
 #include "managers/server.h"
 #include "utils/setupNode.h"
 
@@ -162,6 +165,12 @@ class Mqtt {
 
   std::function<std::vector<String>()> get_factory_names_;
 
+  /// Deserializes the received messages in place without filtering
+  MessageParser parser_;
+  /// The received message referenced by doc_
+  std::vector<char> payload_;
+  std::unique_ptr<DynamicJsonDocument> doc_;
+
   uint8_t default_qos_ = 1;
 };  // namespace bernd_box
 
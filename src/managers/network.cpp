@@ -5,13 +5,8 @@ namespace bernd_box {
 Network::Network(std::initializer_list<AccessPoint>& access_points,
                  const char* core_domain, const char* root_cas)
     : access_points_(access_points),
-      connect_wait_duration_(std::chrono::milliseconds(500)),
       core_domain_(core_domain),
       root_cas_(root_cas) {
-  for (const AccessPoint& access_point : access_points_) {
-    wiFiMulti_.addAP(String(access_point.ssid).c_str(),
-                     String(access_point.password).c_str());
-  }
   if(root_cas_ != nullptr) {
     ping_url_ = String("https://") + core_domain_ + ping_path_;
   } else {
@@ -19,22 +14,24 @@ Network::Network(std::initializer_list<AccessPoint>& access_points,
   }
 }
 
-bool Network::connect(std::chrono::duration<int> timeout) {
-  Serial.println(F("Network::connect: Searching for the following networks:"));
-  for (const AccessPoint& access_point : access_points_) {
-    Serial.printf("\t%s\n", String(access_point.ssid).c_str());
+void Network::startConnect() {
+  if (access_points_.size() == 0) {
+    return;
   }
 
-  const std::chrono::milliseconds wifi_connect_start(millis());
-  while (wiFiMulti_.run() != WL_CONNECTED) {
-    if (std::chrono::milliseconds(millis()) - wifi_connect_start > timeout) {
-      return false;
-    }
-  }
+  const AccessPoint& access_point =
+      access_points_.begin()[next_access_point_ % access_points_.size()];
+  next_access_point_++;
+
+  Serial.print(F("Network::startConnect: Connecting to "));
+  Serial.println(access_point.ssid);
 
-  Serial.print("\tConnected! IP address is ");
-  Serial.println(WiFi.localIP());
-  return true;
+  // Reconnects are driven by the caller, which also rotates the access points
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);
+  WiFi.disconnect();
+  WiFi.begin(String(access_point.ssid).c_str(),
+             String(access_point.password).c_str());
 }
 
 String Network::pingSdgServer() {
@@ -132,41 +129,20 @@ void Network::printState() {
   Serial.printf("IP Address: %s\n", WiFi.localIP().toString().c_str());
 }
 
-int Network::setClock(std::chrono::seconds timeout_s) {
+void Network::startTimeSync() {
+  Serial.println(F("Network::startTimeSync: Requesting the NTP time"));
   configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-
-  Serial.println(F("Network::setClock: Waiting for NTP time sync"));
-  Serial.print("\t");
-  time_t nowSecs = time(nullptr);
-  std::chrono::milliseconds delay_duration(500);
-  uint tries = 0;
-  while (nowSecs < 8 * 3600 * 2) {
-    delay(delay_duration.count());
-    tries++;
-    Serial.print(F("."));
-    yield();
-    nowSecs = time(nullptr);
-    if (tries * delay_duration > timeout_s) {
-      Serial.println();
-      Serial.print(F("Timed out after "));
-      Serial.print(static_cast<long>(timeout_s.count()));
-      Serial.println("s");
-      return 1;
-    }
-  }
-  Serial.println();
-
-  struct tm timeinfo;
-  gmtime_r(&nowSecs, &timeinfo);
-  Serial.print(F("Current time: "));
-  Serial.print(asctime(&timeinfo));
-  return 0;
 }
 
-bool Network::isTimeSet() { return false; }
+bool Network::isTimeSet() {
+  // Before the first synchronization, the clock starts at the epoch
+  return time(nullptr) > min_valid_time_;
+}
 
 String Network::getSsid() { return WiFi.SSID(); }
 
 bool Network::isConnected() { return WiFi.status() == WL_CONNECTED; }
 
+const time_t Network::min_valid_time_ = 8 * 3600 * 2;
+
 }  // namespace bernd_box
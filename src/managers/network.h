@@ -4,7 +4,6 @@
 #include <ArduinoJson.h>
 #include <HTTPClient.h>
 #include <WiFi.h>
-#include <WiFiMulti.h>
 
 #include <chrono>
 #include <initializer_list>
@@ -17,7 +16,9 @@ namespace bernd_box {
 /**
  * Wifi related functionality
  *
- * Functionality includes conencting to wifi
+ * Functionality includes conencting to wifi. Connecting and synchronizing the
+ * time only start the process and return right away, so that the caller can
+ * poll the state without blocking the scheduler.
  */
 class Network {
  public:
@@ -29,14 +30,12 @@ class Network {
           const char* core_domain, const char* root_cas = nullptr);
 
   /**
-   * Connects to the configured WiFi access point and contacts the SDG server
+   * Starts connecting to the next configured WiFi access point
    *
-   * Blocks until the connection has been made.
-   *
-   * \param timeout The length of time to wait until aborting
-   * \return True if successful
+   * The access points are tried in turn with every call. Poll isConnected()
+   * for the result.
    */
-  bool connect(std::chrono::duration<int> timeout);
+  void startConnect();
 
   String pingSdgServer();
 
@@ -55,10 +54,19 @@ class Network {
    */
   void printState();
 
-  // Not sure if WiFiClientSecure checks the validity date of the certificate.
-  // Setting clock just to be sure...
-  int setClock(std::chrono::seconds timeout_s);
+  /**
+   * Starts the time synchronization with the NTP servers
+   *
+   * Not sure if WiFiClientSecure checks the validity date of the certificate.
+   * Setting clock just to be sure... Poll isTimeSet() for the result.
+   */
+  void startTimeSync();
 
+  /**
+   * Checks whether the clock was set by the NTP servers
+   *
+   * \return True if the clock holds the current time
+   */
   bool isTimeSet();
 
   String getSsid();
@@ -71,14 +79,13 @@ class Network {
   bool isConnected();
 
  private:
-  WiFiMulti wiFiMulti_;
   std::initializer_list<AccessPoint>& access_points_;
+  /// Index of the access point to connect to next
+  size_t next_access_point_ = 0;
 
   /// HTTPS client with support for TLS connections
   HTTPClient httpClient_;
 
-  std::chrono::milliseconds connect_wait_duration_;
-
   // SDG Server
   /// URL to for controllers to ping the server
   String ping_url_;
@@ -87,6 +94,9 @@ class Network {
 
   /// Currently the Let's Encrypt staging root certificate authority (CA)
   const char* root_cas_;
+
+  /// Any time before is treated as not synchronized
+  static const time_t min_valid_time_;
 };
 
 }  // namespace bernd_box
@@ -3,10 +3,11 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 
+#include <chrono>
 #include <functional>
 #include <map>
 
-#include "managers/io_types.h"
+#include "managers/error_result.h"
 #include "utils/uuid.h"
 
 namespace bernd_box {
@@ -24,7 +25,13 @@ class Server {
 
   virtual ~Server() = default;
 
-  virtual bool connect(std::chrono::seconds timeout) = 0;
+  /**
+   * Starts connecting to the server in the background
+   *
+   * Returns right away. Afterwards, the connection is kept up on its own and
+   * reestablished after outages.
+   */
+  virtual void connect() = 0;
   virtual bool isConnected() = 0;
 
   virtual void handle() = 0;
@@ -44,6 +51,19 @@ class Server {
   virtual void sendResults(JsonObjectConst results) = 0;
   virtual void sendSystem(JsonObject data) = 0;
 
+  /**
+   * Adds the UUID to the object in the connection's most compact form
+   *
+   * Depending on the connection, this is the UUID string or a short handle
+   * which was announced to the server beforehand.
+   *
+   * \param object The object to add the UUID to
+   * \param key The key of the UUID in the object
+   * \param uuid The UUID to add
+   */
+  virtual void addUUID(JsonObject object, const __FlashStringHelper* key,
+                       const utils::UUID& uuid) = 0;
+
   static const __FlashStringHelper* request_id_key_;
   static const __FlashStringHelper* type_key_;
   static const __FlashStringHelper* result_type_;
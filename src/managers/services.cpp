@@ -1,6 +1,21 @@
 #include "services.h"
 
+#include <WiFiClient.h>
+
+#include "managers/mqtt.h"
+#include "managers/network.h"
+#include "managers/web_socket.h"
+#include "peripheral/adc/i2s_adc_source.h"
+#include "utils/partition_storage.h"
+
 namespace bernd_box {
+namespace {
+
+peripheral::adc::I2sAdcSource adc_source;
+utils::PartitionStorage journal_storage{journal_partition_label,
+                                        ESP_PARTITION_SUBTYPE_ANY};
+
+}  // namespace
 
 Network& Services::getNetwork() { return network_; }
 
@@ -8,12 +23,24 @@ peripheral::PeripheralController& Services::getPeripheralController() {
   return peripheral_controller_;
 }
 
+tasks::TaskFactory& Services::getTaskFactory() { return task_factory_; }
+
 Mqtt& Services::getMqtt() { return mqtt_; }
 
 Server& Services::getServer() { return web_socket_; }
 
 Scheduler& Services::getScheduler() { return scheduler_; }
 
+Scheduler& Services::getHighPriorityScheduler() {
+  return high_priority_scheduler_;
+}
+
+peripheral::adc::AdcEngine& Services::getAdcEngine() { return adc_engine_; }
+
+TelemetryJournal& Services::getTelemetryJournal() {
+  return telemetry_journal_;
+}
+
 Network Services::network_{bernd_box::access_points, bernd_box::core_domain,
                            bernd_box::root_cas};
 
@@ -25,25 +52,41 @@ Mqtt Services::mqtt_{
               &peripheral_controller_, _1),
     std::bind(&tasks::TaskController::handleCallback, &task_controller_, _1)};
 
+TelemetryJournal Services::telemetry_journal_{
+    journal_storage, journal_write_buffer_size, journal_flush_interval};
+
 WebSocket Services::web_socket_{
     std::bind(&peripheral::PeripheralController::getPeripheralIDs,
               &peripheral_controller_),
     std::bind(&peripheral::PeripheralController::handleCallback,
               &peripheral_controller_, _1),
     std::bind(&tasks::TaskController::getTaskIDs, &task_controller_),
-    std::bind(&tasks::TaskController::handleCallback, &task_controller_, _1)
-};
+    std::bind(&tasks::TaskController::handleCallback, &task_controller_, _1),
+    [](JsonObject filter) {
+      peripheral::PeripheralController::addFilterKeys(filter);
+      tasks::TaskController::addFilterKeys(filter);
+    },
+    telemetry_journal_};
 
 WiFiClient Services::wifi_client_;
 
 Scheduler Services::scheduler_;
 
+Scheduler Services::high_priority_scheduler_;
+
+// Drained by a high priority task, so that the DMA buffers do not overflow
+peripheral::adc::AdcEngine Services::adc_engine_{
+    high_priority_scheduler_, adc_source, adc_sample_rate, adc_buffer_size,
+    adc_drain_interval};
+
 peripheral::PeripheralFactory Services::peripheral_factory_{web_socket_};
 
 peripheral::PeripheralController Services::peripheral_controller_{
     web_socket_, peripheral_factory_};
 
-tasks::TaskFactory Services::task_factory_{web_socket_, scheduler_};
+tasks::TaskFactory Services::task_factory_{web_socket_, scheduler_,
+                                           high_priority_scheduler_,
+                                           task_template_capacity};
 
 tasks::TaskController Services::task_controller_{scheduler_, task_factory_,
                                                  web_socket_};
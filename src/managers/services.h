@@ -1,27 +1,34 @@
 #pragma once
 
 #include <TaskSchedulerDeclarations.h>
-#include <WiFiClient.h>
-#include <WiFiClientSecure.h>
 
 #include "configuration.h"
-#include "managers/mqtt.h"
-#include "managers/network.h"
 #include "managers/server.h"
-#include "managers/web_socket.h"
+#include "managers/telemetry_journal.h"
+#include "peripheral/adc/adc_engine.h"
 #include "peripheral/peripheral_controller.h"
 #include "peripheral/peripheral_factory.h"
 #include "tasks/task_controller.h"
 #include "tasks/task_factory.h"
 #include "tasks/task_removal_task.h"
 
+class WiFiClient;
+
 namespace bernd_box {
 
+class Mqtt;
+class Network;
+class WebSocket;
+
 /**
  * All services provided as static instances by the middleware
  *
  * The services cover functions such as the connection to the server and MQTT
  * broker, the peripheral and task controller as well as the scheduler.
+ *
+ * The network related services are only forward declared. This keeps the
+ * header free of WiFi and TLS dependencies, so that the controllers and tasks
+ * can also be built for the host (see the native environment).
  */
 class Services {
  public:
@@ -29,14 +36,21 @@ class Services {
   static Mqtt& getMqtt();
   static Server& getServer();
   static peripheral::PeripheralController& getPeripheralController();
+  static tasks::TaskFactory& getTaskFactory();
   static Scheduler& getScheduler();
+  static Scheduler& getHighPriorityScheduler();
+  static peripheral::adc::AdcEngine& getAdcEngine();
+  static TelemetryJournal& getTelemetryJournal();
 
  private:
   static Network network_;
   static Mqtt mqtt_;
+  static TelemetryJournal telemetry_journal_;
   static WebSocket web_socket_;
   static WiFiClient wifi_client_;
   static Scheduler scheduler_;
+  static Scheduler high_priority_scheduler_;
+  static peripheral::adc::AdcEngine adc_engine_;
   static peripheral::PeripheralController peripheral_controller_;
   static peripheral::PeripheralFactory peripheral_factory_;
   static tasks::TaskFactory task_factory_;
@@ -0,0 +1,308 @@
+#include "telemetry_journal.h"
+
+namespace bernd_box {
+
+TelemetryJournal::TelemetryJournal(utils::FlashStorage& storage,
+                                   size_t write_buffer_size,
+                                   std::chrono::milliseconds flush_interval)
+    : storage_(storage),
+      write_buffer_size_(write_buffer_size),
+      flush_interval_(flush_interval) {}
+
+bool TelemetryJournal::begin() {
+  if (!storage_.begin()) {
+    return false;
+  }
+
+  sector_size_ = storage_.getSectorSize();
+  sector_count_ = sector_size_ ? storage_.getSize() / sector_size_ : 0;
+  if (sector_count_ < 2) {
+    return false;
+  }
+  sector_pending_.assign(sector_count_, 0);
+  sector_bytes_.assign(sector_count_, 0);
+  write_buffer_.reserve(write_buffer_size_);
+
+  // Find the oldest and the newest sector by their sequence numbers
+  bool is_formatted = false;
+  size_t oldest_sector = 0;
+  uint32_t oldest_sequence = 0;
+  uint32_t newest_sequence = 0;
+  for (size_t sector = 0; sector < sector_count_; sector++) {
+    SectorHeader header;
+    if (!storage_.read(getOffset(sector, 0), &header, sizeof(header)) ||
+        header.magic != magic_) {
+      continue;
+    }
+
+    if (!is_formatted || header.sequence < oldest_sequence) {
+      oldest_sector = sector;
+      oldest_sequence = header.sequence;
+    }
+    if (!is_formatted || header.sequence > newest_sequence) {
+      head_sector_ = sector;
+      newest_sequence = header.sequence;
+    }
+    is_formatted = true;
+  }
+
+  is_ready_ = true;
+  if (!is_formatted) {
+    // Start an empty journal in the first sector
+    head_sector_ = sector_count_ - 1;
+    if (!startNextSector()) {
+      return false;
+    }
+    tail_sector_ = head_sector_;
+    tail_offset_ = head_offset_;
+    return true;
+  }
+
+  // Count the unsent records from the oldest to the newest sector. Replaying
+  // starts in the first sector holding unsent records
+  next_sequence_ = newest_sequence + 1;
+  tail_sector_ = head_sector_;
+  bool is_tail_found = false;
+  for (size_t i = 0; i < sector_count_; i++) {
+    const size_t sector = (oldest_sector + i) % sector_count_;
+    const size_t end = scanSector(sector);
+    if (!is_tail_found && sector_pending_[sector] > 0) {
+      tail_sector_ = sector;
+      tail_offset_ = sector_header_size_;
+      is_tail_found = true;
+    }
+    if (sector == head_sector_) {
+      head_offset_ = end;
+      break;
+    }
+  }
+  if (!is_tail_found) {
+    tail_offset_ = head_offset_;
+  }
+  return true;
+}
+
+bool TelemetryJournal::append(const char* frame, size_t length,
+                              WireFormat format) {
+  if (!is_ready_) {
+    return false;
+  }
+
+  const size_t size = getRecordSize(length);
+  if (length >= 0xFFFF || sector_header_size_ + size > sector_size_) {
+    dropped_records_++;
+    return false;
+  }
+
+  // The write buffer is written into the head sector as a whole
+  if (head_offset_ + write_buffer_.size() + size > sector_size_) {
+    flush();
+    if (!startNextSector()) {
+      return false;
+    }
+  }
+
+  if (write_buffer_.empty()) {
+    buffer_start_ = std::chrono::milliseconds(millis());
+  }
+  RecordHeader header{static_cast<uint16_t>(length),
+                      static_cast<uint8_t>(format), 0xFF,
+                      getChecksum(frame, length)};
+  const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(&header);
+  write_buffer_.insert(write_buffer_.end(), header_bytes,
+                       header_bytes + sizeof(header));
+  write_buffer_.insert(write_buffer_.end(), frame, frame + length);
+  // Pad with the erased state of the flash
+  write_buffer_.resize(write_buffer_.size() + size - sizeof(header) - length,
+                       0xFF);
+  buffered_records_++;
+
+  sector_pending_[head_sector_]++;
+  sector_bytes_[head_sector_] += size;
+  pending_records_++;
+  used_bytes_ += size;
+
+  if (write_buffer_.size() >= write_buffer_size_) {
+    flush();
+  }
+  return true;
+}
+
+void TelemetryJournal::handle() {
+  if (!write_buffer_.empty() &&
+      std::chrono::milliseconds(millis()) - buffer_start_ >= flush_interval_) {
+    flush();
+  }
+}
+
+void TelemetryJournal::flush() {
+  if (write_buffer_.empty()) {
+    return;
+  }
+
+  if (storage_.write(getOffset(head_sector_, head_offset_),
+                     write_buffer_.data(), write_buffer_.size())) {
+    head_offset_ += write_buffer_.size();
+  } else {
+    // The records are lost, but the counts have to stay consistent
+    sector_pending_[head_sector_] -= buffered_records_;
+    sector_bytes_[head_sector_] -= write_buffer_.size();
+    pending_records_ -= buffered_records_;
+    used_bytes_ -= write_buffer_.size();
+    dropped_records_ += buffered_records_;
+  }
+  write_buffer_.clear();
+  buffered_records_ = 0;
+}
+
+bool TelemetryJournal::peek(std::vector<char>& frame, WireFormat& format) {
+  if (!is_ready_ || pending_records_ == 0) {
+    return false;
+  }
+  flush();
+
+  while (tail_sector_ != head_sector_ || tail_offset_ < head_offset_) {
+    RecordHeader header;
+    bool is_sector_end = tail_offset_ + sizeof(header) > sector_size_;
+    if (!is_sector_end) {
+      storage_.read(getOffset(tail_sector_, tail_offset_), &header,
+                    sizeof(header));
+      is_sector_end = header.length == 0xFFFF;
+    }
+    if (is_sector_end) {
+      if (tail_sector_ == head_sector_) {
+        return false;
+      }
+      tail_sector_ = (tail_sector_ + 1) % sector_count_;
+      tail_offset_ = sector_header_size_;
+      continue;
+    }
+
+    const size_t size = getRecordSize(header.length);
+    if (header.state != 0xFF) {
+      tail_offset_ += size;
+      continue;
+    }
+
+    frame.resize(header.length);
+    storage_.read(getOffset(tail_sector_, tail_offset_) + sizeof(header),
+                  frame.data(), header.length);
+    if (getChecksum(frame.data(), header.length) != header.checksum) {
+      // Torn by a power loss while writing. Never replay it
+      markSent(size);
+      dropped_records_++;
+      continue;
+    }
+
+    format = static_cast<WireFormat>(header.format);
+    peeked_size_ = size;
+    return true;
+  }
+  return false;
+}
+
+void TelemetryJournal::pop() {
+  if (peeked_size_ == 0) {
+    return;
+  }
+
+  markSent(peeked_size_);
+  peeked_size_ = 0;
+}
+
+bool TelemetryJournal::isEmpty() const { return pending_records_ == 0; }
+
+TelemetryJournal::Statistics TelemetryJournal::getStatistics() const {
+  return Statistics{storage_.getSize(), used_bytes_, pending_records_,
+                    dropped_records_};
+}
+
+void TelemetryJournal::markSent(size_t size) {
+  const uint8_t sent = 0;
+  storage_.write(getOffset(tail_sector_, tail_offset_) +
+                     offsetof(RecordHeader, state),
+                 &sent, sizeof(sent));
+  tail_offset_ += size;
+
+  sector_pending_[tail_sector_]--;
+  sector_bytes_[tail_sector_] -= size;
+  pending_records_--;
+  used_bytes_ -= size;
+}
+
+size_t TelemetryJournal::getRecordSize(size_t length) {
+  return sizeof(RecordHeader) + ((length + 3) & ~size_t(3));
+}
+
+uint32_t TelemetryJournal::getChecksum(const char* frame, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<uint8_t>(frame[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool TelemetryJournal::startNextSector() {
+  const size_t next = (head_sector_ + 1) % sector_count_;
+
+  // The journal is full. Drop the oldest records
+  if (sector_pending_[next] > 0) {
+    dropped_records_ += sector_pending_[next];
+    pending_records_ -= sector_pending_[next];
+    used_bytes_ -= sector_bytes_[next];
+    sector_pending_[next] = 0;
+    sector_bytes_[next] = 0;
+  }
+  if (tail_sector_ == next) {
+    tail_sector_ = (next + 1) % sector_count_;
+    tail_offset_ = sector_header_size_;
+  }
+
+  const SectorHeader header{magic_, next_sequence_};
+  if (!storage_.erase(next) ||
+      !storage_.write(getOffset(next, 0), &header, sizeof(header))) {
+    is_ready_ = false;
+    return false;
+  }
+  next_sequence_++;
+  head_sector_ = next;
+  head_offset_ = sector_header_size_;
+  return true;
+}
+
+size_t TelemetryJournal::scanSector(size_t sector) {
+  SectorHeader sector_header;
+  storage_.read(getOffset(sector, 0), &sector_header, sizeof(sector_header));
+  if (sector_header.magic != magic_) {
+    return sector_header_size_;
+  }
+
+  size_t offset = sector_header_size_;
+  while (offset + sizeof(RecordHeader) <= sector_size_) {
+    RecordHeader header;
+    storage_.read(getOffset(sector, offset), &header, sizeof(header));
+    const size_t size = getRecordSize(header.length);
+    if (header.length == 0xFFFF || offset + size > sector_size_) {
+      break;
+    }
+
+    if (header.state == 0xFF) {
+      sector_pending_[sector]++;
+      sector_bytes_[sector] += size;
+      pending_records_++;
+      used_bytes_ += size;
+    }
+    offset += size;
+  }
+  return offset;
+}
+
+size_t TelemetryJournal::getOffset(size_t sector, size_t offset) const {
+  return sector * sector_size_ + offset;
+}
+
+const uint32_t TelemetryJournal::magic_ = 0x314A4242;  // "BBJ1"
+const size_t TelemetryJournal::sector_header_size_ = sizeof(SectorHeader);
+
+}  // namespace bernd_box
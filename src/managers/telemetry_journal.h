@@ -0,0 +1,184 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "message_batcher.h"
+#include "utils/flash_storage.h"
+
+namespace bernd_box {
+
+/**
+ * Ring journal in flash holding the frames that could not be sent
+ *
+ * The frames are appended as records to the sectors of the storage in a log
+ * structure. Appended records are collected in RAM and written together once
+ * the write buffer is full or the flush interval elapsed, which reduces the
+ * number of flash writes. When the journal is full, the oldest sector is
+ * erased and its unsent records are counted as dropped.
+ *
+ * Replaying a record marks it as sent by clearing its state byte in place,
+ * so that the journal survives a reboot without sending records twice.
+ *
+ * Layout: Each sector starts with a header holding a magic number and an
+ * increasing sequence number. It is followed by records of an 8 byte header
+ * (length, wire format, state, checksum) and the frame padded to 4 bytes.
+ * An erased record header (length 0xFFFF) marks the end of a sector.
+ *
+ * Only statistics may be read from other threads.
+ */
+class TelemetryJournal {
+ public:
+  /// Usage of the journal
+  struct Statistics {
+    /// Size of the storage in bytes
+    size_t capacity_bytes;
+    /// Bytes used by the unsent records
+    size_t used_bytes;
+    /// Number of unsent records
+    uint32_t pending_records;
+    /// Number of records lost because the journal was full or corrupted
+    uint32_t dropped_records;
+  };
+
+  /**
+   * \param storage The flash region holding the journal
+   * \param write_buffer_size Bytes collected in RAM before writing them
+   * \param flush_interval Maximum time appended records are held in RAM
+   */
+  TelemetryJournal(utils::FlashStorage& storage, size_t write_buffer_size,
+                   std::chrono::milliseconds flush_interval);
+  virtual ~TelemetryJournal() = default;
+
+  /**
+   * Recovers the journal from the storage or formats it
+   *
+   * \return True if the storage can be used
+   */
+  bool begin();
+
+  /**
+   * Appends a frame to the write buffer
+   *
+   * \param frame The serialized frame
+   * \param length The length of the frame in bytes
+   * \param format The wire format of the frame
+   * \return False if the journal is unusable or the frame too large
+   */
+  bool append(const char* frame, size_t length, WireFormat format);
+
+  /**
+   * Writes the buffered records if the flush interval elapsed
+   */
+  void handle();
+
+  /**
+   * Writes the buffered records to the storage
+   */
+  void flush();
+
+  /**
+   * Reads the oldest unsent record
+   *
+   * \param frame Buffer the frame is read into
+   * \param format The wire format of the frame
+   * \return False if no unsent record exists
+   */
+  bool peek(std::vector<char>& frame, WireFormat& format);
+
+  /**
+   * Marks the record returned by peek() as sent
+   */
+  void pop();
+
+  /// Whether unsent records exist
+  bool isEmpty() const;
+
+  /// Gets the usage of the journal. Can be called from any thread
+  Statistics getStatistics() const;
+
+ private:
+  struct SectorHeader {
+    uint32_t magic;
+    uint32_t sequence;
+  };
+
+  struct RecordHeader {
+    uint16_t length;
+    uint8_t format;
+    /// 0xFF until the record was sent
+    uint8_t state;
+    uint32_t checksum;
+  };
+
+  /**
+   * Marks the record at the tail as sent and moves the tail past it
+   *
+   * \param size The size of the record
+   */
+  void markSent(size_t size);
+
+  /// Size of a record in the storage including its header and padding
+  static size_t getRecordSize(size_t length);
+
+  /// FNV-1a hash of the frame
+  static uint32_t getChecksum(const char* frame, size_t length);
+
+  /**
+   * Erases the next sector and makes it the head sector
+   *
+   * Unsent records in the erased sector are dropped.
+   */
+  bool startNextSector();
+
+  /**
+   * Counts the unsent records of a sector and finds its end
+   *
+   * \param sector The sector to scan
+   * \return The offset in the sector after the last record
+   */
+  size_t scanSector(size_t sector);
+
+  size_t getOffset(size_t sector, size_t offset) const;
+
+  utils::FlashStorage& storage_;
+  const size_t write_buffer_size_;
+  const std::chrono::milliseconds flush_interval_;
+
+  bool is_ready_ = false;
+  size_t sector_count_ = 0;
+  size_t sector_size_ = 0;
+
+  /// The sector records are appended to and the offset in it to write at
+  size_t head_sector_ = 0;
+  size_t head_offset_ = 0;
+  uint32_t next_sequence_ = 0;
+  /// Position of the next record to replay
+  size_t tail_sector_ = 0;
+  size_t tail_offset_ = 0;
+  /// Size of the record returned by peek()
+  size_t peeked_size_ = 0;
+
+  /// Number of unsent records and their bytes per sector
+  std::vector<uint16_t> sector_pending_;
+  std::vector<uint32_t> sector_bytes_;
+
+  /// Records not yet written to the storage
+  std::vector<uint8_t> write_buffer_;
+  /// Number of records in the write buffer
+  uint16_t buffered_records_ = 0;
+  /// When the first record was added to the write buffer
+  std::chrono::milliseconds buffer_start_{0};
+
+  std::atomic<size_t> used_bytes_{0};
+  std::atomic<uint32_t> pending_records_{0};
+  std::atomic<uint32_t> dropped_records_{0};
+
+  static const uint32_t magic_;
+  static const size_t sector_header_size_;
+};
+
+}  // namespace bernd_box
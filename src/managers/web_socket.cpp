@@ -6,49 +6,75 @@ WebSocket::WebSocket(
     std::function<std::vector<utils::UUID>()> get_peripheral_ids,
     Server::Callback peripheral_controller_callback,
     std::function<std::vector<utils::UUID>()> get_task_ids,
-    Server::Callback task_controller_callback)
+    Server::Callback task_controller_callback,
+    std::function<void(JsonObject filter)> add_filter_keys,
+    TelemetryJournal& journal)
     : get_peripheral_ids_(get_peripheral_ids),
       peripheral_controller_callback_(peripheral_controller_callback),
       get_task_ids_(get_task_ids),
       task_controller_callback_(task_controller_callback),
+      parser_(BB_JSON_PAYLOAD_SIZE, server_inbound_doc_max_size),
+      batcher_(std::bind(&WebSocket::queueFrame, this, _1, _2, _3, _4, false),
+               server_batch_max_latency, server_batch_max_bytes,
+               std::bind(&WebSocket::reserveFrames, this, _1)),
+      uuid_handles_(server_uuid_handle_capacity),
+      inbound_(server_inbound_queue_size),
+      outbound_(server_outbound_queue_size),
+      reconnect_backoff_(server_reconnect_min_delay,
+                         server_reconnect_max_delay),
+      journal_(journal),
       core_domain_(core_domain),
       ws_token_(ws_token),
-      root_cas_(root_cas) {}
+      root_cas_(root_cas),
+      network_thread_("network", network_thread_core,
+                      network_thread_stack_size) {
+  // Skip the keys neither the handlers nor the connection options read
+  JsonObject filter = parser_.getFilter();
+  add_filter_keys(filter);
+  filter["wire_format"] = true;
+  filter["uuid_handles"] = true;
+}
 
 const String& WebSocket::type() {
   static const String name{"WebSocket"};
   return name;
 }
 
-bool WebSocket::isConnected() { return WebSocketsClient::isConnected(); }
+bool WebSocket::isConnected() { return is_connected_; }
+
+void WebSocket::connect() {
+  if (is_setup_) {
+    return;
+  }
+  is_setup_ = true;
 
-bool WebSocket::connect(std::chrono::seconds timeout) {
   // Configure the WebSocket interface with the server, TLS certificate and the
   // reconnect interval
-  if (!is_setup_) {
-    is_setup_ = true;
-    if (root_cas_) {
-      beginSslWithCA(core_domain_, 443, controller_path_, root_cas_, ws_token_);
-    } else {
-      begin(core_domain_, 8000, controller_path_, ws_token_);
-    }
-    onEvent(std::bind(&WebSocket::handleEvent, this, _1, _2, _3));
-    setReconnectInterval(5000);
+  if (root_cas_) {
+    beginSslWithCA(core_domain_, 443, controller_path_, root_cas_, ws_token_);
+  } else {
+    begin(core_domain_, 8000, controller_path_, ws_token_);
   }
+  onEvent(std::bind(&WebSocket::handleEvent, this, _1, _2, _3));
+  // The network thread holds the attempts back with its own backoff
+  setReconnectInterval(0);
 
-  // Attempt to connect to the server until connected or it times out
-  std::chrono::milliseconds connect_start(millis());
-  while (!isConnected()) {
-    if (std::chrono::milliseconds(millis()) - connect_start > timeout) {
-      return false;
-    }
-    loop();
+  // Recover the frames journaled before the reboot
+  if (!journal_.begin()) {
+    Serial.println(F("WebSocket: Telemetry journal unavailable"));
   }
 
-  return true;
+  // From now on only the network thread uses the WebSocket client
+  network_thread_.start(std::bind(&WebSocket::handleNetwork, this));
 }
 
-void WebSocket::handle() { loop(); }
+void WebSocket::handle() {
+  handleInbound();
+  if (is_register_pending_) {
+    sendRegister();
+  }
+  batcher_.handle();
+}
 
 void WebSocket::send(const String& name, double value) {
   Serial.print(F("Unimplemented Function: "));
@@ -73,13 +99,7 @@ void WebSocket::send(const String& name, DynamicJsonDocument& doc) {
   doc["type"] = "tel";
   doc["name"] = name;
 
-  // Calculate the size of the resultant serialized JSON, create a buffer of
-  // that size and serialize the JSON into that buffer.
-  // Add extra byte for the null terminator
-  std::vector<char> register_buf = std::vector<char>(measureJson(doc) + 1);
-  size_t n = serializeJson(doc, register_buf.data(), register_buf.size());
-
-  sendTXT(register_buf.data(), n);
+  batcher_.add(doc.as<JsonObjectConst>());
 }
 
 void WebSocket::send(const String& name, const char* value, size_t length) {
@@ -91,27 +111,31 @@ void WebSocket::send(const String& name, const char* value, size_t length) {
 
 void WebSocket::sendTelemetry(const utils::UUID& task_id, JsonObject data) {
   data[Server::type_key_] = Server::telemetry_type_;
-  data[Server::task_id_key_] = task_id.toString();
-
-  std::vector<char> register_buf = std::vector<char>(measureJson(data) + 1);
-  size_t n = serializeJson(data, register_buf.data(), register_buf.size());
-  Serial.printf("Telemetry size: %i\n", n);
+  addUUID(data, Server::task_id_key_, task_id);
 
-  sendTXT(register_buf.data(), n);
+  batcher_.add(data);
 }
 
 void WebSocket::sendRegister() {
-  DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
+  auto doc_lease = utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& doc = *doc_lease;
 
   // Use ther register message type
   doc["type"] = "reg";
 
+  // Advertise the supported connection options. JSON and UUID strings are
+  // used until the server opts into them
+  JsonArray wire_formats = doc.createNestedArray(F("wire_formats"));
+  wire_formats.add("json");
+  wire_formats.add("msgpack");
+  doc["uuid_handles"] = true;
+
   // Collect all added peripheral ids and write them to a JSON doc
   std::vector<utils::UUID> peripheral_ids = get_peripheral_ids_();
   if (!peripheral_ids.empty()) {
     JsonArray peripherals = doc.createNestedArray(F("peripherals"));
     for (const auto& peripheral_id : peripheral_ids) {
-      peripherals.add(peripheral_id.toString());
+      peripherals.add(peripheral_id);
     }
   }
 
@@ -120,23 +144,41 @@ void WebSocket::sendRegister() {
   if (!task_ids.empty()) {
     JsonArray tasks = doc.createNestedArray(F("tasks"));
     for (const auto& task_id : task_ids) {
-      tasks.add(task_id.toString());
+      tasks.add(task_id);
     }
   }
 
-  // Calculate the size of the resultant serialized JSON, create a buffer of
-  // that size and serialize the JSON into that buffer.
-  // Add extra byte for the null terminator
-  std::vector<char> register_buf = std::vector<char>(measureJson(doc) + 1);
-  size_t n = serializeJson(doc, register_buf.data(), register_buf.size());
-
-  sendTXT(register_buf.data(), n);
+  // The register message is not batched, as the server expects it before any
+  // other message. It is serialized straight into fragments of the batch size.
+  // While awaiting it, the network thread drains the queue, so it is retried
+  // if the queue is still full
+  const size_t length = measureJson(doc);
+  const size_t frame_count =
+      std::max<size_t>(1, (length + server_batch_max_bytes - 1) /
+                              server_batch_max_bytes);
+  if (outbound_.capacity() - outbound_.size() < frame_count) {
+    is_register_pending_ = frame_count <= outbound_.capacity();
+    if (!is_register_pending_) {
+      Serial.println(F("WebSocket: Register message exceeds the queue"));
+    }
+    return;
+  }
+  is_register_pending_ = false;
+
+  const MessageBatcher::Transport transport =
+      std::bind(&WebSocket::queueFrame, this, _1, _2, _3, _4, true);
+  FragmentWriter writer(transport, WireFormat::kJson, register_buffer_,
+                        server_batch_max_bytes);
+  serializeJson(doc, writer);
+  writer.finish();
 }
 
 void WebSocket::sendError(const String& who, const String& message) {
   Serial.println(message);
 
-  DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
+  // The strings are only referenced, so the doc only holds the object
+  auto doc_lease = utils::JsonDocumentPool::acquire(JSON_OBJECT_SIZE(2));
+  DynamicJsonDocument& doc = *doc_lease;
 
   // Use ther error message type
   doc["type"] = "err";
@@ -144,17 +186,16 @@ void WebSocket::sendError(const String& who, const String& message) {
   // Place the error message
   doc["message"] = message.c_str();
 
-  std::vector<char> register_buf = std::vector<char>(measureJson(doc) + 1);
-  size_t n = serializeJson(doc, register_buf.data(), register_buf.size());
-
-  sendTXT(register_buf.data(), n);
+  batcher_.add(doc.as<JsonObjectConst>());
 }
 
 void WebSocket::sendError(const ErrorResult& error, const String& request_id) {
   Serial.printf("origin: %s message: %s request_id: %s\n", error.who_.c_str(),
                 error.detail_.c_str(), request_id.c_str());
 
-  DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
+  // The strings are only referenced, so the doc only holds the object
+  auto doc_lease = utils::JsonDocumentPool::acquire(JSON_OBJECT_SIZE(4));
+  DynamicJsonDocument& doc = *doc_lease;
 
   // Use ther error message type
   doc["type"] = "err";
@@ -168,87 +209,381 @@ void WebSocket::sendError(const ErrorResult& error, const String& request_id) {
   // The request ID to enable tracing
   doc["request_id"] = request_id.c_str();
 
-  std::vector<char> register_buf = std::vector<char>(measureJson(doc) + 1);
-  size_t n = serializeJson(doc, register_buf.data(), register_buf.size());
-
-  sendTXT(register_buf.data(), n);
+  batcher_.add(doc.as<JsonObjectConst>());
 }
 
 void WebSocket::sendResults(JsonObjectConst results) {
-  std::vector<char> buffer = std::vector<char>(measureJson(results) + 1);
-  size_t n = serializeJson(results, buffer.data(), buffer.size());
-
-  sendTXT(buffer.data(), n);
+  batcher_.add(results);
 }
 
 void WebSocket::sendSystem(JsonObject data) {
   data[Server::type_key_] = Server::system_type_;
 
-  std::vector<char> data_buf = std::vector<char>(measureJson(data) + 1);
-  size_t n = serializeJson(data, data_buf.data(), data_buf.size());
+  batcher_.add(data);
+}
+
+void WebSocket::addUUID(JsonObject object, const __FlashStringHelper* key,
+                        const utils::UUID& uuid) {
+  if (use_uuid_handles_) {
+    utils::UUIDDictionary::Handle handle = uuid_handles_.getHandle(uuid);
+    if (handle.is_valid) {
+      // The announcement is batched before the message using the handle
+      if (handle.is_new) {
+        sendUUIDHandle(handle.id, uuid);
+      }
+      object[key] = handle.id;
+      return;
+    }
+  }
 
-  sendTXT(data_buf.data(), n);
+  object[key] = uuid;
+}
+
+void WebSocket::sendUUIDHandle(uint16_t handle, const utils::UUID& uuid) {
+  auto doc_lease = utils::JsonDocumentPool::acquire(JSON_OBJECT_SIZE(3) + 40);
+  DynamicJsonDocument& doc = *doc_lease;
+  doc["type"] = "uuid";
+  doc["handle"] = handle;
+  doc["uuid"] = uuid;
+
+  batcher_.add(doc.as<JsonObjectConst>());
 }
 
 void WebSocket::handleEvent(WStype_t type, uint8_t* payload, size_t length) {
   switch (type) {
     case WStype_DISCONNECTED: {
-      _lastConnectionFail = millis();
       Serial.printf("WebSocket::HandleEvent: Disconnected!\n");
+      // The scheduler resets the connection options in order with the
+      // received messages. A partially received message is discarded
+      is_receiving_fragments_ = false;
+      InboundMessage& message = getInboundSlot();
+      message.kind = InboundMessage::Kind::kDisconnected;
+      inbound_.push();
     } break;
     case WStype_CONNECTED: {
       Serial.printf("WebSocket::HandleEvent: Connected to url: %s\n", payload);
+      // Drop the outbound frames until the scheduler queued the register
+      // message. The rest of a message started on the previous connection is
+      // skipped
+      is_awaiting_register_ = true;
+      is_sending_message_ = false;
+      is_replay_stopped_ = false;
+      InboundMessage& message = getInboundSlot();
+      message.kind = InboundMessage::Kind::kConnected;
+      inbound_.push();
     } break;
     case WStype_TEXT: {
       Serial.printf("WebSocket::HandleEvent: get text: %s\n", payload);
-      handleData(payload, length);
+      handleData(payload, length, WireFormat::kJson);
     } break;
     case WStype_BIN: {
       Serial.printf("WebSocket::HandleEvent: get binary length: %u\n", length);
-      hexdump(payload, length);
-
-      // send data to server
-      // webSocket.sendBIN(payload, length);
+      handleData(payload, length, WireFormat::kMsgPack);
+    } break;
+    case WStype_FRAGMENT_TEXT_START: {
+      handleFragment(payload, length, Fragment::kFirst, WireFormat::kJson);
+    } break;
+    case WStype_FRAGMENT_BIN_START: {
+      handleFragment(payload, length, Fragment::kFirst, WireFormat::kMsgPack);
+    } break;
+    case WStype_FRAGMENT: {
+      handleFragment(payload, length, Fragment::kMiddle, fragment_format_);
+    } break;
+    case WStype_FRAGMENT_FIN: {
+      handleFragment(payload, length, Fragment::kLast, fragment_format_);
     } break;
     case WStype_ERROR:
-    case WStype_FRAGMENT_TEXT_START:
-    case WStype_FRAGMENT_BIN_START:
-    case WStype_FRAGMENT:
-    case WStype_FRAGMENT_FIN:
     case WStype_PING:
     case WStype_PONG:
       break;
   }
 }
 
-void WebSocket::handleData(const uint8_t* payload, size_t length) {
-  const __FlashStringHelper* who = F(__PRETTY_FUNCTION__);
+void WebSocket::handleData(const uint8_t* payload, size_t length,
+                           WireFormat format) {
+  InboundMessage& message = getInboundSlot();
+
+  // The client reuses its receive buffer, so the message is copied into the
+  // slot's buffer, which the doc references
+  message.error =
+      parser_.parse(payload, length, format, message.payload, message.doc);
+  message.kind = message.error ? InboundMessage::Kind::kDeserializeError
+                               : InboundMessage::Kind::kMessage;
+  inbound_.push();
+}
+
+void WebSocket::handleFragment(const uint8_t* payload, size_t length,
+                               Fragment fragment, WireFormat format) {
+  // The slot is only published with the last fragment, so the same slot is
+  // returned for all fragments of a message
+  InboundMessage& message = getInboundSlot();
+  if (fragment == Fragment::kFirst) {
+    message.payload.clear();
+    fragment_format_ = format;
+    is_receiving_fragments_ = true;
+    is_fragment_overflow_ = false;
+  } else if (!is_receiving_fragments_) {
+    return;
+  }
+
+  // Bound the memory of a message. Its remaining fragments are skipped
+  if (message.payload.size() + length > server_inbound_message_max_size) {
+    is_fragment_overflow_ = true;
+    std::vector<char>().swap(message.payload);
+  }
+  if (!is_fragment_overflow_) {
+    message.payload.insert(message.payload.end(), payload, payload + length);
+  }
+
+  if (fragment != Fragment::kLast) {
+    return;
+  }
+  is_receiving_fragments_ = false;
+
+  if (is_fragment_overflow_) {
+    message.error = DeserializationError::NoMemory;
+  } else {
+    message.error =
+        parser_.parseInPlace(message.payload, fragment_format_, message.doc);
+  }
+  message.kind = message.error ? InboundMessage::Kind::kDeserializeError
+                               : InboundMessage::Kind::kMessage;
+  inbound_.push();
+}
+
+void WebSocket::handleNetwork() {
+  // The client connects in loop() whenever its connection is closed, so the
+  // attempts are only let through once the reconnect delay passed
+  const bool is_client_connected = clientIsConnected(&_client);
+  const bool is_connect_attempt =
+      !is_client_connected && WiFi.isConnected() &&
+      std::chrono::milliseconds(millis()) >= next_connect_attempt_;
+  if (is_client_connected || is_connect_attempt) {
+    loop();
+  }
+  is_connected_ = WebSocketsClient::isConnected();
+  updateReconnectDelay(is_connect_attempt);
+  sendQueuedFrames();
+  replayJournal();
+  journal_.handle();
+}
+
+void WebSocket::updateReconnectDelay(bool is_connect_attempt) {
+  const std::chrono::milliseconds now(millis());
+  const bool is_client_connected = clientIsConnected(&_client);
+
+  if (is_connected_) {
+    reconnect_backoff_.reset();
+  } else if (!WiFi.isConnected()) {
+    // Without WiFi every attempt fails right away. Retry after the minimum
+    // delay once WiFi is back
+    reconnect_backoff_.reset();
+    next_connect_attempt_ = now + server_reconnect_min_delay;
+  } else if (!is_client_connected &&
+             (is_connect_attempt || was_client_connected_)) {
+    // The attempt failed, the handshake was refused or the connection closed
+    next_connect_attempt_ = now + reconnect_backoff_.fail();
+  }
+  was_client_connected_ = is_client_connected;
+}
+
+void WebSocket::sendQueuedFrames() {
+  while (OutboundFrame* frame = outbound_.getReadSlot()) {
+    // Whether a message is sent is decided with its first frame, so that its
+    // fragments are either all sent or all skipped
+    const bool is_start = frame->fragment == Fragment::kNone ||
+                          frame->fragment == Fragment::kFirst;
+    if (is_start) {
+      // Frames of the previous connection precede the register message
+      if (frame->is_register) {
+        is_awaiting_register_ = false;
+      }
+      is_sending_message_ = is_connected_ && !is_awaiting_register_;
+    }
 
-  // Deserialize the JSON object into allocated memory
-  DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
-  const DeserializationError error = deserializeJson(doc, payload, length);
-  if (error) {
-    sendError(who, String(F("Deserialize failed: ")) + error.c_str());
+    if (is_sending_message_) {
+      sendFrame(frame->data.data(), frame->data.size(), frame->format,
+                frame->fragment);
+    } else if (frame->is_portable) {
+      journal_.append(frame->data.data(), frame->data.size(), frame->format);
+    }
+
+    // The frame's buffer keeps its capacity for the next frame
+    outbound_.pop();
+  }
+}
+
+void WebSocket::replayJournal() {
+  // New frames take precedence over the journaled ones
+  if (!is_connected_ || is_awaiting_register_ || is_replay_stopped_ ||
+      outbound_.size() > 0) {
+    return;
+  }
+
+  const std::chrono::milliseconds now(millis());
+  if (now - last_replay_ < journal_replay_interval) {
     return;
   }
 
-  // Pass the message to the peripheral and task handlers
-  peripheral_controller_callback_(doc.as<JsonObjectConst>());
-  task_controller_callback_(doc.as<JsonObjectConst>());
+  WireFormat format;
+  if (journal_.peek(replay_frame_, format)) {
+    last_replay_ = now;
+    // Keep the frame for the next connection if the link failed again
+    if (!sendFrame(replay_frame_.data(), replay_frame_.size(), format)) {
+      is_replay_stopped_ = true;
+      return;
+    }
+    journal_.pop();
+  }
+}
+
+void WebSocket::handleInbound() {
+  const __FlashStringHelper* who = F(__PRETTY_FUNCTION__);
+
+  while (InboundMessage* message = inbound_.getReadSlot()) {
+    switch (message->kind) {
+      case InboundMessage::Kind::kMessage: {
+        const JsonObjectConst object = message->doc->as<JsonObjectConst>();
+        handleConnectionOptions(object);
+
+        // Pass the message to the peripheral and task handlers
+        peripheral_controller_callback_(object);
+        task_controller_callback_(object);
+      } break;
+      case InboundMessage::Kind::kDeserializeError: {
+        sendError(who, String(F("Deserialize failed: ")) +
+                           message->error.c_str());
+      } break;
+      case InboundMessage::Kind::kConnected: {
+        sendRegister();
+      } break;
+      case InboundMessage::Kind::kDisconnected: {
+        // The connection options have to be negotiated again after
+        // reconnecting
+        batcher_.setFormat(WireFormat::kJson);
+        use_uuid_handles_ = false;
+        uuid_handles_.clear();
+      } break;
+    }
+
+    if (message->doc) {
+      message->doc->clear();
+    }
+    inbound_.pop();
+  }
+}
+
+WebSocket::InboundMessage& WebSocket::getInboundSlot() {
+  // Received messages are never dropped. Waiting applies back pressure on the
+  // server through the TCP connection
+  InboundMessage* message = inbound_.getWriteSlot();
+  while (!message) {
+    delay(1);
+    message = inbound_.getWriteSlot();
+  }
+  return *message;
 }
 
-void WebSocket::hexdump(const void* mem, uint32_t len, uint8_t cols) {
-  const uint8_t* src = (const uint8_t*)mem;
-  Serial.printf("\nWebSocket::Hexdump: Address: 0x%08X len: 0x%X (%d)",
-                (ptrdiff_t)src, len, len);
-  for (uint32_t i = 0; i < len; i++) {
-    if (i % cols == 0) {
-      Serial.printf("\n[0x%08X] 0x%08X: ", (ptrdiff_t)src, i);
+void WebSocket::queueFrame(const char* frame, size_t length,
+                           WireFormat format, Fragment fragment,
+                           bool is_register) {
+  OutboundFrame* slot = outbound_.getWriteSlot();
+  if (fragment == Fragment::kNone || fragment == Fragment::kFirst) {
+    is_dropping_fragments_ = !slot && fragment == Fragment::kFirst;
+    if (!slot) {
+      dropFrames(F("WebSocket: Outbound queue full. Dropping frame"));
+      return;
+    }
+  } else {
+    if (is_dropping_fragments_) {
+      is_dropping_fragments_ = fragment != Fragment::kLast;
+      return;
     }
-    Serial.printf("%02X ", *src);
-    src++;
+
+    // The slots of all fragments are reserved before the first one is queued,
+    // so that the scheduler never waits for the network thread
+    if (!slot) {
+      dropFrames(F("WebSocket: Outbound queue full. Dropping fragment"));
+      is_dropping_fragments_ = fragment != Fragment::kLast;
+      return;
+    }
+  }
+
+  // Assigning reuses the capacity of the slot's buffer
+  slot->data.assign(frame, frame + length);
+  slot->format = format;
+  slot->fragment = fragment;
+  slot->is_register = is_register;
+  // Handles and MessagePack are only valid on the connection they were
+  // negotiated on, while the journal is replayed before the server opts into
+  // them again. The journal only holds complete frames
+  slot->is_portable = !is_register && !use_uuid_handles_ &&
+                      format == WireFormat::kJson &&
+                      fragment == Fragment::kNone;
+  outbound_.push();
+}
+
+bool WebSocket::reserveFrames(size_t frame_count) {
+  // Only the scheduler queues frames, while the network thread only frees
+  // slots. The free slots therefore stay available until the message is
+  // queued
+  if (outbound_.capacity() - outbound_.size() >= frame_count) {
+    return true;
+  }
+  dropFrames(F("WebSocket: Outbound queue full. Dropping message"));
+  return false;
+}
+
+void WebSocket::dropFrames(const __FlashStringHelper* message) {
+  Serial.println(message);
+
+  // The dropped frames may have announced handles. Start with an empty
+  // dictionary, so that the following messages announce them again
+  if (use_uuid_handles_) {
+    uuid_handles_.clear();
+  }
+}
+
+void WebSocket::handleConnectionOptions(const JsonObjectConst& message) {
+  JsonVariantConst wire_format = message["wire_format"];
+  if (!wire_format.isNull()) {
+    if (wire_format == "json") {
+      batcher_.setFormat(WireFormat::kJson);
+    } else if (wire_format == "msgpack") {
+      batcher_.setFormat(WireFormat::kMsgPack);
+    } else {
+      sendError(type(), String(F("Unsupported wire_format: ")) +
+                            wire_format.as<String>());
+    }
+  }
+
+  // Start with an empty dictionary, so that all handles are announced again
+  JsonVariantConst uuid_handles = message["uuid_handles"];
+  if (uuid_handles.is<bool>()) {
+    use_uuid_handles_ = uuid_handles.as<bool>();
+    uuid_handles_.clear();
+  }
+}
+
+bool WebSocket::sendFrame(const char* frame, size_t length, WireFormat format,
+                          Fragment fragment) {
+  if (fragment == Fragment::kNone) {
+    if (format == WireFormat::kJson) {
+      return sendTXT(frame, length);
+    } else {
+      return sendBIN(reinterpret_cast<const uint8_t*>(frame), length);
+    }
+  }
+
+  // The first fragment carries the frame type, the others are continuations.
+  // The payload is only read, as the header is sent separately
+  WSopcode_t opcode = WSop_continuation;
+  if (fragment == Fragment::kFirst) {
+    opcode = format == WireFormat::kJson ? WSop_text : WSop_binary;
   }
-  Serial.printf("\n");
+  return WebSockets::sendFrame(
+      &_client, opcode, reinterpret_cast<uint8_t*>(const_cast<char*>(frame)),
+      length, fragment == Fragment::kLast);
 }
 
 }  // namespace bernd_box
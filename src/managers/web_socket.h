@@ -3,12 +3,24 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <WebSocketsClient.h>
+#include <WiFi.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "configuration.h"
+#include "message_batcher.h"
+#include "message_parser.h"
 #include "server.h"
+#include "telemetry_journal.h"
+#include "utils/json_document_pool.h"
+#include "utils/backoff.h"
+#include "utils/spsc_queue.h"
 #include "utils/uuid.h"
+#include "utils/uuid_dictionary.h"
+#include "utils/worker_thread.h"
 
 namespace bernd_box {
 
@@ -20,6 +32,29 @@ using namespace std::placeholders;
  * This class creates a bi-direactional connection with the server to create
  * peripheral and tasks on the controller, and return their output to the
  * server.
+ *
+ * The WebSocket and TLS processing and the deserialization of received
+ * messages run in a network thread of their own. Received messages and
+ * outbound frames are exchanged with the scheduler through lock-free queues.
+ * Therefore, all other functions are called from the scheduler, which
+ * dispatches the received messages in handle(). Slow writes to the server do
+ * not delay the scheduler. If the outbound queue is full, frames are dropped.
+ *
+ * Frames which cannot be sent, because the connection is down, are stored in
+ * the telemetry journal instead. Once connected and registered again, the
+ * journal is replayed in order and rate-limited, while new frames take
+ * precedence. Frames referencing UUID handles or encoded as MessagePack are
+ * only valid on their connection and are not journaled.
+ *
+ * The register message is sent whenever a connection is established.
+ *
+ * Messages larger than a batch are serialized and queued in fragments of the
+ * batch size, so no buffer grows with the message. A fragmented message is
+ * either queued completely or dropped. Received fragments are reassembled in
+ * the inbound queue's slot up to a maximum size and deserialized in place.
+ *
+ * The network thread reconnects on its own. The delay between the attempts
+ * grows exponentially with jitter and starts over when WiFi is regained.
  */
 class WebSocket : public Server, private WebSocketsClient {
  public:
@@ -32,13 +67,15 @@ class WebSocket : public Server, private WebSocketsClient {
   WebSocket(std::function<std::vector<utils::UUID>()> get_peripheral_ids,
             Server::Callback peripheral_controller_callback,
             std::function<std::vector<utils::UUID>()> get_task_ids,
-            Server::Callback task_controller_callback);
+            Server::Callback task_controller_callback,
+            std::function<void(JsonObject filter)> add_filter_keys,
+            TelemetryJournal& journal);
   virtual ~WebSocket() = default;
 
   const String& type();
 
   bool isConnected() final;
-  bool connect(std::chrono::seconds timeout) final;
+  void connect() final;
 
   void handle() final;
 
@@ -56,10 +93,164 @@ class WebSocket : public Server, private WebSocketsClient {
   void sendResults(JsonObjectConst results) final;
   void sendSystem(JsonObject data) final;
 
+  void addUUID(JsonObject object, const __FlashStringHelper* key,
+               const utils::UUID& uuid) final;
+
  private:
+  /// A message received by the network thread
+  struct InboundMessage {
+    enum class Kind { kMessage, kDeserializeError, kConnected, kDisconnected };
+
+    Kind kind;
+    /// The received message referenced by the doc
+    std::vector<char> payload;
+    /// The deserialized message. Allocated on first use of the slot
+    std::unique_ptr<DynamicJsonDocument> doc;
+    DeserializationError error;
+  };
+
+  /// A frame to be sent by the network thread
+  struct OutboundFrame {
+    std::vector<char> data;
+    WireFormat format;
+    /// Position of the frame in a fragmented message
+    Fragment fragment;
+    /// The register message is the first frame sent after connecting
+    bool is_register;
+    /// Whether the frame is valid on any connection and can be journaled
+    bool is_portable;
+  };
+
+  /**
+   * Processes the connection and sends the queued frames
+   *
+   * Called repeatedly by the network thread.
+   */
+  void handleNetwork();
+
+  /**
+   * Sets the time of the next connection attempt. Called by the network
+   * thread
+   *
+   * \param is_connect_attempt Whether the client tried to connect
+   */
+  void updateReconnectDelay(bool is_connect_attempt);
+
+  /**
+   * Sends the queued frames. Frames queued while disconnected or before the
+   * register message of a new connection are journaled. Called by the network
+   * thread
+   */
+  void sendQueuedFrames();
+
+  /**
+   * Sends the oldest journaled frame if the connection is idle and the replay
+   * interval elapsed. Called by the network thread
+   */
+  void replayJournal();
+
+  /**
+   * Dispatches the messages received by the network thread. Called by the
+   * scheduler
+   */
+  void handleInbound();
+
+  /**
+   * Queues a received message or event for the scheduler
+   *
+   * Waits for a free slot if the scheduler lags behind. Called by the network
+   * thread
+   *
+   * \return The slot to fill and publish with inbound_.push()
+   */
+  InboundMessage& getInboundSlot();
+
+  /**
+   * Queues a frame to be sent by the network thread. Called by the scheduler
+   *
+   * A full queue drops a whole frame or the first fragment of a message and
+   * its following fragments. Fragmented messages reserve their slots with
+   * reserveFrames() first.
+   *
+   * \param frame The serialized message or batch of messages
+   * \param length The length of the frame in bytes
+   * \param format Text frame for JSON, binary frame for MessagePack
+   * \param fragment The position of the frame in a fragmented message
+   * \param is_register Whether the frame holds the register message
+   */
+  void queueFrame(const char* frame, size_t length, WireFormat format,
+                  Fragment fragment, bool is_register);
+
+  /**
+   * Checks that the queue has a free slot for each frame of a message.
+   * Called by the scheduler
+   *
+   * \param frame_count The number of frames of the message
+   * \return True if the frames can be queued
+   */
+  bool reserveFrames(size_t frame_count);
+
+  /**
+   * Reports frames dropped on a full queue. Called by the scheduler
+   *
+   * Clears the UUID handles, as the server may have missed their
+   * announcements.
+   *
+   * \param message The log message naming what was dropped
+   */
+  void dropFrames(const __FlashStringHelper* message);
+
+  /// Called by the network thread
   void handleEvent(WStype_t type, uint8_t* payload, size_t length);
-  void handleData(const uint8_t* payload, size_t length);
-  void hexdump(const void* mem, uint32_t len, uint8_t cols = 16);
+  /// Deserializes a received message into the inbound queue. Called by the
+  /// network thread
+  void handleData(const uint8_t* payload, size_t length, WireFormat format);
+
+  /**
+   * Appends a received fragment to the message in the inbound queue's slot
+   *
+   * The message is deserialized and queued with the last fragment. Messages
+   * exceeding the maximum size are queued as a deserialization error. Called
+   * by the network thread
+   *
+   * \param payload The fragment
+   * \param length The length of the fragment in bytes
+   * \param fragment The position of the fragment in the message
+   * \param format The wire format. Only read for the first fragment
+   */
+  void handleFragment(const uint8_t* payload, size_t length,
+                      Fragment fragment, WireFormat format);
+
+  /**
+   * Applies the connection options the server opted into
+   *
+   * The server opts into the options advertised in the register message by
+   * adding their key to a message. These are wire_format ("json" or
+   * "msgpack") and uuid_handles (bool).
+   *
+   * \param message The message received from the server
+   */
+  void handleConnectionOptions(const JsonObjectConst& message);
+
+  /**
+   * Announces the handle of a UUID to the server
+   *
+   * \param handle The handle referencing the UUID from now on
+   * \param uuid The UUID
+   */
+  void sendUUIDHandle(uint16_t handle, const utils::UUID& uuid);
+
+  /**
+   * Sends a frame to the server. Called by the network thread
+   *
+   * \param frame The serialized message or batch of messages
+   * \param length The length of the frame in bytes
+   * \param format Text frame for JSON, binary frame for MessagePack
+   * \param fragment The position of the frame in a fragmented message
+   * \return True if the frame was sent
+   */
+  bool sendFrame(const char* frame, size_t length, WireFormat format,
+                 Fragment fragment = Fragment::kNone);
 
   bool is_setup_ = false;
 
@@ -68,10 +259,61 @@ class WebSocket : public Server, private WebSocketsClient {
   std::function<std::vector<utils::UUID>()> get_task_ids_;
   Callback task_controller_callback_;
 
+  /// Deserializes the received messages. Only used by the network thread
+  MessageParser parser_;
+  /// Coalesces the outbound messages into frames
+  MessageBatcher batcher_;
+  /// Holds one fragment of the register message at a time
+  std::vector<char> register_buffer_;
+  /// Set if the register message did not fit into the queue yet
+  bool is_register_pending_ = false;
+  /// Set while the following fragments of a dropped message are skipped
+  bool is_dropping_fragments_ = false;
+  /// Handles of the UUIDs already announced on this connection
+  utils::UUIDDictionary uuid_handles_;
+  /// Whether the server opted into referencing UUIDs by handles
+  bool use_uuid_handles_ = false;
+
+  /// Messages received by the network thread
+  utils::SpscQueue<InboundMessage> inbound_;
+  /// Frames to be sent by the network thread
+  utils::SpscQueue<OutboundFrame> outbound_;
+  /// Connection state as seen by the network thread
+  std::atomic<bool> is_connected_{false};
+  /// Set by the network thread until the register message is sent
+  bool is_awaiting_register_ = false;
+  /// Whether the frames of the current message are sent or skipped. Only
+  /// used by the network thread
+  bool is_sending_message_ = false;
+  /// Set by the network thread while reassembling a received message
+  bool is_receiving_fragments_ = false;
+  /// Whether the message being reassembled exceeded the maximum size
+  bool is_fragment_overflow_ = false;
+  WireFormat fragment_format_ = WireFormat::kJson;
+  /// Delay between the connection attempts of the network thread
+  utils::Backoff reconnect_backoff_;
+  /// When the client may try to connect again
+  std::chrono::milliseconds next_connect_attempt_{0};
+  /// Whether the client's TCP connection was open. Used to detect its close
+  bool was_client_connected_ = false;
+
+  /// Holds the frames while disconnected. Only used by the network thread
+  TelemetryJournal& journal_;
+  /// Buffer of the replayed frame
+  std::vector<char> replay_frame_;
+  /// When the last journaled frame was replayed
+  std::chrono::milliseconds last_replay_{0};
+  /// Set when a replayed frame could not be sent. The replay continues on
+  /// the next connection
+  bool is_replay_stopped_ = false;
+
   const char* core_domain_;
   const char* controller_path_ = "/ws-api/v1/farms/controllers/";
   const char* ws_token_;
   const char* root_cas_;
+
+  /// Runs the WebSocket and TLS stack. Stopped before the queues are deleted
+  utils::WorkerThread network_thread_;
 };
 
 }  // namespace bernd_box
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "adc_calibration.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+#ifdef ARDUINO_ARCH_ESP32
+
+AdcCalibration::AdcCalibration(Attenuation attenuation,
+                               uint32_t default_vref_mv) {
+  esp_adc_cal_characterize(ADC_UNIT_1, static_cast<adc_atten_t>(attenuation),
+                           ADC_WIDTH_BIT_12, default_vref_mv,
+                           &characteristics_);
+}
+
+uint32_t AdcCalibration::toMillivolts(uint32_t raw) const {
+  return esp_adc_cal_raw_to_voltage(raw, &characteristics_);
+}
+
+#else
+
+AdcCalibration::AdcCalibration(Attenuation attenuation,
+                               uint32_t default_vref_mv) {
+  // The full scale voltages relative to a reference of 1.1 V
+  switch (attenuation) {
+    case Attenuation::k0dB:
+      full_scale_mv_ = default_vref_mv;
+      break;
+    case Attenuation::k2_5dB:
+      full_scale_mv_ = default_vref_mv * 15 / 11;
+      break;
+    case Attenuation::k6dB:
+      full_scale_mv_ = default_vref_mv * 2;
+      break;
+    case Attenuation::k11dB:
+    default:
+      full_scale_mv_ = default_vref_mv * 39 / 11;
+      break;
+  }
+}
+
+uint32_t AdcCalibration::toMillivolts(uint32_t raw) const {
+  return raw * full_scale_mv_ / max_raw_;
+}
+
+#endif
+
+float AdcCalibration::toVolts(float raw) const {
+  if (!(raw > 0)) {
+    return toMillivolts(0) / 1000.0f;
+  }
+  if (raw >= max_raw_) {
+    return toMillivolts(max_raw_) / 1000.0f;
+  }
+
+  const uint32_t lower = raw;
+  const float lower_mv = toMillivolts(lower);
+  const float upper_mv = toMillivolts(lower + 1);
+  return (lower_mv + (raw - lower) * (upper_mv - lower_mv)) / 1000.0f;
+}
+
+const uint32_t AdcCalibration::max_raw_ = 4095;
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_adc_cal.h>
+#endif
+
+#include "sample_source.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+/**
+ * Converts raw ADC1 values to voltages using the chip's characterization
+ *
+ * The ESP32's ADC is neither linear nor has an exact reference voltage. On
+ * the ESP32, esp_adc_cal characterizes the ADC with the reference voltage or
+ * the two point values burnt into the eFuses, and falls back to the default
+ * reference voltage. Elsewhere, the nominal full scale voltage is used.
+ */
+class AdcCalibration {
+ public:
+  /**
+   * \param attenuation The attenuation the pin is sampled with
+   * \param default_vref_mv The reference voltage if none is burnt into the
+   *                        eFuses
+   */
+  AdcCalibration(Attenuation attenuation, uint32_t default_vref_mv);
+
+  /**
+   * Converts a raw value to a voltage
+   *
+   * Averaged raw values keep their finer resolution by interpolating between
+   * the neighbouring raw values.
+   *
+   * \param raw The raw 12-bit value, may be fractional
+   * \return The voltage in volts
+   */
+  float toVolts(float raw) const;
+
+ private:
+  /// Converts an integer raw value to millivolts
+  uint32_t toMillivolts(uint32_t raw) const;
+
+#ifdef ARDUINO_ARCH_ESP32
+  esp_adc_cal_characteristics_t characteristics_;
+#else
+  /// Millivolts at the largest raw value
+  uint32_t full_scale_mv_;
+#endif
+
+  static const uint32_t max_raw_;
+};
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
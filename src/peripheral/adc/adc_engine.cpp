@@ -0,0 +1,161 @@
+#include "adc_engine.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+AdcEngine::AdcEngine(Scheduler& scheduler, SampleSource& source,
+                     uint32_t sample_rate, size_t buffer_size,
+                     std::chrono::milliseconds drain_interval)
+    : Task(&scheduler),
+      source_(source),
+      sample_rate_(sample_rate),
+      buffer_size_(buffer_size),
+      samples_(256) {
+  Task::setIterations(TASK_FOREVER);
+  Task::setInterval(drain_interval.count());
+}
+
+bool AdcEngine::addChannel(uint8_t pin, Attenuation attenuation) {
+  Channel* channel = findChannel(pin);
+  if (channel) {
+    if (channel->attenuation != attenuation) {
+      return false;
+    }
+    channel->users++;
+    return true;
+  }
+
+  channels_.push_back(Channel{pin, attenuation, 1,
+                              std::vector<uint16_t>(buffer_size_), 0});
+  if (!restart()) {
+    channels_.pop_back();
+    restart();
+    return false;
+  }
+  enableIfNot();
+  return true;
+}
+
+void AdcEngine::removeChannel(uint8_t pin) {
+  for (auto it = channels_.begin(); it != channels_.end(); it++) {
+    if (it->pin == pin) {
+      it->users--;
+      if (it->users == 0) {
+        channels_.erase(it);
+        restart();
+      }
+      break;
+    }
+  }
+
+  if (channels_.empty()) {
+    disable();
+  }
+}
+
+void AdcEngine::handle() {
+  // More samples than fit the ring buffers would be overwritten anyway. This
+  // also bounds the time spent per call
+  size_t remaining = buffer_size_ * channels_.size();
+  while (remaining > 0) {
+    const size_t count =
+        source_.read(samples_.data(), std::min(remaining, samples_.size()));
+    if (count == 0) {
+      break;
+    }
+    remaining -= count;
+
+    for (size_t i = 0; i < count; i++) {
+      Channel* channel = findChannel(samples_[i].pin);
+      if (channel) {
+        channel->buffer[channel->written % buffer_size_] = samples_[i].value;
+        channel->written++;
+      }
+    }
+  }
+}
+
+bool AdcEngine::getAverage(uint8_t pin, size_t count, float& average) {
+  Channel* channel = findChannel(pin);
+  if (!channel || count == 0 || count > buffer_size_ ||
+      channel->written < count) {
+    return false;
+  }
+
+  // Sum the ring buffer in up to two contiguous runs, so that the loops
+  // don't wrap the index on every sample
+  const uint16_t* buffer = channel->buffer.data();
+  const size_t end = channel->written % buffer_size_;
+  const size_t begin = (end + buffer_size_ - count) % buffer_size_;
+  uint32_t sum = 0;
+  if (begin < end) {
+    sum = std::accumulate(buffer + begin, buffer + end, sum);
+  } else {
+    sum = std::accumulate(buffer + begin, buffer + buffer_size_, sum);
+    sum = std::accumulate(buffer, buffer + end, sum);
+  }
+  average = float(sum) / float(count);
+  return true;
+}
+
+size_t AdcEngine::read(uint8_t pin, uint32_t& cursor, uint16_t* samples,
+                       size_t max_count) {
+  Channel* channel = findChannel(pin);
+  if (!channel) {
+    return 0;
+  }
+
+  // Skip the samples that were already overwritten
+  if (channel->written - cursor > buffer_size_) {
+    cursor = channel->written - buffer_size_;
+  }
+
+  size_t count = 0;
+  while (count < max_count && cursor != channel->written) {
+    samples[count] = channel->buffer[cursor % buffer_size_];
+    cursor++;
+    count++;
+  }
+  return count;
+}
+
+uint32_t AdcEngine::getSampleCount(uint8_t pin) {
+  Channel* channel = findChannel(pin);
+  return channel ? channel->written : 0;
+}
+
+uint32_t AdcEngine::getSampleRate() const { return sample_rate_; }
+
+bool AdcEngine::Callback() {
+  handle();
+  return true;
+}
+
+bool AdcEngine::restart() {
+  source_.stop();
+  if (channels_.empty()) {
+    return true;
+  }
+
+  // The sample counts continue, so that the cursors of the consumers stay
+  // valid
+  std::vector<SampleSource::Channel> channels;
+  for (const auto& channel : channels_) {
+    channels.push_back(SampleSource::Channel{channel.pin, channel.attenuation});
+  }
+  return source_.start(channels, sample_rate_);
+}
+
+AdcEngine::Channel* AdcEngine::findChannel(uint8_t pin) {
+  for (auto& channel : channels_) {
+    if (channel.pin == pin) {
+      return &channel;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Arduino.h>
+#include <TaskSchedulerDeclarations.h>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+#include "sample_source.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+/**
+ * Samples the analog inputs in the background
+ *
+ * The engine scans the pins of all registered channels with a continuously
+ * sampling source. As a task, it regularly moves the source's samples into a
+ * ring buffer per channel. Peripherals read averaged values from the newest
+ * samples, while consumer tasks can follow the raw stream of a channel.
+ */
+class AdcEngine : public Task {
+ public:
+  /**
+   * \param scheduler The scheduler which regularly drains the source
+   * \param source The source sampling the pins
+   * \param sample_rate Samples per second of each pin
+   * \param buffer_size Number of samples kept per channel
+   * \param drain_interval How often the source is drained
+   */
+  AdcEngine(Scheduler& scheduler, SampleSource& source, uint32_t sample_rate,
+            size_t buffer_size, std::chrono::milliseconds drain_interval);
+  virtual ~AdcEngine() = default;
+
+  /**
+   * Adds a user of a pin and starts sampling it if it is the first one
+   *
+   * All users of a pin share its attenuation.
+   *
+   * \param pin The pin to sample
+   * \param attenuation The attenuation to sample the pin with
+   * \return True if the source samples the pin with the attenuation
+   */
+  bool addChannel(uint8_t pin, Attenuation attenuation = Attenuation::k11dB);
+
+  /**
+   * Removes a user of a pin and stops sampling it if it was the last one
+   *
+   * \param pin The sampled pin
+   */
+  void removeChannel(uint8_t pin);
+
+  /**
+   * Moves the samples of the source into the ring buffers
+   */
+  void handle();
+
+  /**
+   * Averages the newest samples of a pin
+   *
+   * Averaging oversamples the pin, so that the average has a finer resolution
+   * than the raw values.
+   *
+   * \param pin The sampled pin
+   * \param count The number of samples to average
+   * \param average The average of the raw values
+   * \return False if the pin is not sampled or has fewer samples than count
+   */
+  bool getAverage(uint8_t pin, size_t count, float& average);
+
+  /**
+   * Reads the raw samples of a pin following the cursor
+   *
+   * A new consumer starts with a cursor of 0. If the consumer fell behind by
+   * more than the buffer size, the oldest samples are skipped.
+   *
+   * \param pin The sampled pin
+   * \param cursor Index of the next sample to read. Advanced by the read count
+   * \param samples Buffer to read the raw values into
+   * \param max_count Maximum number of samples to read
+   * \return The number of samples read
+   */
+  size_t read(uint8_t pin, uint32_t& cursor, uint16_t* samples,
+              size_t max_count);
+
+  /**
+   * Gets the number of samples of a pin since sampling started
+   *
+   * \param pin The sampled pin
+   * \return The number of samples, 0 if the pin is not sampled
+   */
+  uint32_t getSampleCount(uint8_t pin);
+
+  /// Samples per second of each pin
+  uint32_t getSampleRate() const;
+
+ private:
+  struct Channel {
+    uint8_t pin;
+    Attenuation attenuation;
+    /// Number of peripherals using the pin
+    size_t users;
+    /// The newest samples
+    std::vector<uint16_t> buffer;
+    /// Number of samples written since sampling started
+    uint32_t written;
+  };
+
+  bool Callback() final;
+
+  /**
+   * Restarts the source with the pins of all channels
+   *
+   * \return True on success
+   */
+  bool restart();
+
+  Channel* findChannel(uint8_t pin);
+
+  SampleSource& source_;
+  const uint32_t sample_rate_;
+  const size_t buffer_size_;
+
+  std::vector<Channel> channels_;
+  /// Samples read from the source in one go
+  std::vector<SampleSource::Sample> samples_;
+};
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
@@ -0,0 +1,150 @@
+#ifdef ARDUINO_ARCH_ESP32
+
+#include "i2s_adc_source.h"
+
+#include <soc/syscon_struct.h>
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+I2sAdcSource::~I2sAdcSource() { stop(); }
+
+bool I2sAdcSource::start(const std::vector<Channel>& channels,
+                         uint32_t sample_rate) {
+  stop();
+
+  // The pattern table holds up to 16 conversions
+  if (channels.empty() || channels.size() > 16) {
+    return false;
+  }
+
+  std::vector<adc1_channel_t> adc_channels;
+  for (const auto& channel : channels) {
+    adc1_channel_t adc_channel;
+    if (!getChannel(channel.pin, adc_channel)) {
+      return false;
+    }
+    adc_channels.push_back(adc_channel);
+    channel_pins_[adc_channel] = channel.pin;
+  }
+
+  // The sample rate of the I2S peripheral is shared by all scanned pins
+  i2s_config_t config = {};
+  config.mode = static_cast<i2s_mode_t>(I2S_MODE_MASTER | I2S_MODE_RX |
+                                        I2S_MODE_ADC_BUILT_IN);
+  config.sample_rate = sample_rate * channels.size();
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  config.communication_format = I2S_COMM_FORMAT_I2S_MSB;
+  config.dma_buf_count = dma_buffer_count_;
+  config.dma_buf_len = dma_buffer_length_;
+  if (i2s_driver_install(i2s_port_, &config, 0, nullptr) != ESP_OK) {
+    return false;
+  }
+  is_running_ = true;
+
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  for (size_t i = 0; i < channels.size(); i++) {
+    adc1_config_channel_atten(
+        adc_channels[i], static_cast<adc_atten_t>(channels[i].attenuation));
+  }
+  i2s_set_adc_mode(ADC_UNIT_1, adc_channels.front());
+
+  // Replace the single channel pattern with the scan of all pins. Each entry
+  // is [7:4] channel, [3:2] bit width (3 = 12 bit) and [1:0] attenuation.
+  // The four registers hold four entries each, first in the most significant
+  // byte
+  uint32_t pattern_table[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < channels.size(); i++) {
+    const uint32_t entry = (adc_channels[i] << 4) | (3 << 2) |
+                           static_cast<uint32_t>(channels[i].attenuation);
+    pattern_table[i / 4] |= entry << (24 - 8 * (i % 4));
+  }
+  SYSCON.saradc_ctrl.sar1_patt_len = channels.size() - 1;
+  for (size_t i = 0; i < 4; i++) {
+    SYSCON.saradc_sar1_patt_tab[i] = pattern_table[i];
+  }
+
+  if (i2s_adc_enable(i2s_port_) != ESP_OK) {
+    stop();
+    return false;
+  }
+  return true;
+}
+
+void I2sAdcSource::stop() {
+  if (!is_running_) {
+    return;
+  }
+
+  i2s_adc_disable(i2s_port_);
+  i2s_driver_uninstall(i2s_port_);
+  is_running_ = false;
+}
+
+size_t I2sAdcSource::read(Sample* samples, size_t max_count) {
+  if (!is_running_) {
+    return 0;
+  }
+
+  if (buffer_.size() < max_count) {
+    buffer_.resize(max_count);
+  }
+
+  // Only take what the DMA already delivered
+  size_t bytes_read = 0;
+  i2s_read(i2s_port_, buffer_.data(), max_count * sizeof(uint16_t),
+           &bytes_read, 0);
+
+  // Every word carries the channel in the upper 4 bits and the value in the
+  // lower 12 bits
+  const size_t count = bytes_read / sizeof(uint16_t);
+  for (size_t i = 0; i < count; i++) {
+    const uint16_t word = buffer_[i];
+    samples[i] = Sample{channel_pins_[(word >> 12) % ADC1_CHANNEL_MAX],
+                        static_cast<uint16_t>(word & 0x0FFF)};
+  }
+  return count;
+}
+
+bool I2sAdcSource::getChannel(uint8_t pin, adc1_channel_t& channel) {
+  switch (pin) {
+    case 36:
+      channel = ADC1_CHANNEL_0;
+      return true;
+    case 37:
+      channel = ADC1_CHANNEL_1;
+      return true;
+    case 38:
+      channel = ADC1_CHANNEL_2;
+      return true;
+    case 39:
+      channel = ADC1_CHANNEL_3;
+      return true;
+    case 32:
+      channel = ADC1_CHANNEL_4;
+      return true;
+    case 33:
+      channel = ADC1_CHANNEL_5;
+      return true;
+    case 34:
+      channel = ADC1_CHANNEL_6;
+      return true;
+    case 35:
+      channel = ADC1_CHANNEL_7;
+      return true;
+    default:
+      return false;
+  }
+}
+
+const i2s_port_t I2sAdcSource::i2s_port_ = I2S_NUM_0;
+const int I2sAdcSource::dma_buffer_count_ = 8;
+const int I2sAdcSource::dma_buffer_length_ = 256;
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
+
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <driver/i2s.h>
+
+#include <array>
+#include <vector>
+
+#include "sample_source.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+/**
+ * Continuous ADC1 sampling through the I2S peripheral's DMA
+ *
+ * The I2S peripheral clocks the ADC and writes the conversions into DMA
+ * buffers without involving the CPU. Several pins are scanned by loading
+ * them into the ADC's pattern table, which tags every conversion with its
+ * channel. Only the ADC1 pins (32 - 39) can be scanned, as ADC2 is used by
+ * the WiFi driver. analogRead() must not be used while the scan is running.
+ */
+class I2sAdcSource : public SampleSource {
+ public:
+  I2sAdcSource() = default;
+  virtual ~I2sAdcSource();
+
+  bool start(const std::vector<Channel>& channels,
+             uint32_t sample_rate) final;
+  void stop() final;
+  size_t read(Sample* samples, size_t max_count) final;
+
+ private:
+  /**
+   * Gets the ADC1 channel of a pin
+   *
+   * \param pin The GPIO number
+   * \param channel The channel of the pin
+   * \return True if the pin is an ADC1 pin
+   */
+  static bool getChannel(uint8_t pin, adc1_channel_t& channel);
+
+  /// Whether the I2S driver is installed
+  bool is_running_ = false;
+  /// The pin of each ADC1 channel
+  std::array<uint8_t, ADC1_CHANNEL_MAX> channel_pins_{};
+  /// Raw DMA words read from the I2S driver
+  std::vector<uint16_t> buffer_;
+
+  static const i2s_port_t i2s_port_;
+  /// Number and length in samples of the DMA buffers
+  static const int dma_buffer_count_;
+  static const int dma_buffer_length_;
+};
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
+
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <vector>
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+/**
+ * Input attenuation of the ADC, which sets the voltage range of a pin
+ *
+ * The nominal full scale voltages are about 1.1 V, 1.5 V, 2.2 V and 3.9 V.
+ * The values match the ADC's attenuation register.
+ */
+enum class Attenuation : uint8_t {
+  k0dB = 0,
+  k2_5dB = 1,
+  k6dB = 2,
+  k11dB = 3,
+};
+
+/**
+ * Interface of a continuously sampling analog to digital converter
+ *
+ * The source scans a set of pins in the background. The samples of all pins
+ * are read interleaved and in the order they were taken.
+ */
+class SampleSource {
+ public:
+  /// A single conversion of a pin
+  struct Sample {
+    uint8_t pin;
+    /// The raw 12-bit value
+    uint16_t value;
+  };
+
+  /// A pin to scan
+  struct Channel {
+    uint8_t pin;
+    Attenuation attenuation;
+  };
+
+  virtual ~SampleSource() = default;
+
+  /**
+   * Starts scanning the pins, replacing any previous scan
+   *
+   * \param channels The pins to scan in order with their attenuation
+   * \param sample_rate Samples per second of each pin
+   * \return True on success
+   */
+  virtual bool start(const std::vector<Channel>& channels,
+                     uint32_t sample_rate) = 0;
+
+  /**
+   * Stops scanning and drops the unread samples
+   */
+  virtual void stop() = 0;
+
+  /**
+   * Reads the available samples without blocking
+   *
+   * \param samples Buffer to read the samples into
+   * \param max_count The maximum number of samples to read
+   * \return The number of samples read
+   */
+  virtual size_t read(Sample* samples, size_t max_count) = 0;
+};
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
@@ -0,0 +1,53 @@
+#include "synthetic_source.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+SyntheticSource::SyntheticSource(Generator generator, bool is_paced)
+    : generator_(generator), is_paced_(is_paced) {}
+
+bool SyntheticSource::start(const std::vector<Channel>& channels,
+                            uint32_t sample_rate) {
+  // The generator models the attenuation, if it matters
+  pins_.clear();
+  for (const auto& channel : channels) {
+    pins_.push_back(channel.pin);
+  }
+  sample_rate_ = sample_rate;
+  start_us_ = micros();
+  produced_ = 0;
+  return true;
+}
+
+void SyntheticSource::stop() { pins_.clear(); }
+
+size_t SyntheticSource::read(Sample* samples, size_t max_count) {
+  if (pins_.empty()) {
+    return 0;
+  }
+
+  size_t count = max_count;
+  if (is_paced_) {
+    const uint64_t elapsed_us = micros() - start_us_;
+    const uint64_t due =
+        elapsed_us * sample_rate_ / 1000000 * pins_.size() - produced_;
+    if (due < count) {
+      count = due;
+    }
+  }
+
+  // The pins are scanned round robin like the ADC does
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t pin = pins_[produced_ % pins_.size()];
+    const uint32_t index = produced_ / pins_.size();
+    samples[i] = Sample{pin, static_cast<uint16_t>(generator_(pin, index) &
+                                                   0x0FFF)};
+    produced_++;
+  }
+  return count;
+}
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
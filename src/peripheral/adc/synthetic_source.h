@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <functional>
+#include <vector>
+
+#include "sample_source.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace adc {
+
+/**
+ * Sample source producing computed samples
+ *
+ * Replaces the ADC on the host and in tests. The samples are produced at the
+ * requested rate based on the elapsed time. An unpaced source produces as
+ * many samples as are read, which makes benchmarks independent of the clock.
+ */
+class SyntheticSource : public SampleSource {
+ public:
+  /// Computes the value of the index-th sample of a pin
+  using Generator = std::function<uint16_t(uint8_t pin, uint32_t index)>;
+
+  /**
+   * \param generator Function computing the samples
+   * \param is_paced False to produce samples regardless of the sample rate
+   */
+  SyntheticSource(Generator generator, bool is_paced = true);
+  virtual ~SyntheticSource() = default;
+
+  bool start(const std::vector<Channel>& channels,
+             uint32_t sample_rate) final;
+  void stop() final;
+  size_t read(Sample* samples, size_t max_count) final;
+
+ private:
+  Generator generator_;
+  const bool is_paced_;
+
+  std::vector<uint8_t> pins_;
+  uint32_t sample_rate_ = 0;
+  /// When the scan was started
+  unsigned long start_us_ = 0;
+  /// Number of samples produced since the start over all pins
+  uint64_t produced_ = 0;
+};
+
+}  // namespace adc
+}  // namespace peripheral
+}  // namespace bernd_box
@@ -4,7 +4,6 @@
 
 #include <chrono>
 #include <memory>
-#include <set>
 
 #include "peripheral/peripheral.h"
 #include "utils/uuid.h"
@@ -50,10 +49,8 @@ class Calibrate {
    */
   virtual Result handleCalibration() = 0;
 
-  // Type checking
-  static bool registerType(const String& type);
-  static bool isSupported(const String& type);
-  static const std::set<String>& getTypes();
+  /// The bit of the capability in the peripheral's capability mask
+  static constexpr Capability capability = Capability::kCalibrate;
 
   /**
    * Error when a peripheral can't be casted to the specific capability.
@@ -63,10 +60,7 @@ class Calibrate {
    * \return The error message
    */
   static String invalidTypeError(const utils::UUID& uuid,
-                                 std::shared_ptr<Peripheral> peripheral);
-
- private:
-  static std::set<String>& getSupportedTypes();
+                                 const Peripheral& peripheral);
 };
 
 }  // namespace capabilities
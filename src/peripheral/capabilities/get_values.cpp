@@ -4,33 +4,17 @@ namespace bernd_box {
 namespace peripheral {
 namespace capabilities {
 
-bool GetValues::registerType(const String& type) {
-  return getSupportedTypes().insert(type).second;
-}
-
-bool GetValues::isSupported(const String& type) {
-  const std::set<String>& types = getSupportedTypes();
-  return std::binary_search(types.begin(), types.end(), type);
-}
-
-const std::set<String>& GetValues::getTypes() { return getSupportedTypes(); }
-
 String GetValues::invalidTypeError(const utils::UUID& uuid,
-                                   std::shared_ptr<Peripheral> peripheral) {
+                                   const Peripheral& peripheral) {
   String error(F("GetValues capability not supported: "));
   error += uuid.toString();
   error += F(" is a ");
-  error += peripheral->getType();
+  error += peripheral.getType();
   return error;
 }
 
 const __FlashStringHelper* GetValues::get_values_error_ = F("GetValues error");
 
-std::set<String>& GetValues::getSupportedTypes() {
-  static std::set<String> supported_types;
-  return supported_types;
-}
-
 }  // namespace capabilities
 }  // namespace peripheral
 }  // namespace bernd_box
\ No newline at end of file
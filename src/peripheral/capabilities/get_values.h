@@ -3,7 +3,7 @@
 #include <Arduino.h>
 
 #include <memory>
-#include <set>
+#include <vector>
 
 #include "peripheral/peripheral.h"
 #include "utils/uuid.h"
@@ -27,10 +27,8 @@ class GetValues {
    */
   virtual Result getValues() = 0;
 
-  // Type checking
-  static bool registerType(const String& type);
-  static bool isSupported(const String& type);
-  static const std::set<String>& getTypes();
+  /// The bit of the capability in the peripheral's capability mask
+  static constexpr Capability capability = Capability::kGetValues;
 
   /**
    * Error when a peripheral can't be casted to the specific capability.
@@ -40,13 +38,10 @@ class GetValues {
    * \return The error message
    */
   static String invalidTypeError(const utils::UUID& uuid,
-                                 std::shared_ptr<Peripheral> peripheral);
+                                 const Peripheral& peripheral);
 
  protected:
   static const __FlashStringHelper* get_values_error_;
-
- private:
-  static std::set<String>& getSupportedTypes();
 };
 
 }  // namespace capabilities
@@ -3,7 +3,6 @@
 #include <Arduino.h>
 
 #include <memory>
-#include <set>
 
 #include "peripheral/peripheral.h"
 #include "utils/color.h"
@@ -32,16 +31,11 @@ class LedStrip {
    */
   virtual void turnOff() = 0;
 
-  // Type checking
-  static bool registerType(const String& type);
-  static bool isSupported(const String& type);
-  static const std::set<String>& getTypes();
+  /// The bit of the capability in the peripheral's capability mask
+  static constexpr Capability capability = Capability::kLedStrip;
 
   static String invalidTypeError(const utils::UUID& uuid,
-                                 std::shared_ptr<Peripheral> peripheral);
-
- private:
-  static std::set<String>& getSupportedTypes();
+                                 const Peripheral& peripheral);
 };
 
 }  // namespace capabilities
@@ -2,8 +2,8 @@
 
 #include <Arduino.h>
 
+#include <chrono>
 #include <memory>
-#include <set>
 
 #include "peripheral/peripheral.h"
 #include "utils/uuid.h"
@@ -45,16 +45,11 @@ class StartMeasurement {
    */
   virtual Result handleMeasurement() = 0;
 
-  // Type checking
-  static bool registerType(const String& type);
-  static bool isSupported(const String& type);
-  static const std::set<String>& getTypes();
+  /// The bit of the capability in the peripheral's capability mask
+  static constexpr Capability capability = Capability::kStartMeasurement;
 
   static String invalidTypeError(const utils::UUID& uuid,
-                                 std::shared_ptr<Peripheral> peripheral);
-
- private:
-  static std::set<String>& getSupportedTypes();
+                                 const Peripheral& peripheral);
 };
 
 }  // namespace capabilities
@@ -12,18 +12,15 @@ InvalidPeripheral::InvalidPeripheral(const String& error) {
 }
 
 const String& InvalidPeripheral::type() {
-  static const String name{"InvalidPeripheral"};
+  static const String name{type_name_};
   return name;
 }
 
 const String& InvalidPeripheral::getType() const { return type(); }
 
-std::shared_ptr<Peripheral> InvalidPeripheral::factory(const JsonObjectConst&) {
-  return std::make_shared<InvalidPeripheral>();
+std::unique_ptr<Peripheral> InvalidPeripheral::factory(const JsonObjectConst&) {
+  return std::unique_ptr<Peripheral>(new InvalidPeripheral());
 }
 
-bool InvalidPeripheral::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
 }  // namespace peripheral
 }  // namespace bernd_box
@@ -13,12 +13,9 @@ class InvalidPeripheral : public Peripheral {
   virtual ~InvalidPeripheral() = default;
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "InvalidPeripheral";
   static const String& type();
-
- private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst&);
-
-  static bool registered_;
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst&);
 };
 
 }  // namespace peripheral
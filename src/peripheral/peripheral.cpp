@@ -13,6 +13,10 @@ ErrorResult Peripheral::getError() const {
   }
 }
 
+bool Peripheral::hasCapability(Capability capability) const {
+  return capabilities_ & (1 << index(capability));
+}
+
 void Peripheral::setInvalid() { valid_ = false; }
 
 void Peripheral::setInvalid(const String& error_message) {
@@ -3,14 +3,32 @@
 #include <Arduino.h>
 
 #include <array>
+#include <memory>
+#include <type_traits>
 
-#include "managers/io_types.h"
+#include "managers/error_result.h"
 
 namespace bernd_box {
 namespace peripheral {
 
 class TaskFactory;
 
+/**
+ * Capabilities a peripheral can support
+ *
+ * Each capability interface in peripheral/capabilities/ names its value as
+ * its static capability member.
+ */
+enum class Capability : uint8_t {
+  kGetValues,
+  kStartMeasurement,
+  kCalibrate,
+  kSetValue,
+  kLedStrip,
+  /// Number of capabilities, not a capability
+  kCount,
+};
+
 class Peripheral {
  public:
   Peripheral() = default;
@@ -40,7 +58,56 @@ class Peripheral {
    */
   ErrorResult getError() const;
 
+  /**
+   * Checks if the peripheral supports a capability
+   *
+   * \param capability The capability to check
+   * \return True if supported
+   */
+  bool hasCapability(Capability capability) const;
+
+  /**
+   * Gets a capability interface of the peripheral
+   *
+   * Replaces a dynamic_cast, so that no RTTI is needed. The check is a bit
+   * test of the capability mask and the cast adds the interface's offset in
+   * the concrete peripheral.
+   *
+   * \tparam T The capability interface, e.g. capabilities::GetValues
+   * \return The interface or a nullptr if the capability is not supported
+   */
+  template <typename T>
+  T* getCapability() {
+    if (!hasCapability(T::capability)) {
+      return nullptr;
+    }
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(this) +
+                                capability_offsets_[index(T::capability)]);
+  }
+
  protected:
+  /**
+   * Adds a capability the concrete peripheral implements
+   *
+   * Has to be called in the constructor of the concrete peripheral for each
+   * of its capability interfaces, e.g.
+   * addCapability<capabilities::GetValues>(this). The offset of the interface
+   * is known at compile time.
+   *
+   * \tparam T The capability interface
+   * \param peripheral The concrete peripheral
+   */
+  template <typename T, typename Derived>
+  void addCapability(Derived* peripheral) {
+    static_assert(std::is_base_of<T, Derived>::value,
+                  "The peripheral doesn't implement the capability");
+    T* capability = peripheral;
+    Peripheral* base = peripheral;
+    capability_offsets_[index(T::capability)] =
+        reinterpret_cast<char*>(capability) - reinterpret_cast<char*>(base);
+    capabilities_ |= 1 << index(T::capability);
+  }
+
   /**
    * Mark the peripheral as invalid and should therefore not be used
    *
@@ -68,6 +135,16 @@ class Peripheral {
   bool valid_ = true;
   /// The error message if an error occured
   String error_message_;
+
+  static constexpr size_t index(Capability capability) {
+    return static_cast<size_t>(capability);
+  }
+
+  /// One bit per supported capability
+  uint8_t capabilities_ = 0;
+  /// Offset of each supported capability interface from the peripheral
+  std::array<int16_t, static_cast<size_t>(Capability::kCount)>
+      capability_offsets_{};
 };
 
 }  // namespace peripheral
@@ -7,6 +7,14 @@ PeripheralController::PeripheralController(
     Server& server, peripheral::PeripheralFactory& peripheral_factory)
     : server_(server), peripheral_factory_(peripheral_factory) {}
 
+PeripheralController::~PeripheralController() {
+  // Peripherals may use other peripherals, which release their slots while
+  // being destructed. Destruct them while the slots still exist
+  for (auto& slot : slots_) {
+    slot.peripheral.reset();
+  }
+}
+
 const String& PeripheralController::type() {
   static const String name{"PeripheralController"};
   return name;
@@ -20,7 +28,9 @@ void PeripheralController::handleCallback(const JsonObjectConst& message) {
   }
 
   // Init the result doc with type and the request ID
-  DynamicJsonDocument result_doc(BB_JSON_PAYLOAD_SIZE);
+  auto result_doc_lease =
+      utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& result_doc = *result_doc_lease;
   result_doc[Server::type_key_] = Server::result_type_;
   JsonVariantConst request_id = message[Server::request_id_key_];
   if (request_id) {
@@ -57,11 +67,17 @@ void PeripheralController::handleCallback(const JsonObjectConst& message) {
   server_.sendResults(result_doc.as<JsonObject>());
 }
 
+void PeripheralController::addFilterKeys(JsonObject filter) {
+  // The parameters of the commands depend on the peripheral type
+  filter[peripheral_command_key_] = true;
+  filter[Server::request_id_key_] = true;
+}
+
 std::vector<utils::UUID> PeripheralController::getPeripheralIDs() {
   std::vector<utils::UUID> uuids;
-  uuids.reserve(peripherals_.size());
-  for(const auto& peripheral : peripherals_) {
-    uuids.push_back(peripheral.first);
+  uuids.reserve(index_.size());
+  for (const auto& entry : index_) {
+    uuids.push_back(entry.uuid);
   }
   return uuids;
 }
@@ -73,12 +89,13 @@ ErrorResult PeripheralController::add(const JsonObjectConst& doc) {
   }
 
   // Check if element is present
-  if (peripherals_.count(uuid) > 0) {
+  auto entry = findIndexEntry(uuid);
+  if (entry != index_.end() && entry->uuid == uuid) {
     return ErrorResult(type(), F("This peripheral has already been added"));
   }
 
   // Not present, so try to create a new instance
-  std::shared_ptr<peripheral::Peripheral> peripheral(
+  std::unique_ptr<peripheral::Peripheral> peripheral(
       peripheral_factory_.createPeripheral(doc));
   if (peripheral) {
     if (!peripheral->isValid()) {
@@ -88,7 +105,20 @@ ErrorResult PeripheralController::add(const JsonObjectConst& doc) {
     return ErrorResult(type(), F("Error calling peripheral factory"));
   }
 
-  peripherals_.emplace(uuid, peripheral);
+  // Reuse the slot of a removed peripheral to keep the slots compact
+  uint16_t slot;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else if (slots_.size() < PeripheralHandle::invalid_index) {
+    slot = slots_.size();
+    slots_.emplace_back();
+  } else {
+    return ErrorResult(type(), F("Too many peripherals"));
+  }
+  slots_[slot].peripheral = std::move(peripheral);
+
+  index_.insert(entry, IndexEntry{uuid, slot});
 
   return ErrorResult();
 }
@@ -99,25 +129,61 @@ ErrorResult PeripheralController::remove(const JsonObjectConst& doc) {
     return ErrorResult(type(), uuid_key_error_);
   }
 
-  auto iterator = peripherals_.find(uuid);
-  if (iterator != peripherals_.end()) {
-    if (iterator->second.use_count() > 1) {
+  auto entry = findIndexEntry(uuid);
+  if (entry != index_.end() && entry->uuid == uuid) {
+    const uint16_t slot = entry->slot;
+    if (slots_[slot].users > 0) {
       return ErrorResult(type(), String(F("Peripheral still in use")));
     }
-    peripherals_.erase(iterator);
+    index_.erase(entry);
+
+    // Invalidate the handles before the destruction releases other slots
+    std::unique_ptr<Peripheral> peripheral = std::move(slots_[slot].peripheral);
+    slots_[slot].generation++;
+    free_slots_.push_back(slot);
   }
 
   return ErrorResult();
 }
 
-std::shared_ptr<peripheral::Peripheral> PeripheralController::getPeripheral(
+PeripheralRef<Peripheral> PeripheralController::getPeripheral(
     const utils::UUID& uuid) {
-  auto peripheral = peripherals_.find(uuid);
-  if (peripheral != peripherals_.end()) {
-    return peripheral->second;
-  } else {
-    return std::shared_ptr<peripheral::Peripheral>();
+  auto entry = findIndexEntry(uuid);
+  if (entry == index_.end() || entry->uuid != uuid) {
+    return nullptr;
   }
+
+  const uint16_t slot = entry->slot;
+  return PeripheralRef<Peripheral>(
+      PeripheralUse(*this, PeripheralHandle(slot, slots_[slot].generation)),
+      slots_[slot].peripheral.get());
+}
+
+PeripheralRef<Peripheral> PeripheralController::getPeripheral(
+    PeripheralHandle handle) {
+  if (handle.index >= slots_.size()) {
+    return nullptr;
+  }
+
+  const Slot& slot = slots_[handle.index];
+  if (slot.generation != handle.generation || !slot.peripheral) {
+    return nullptr;
+  }
+  return PeripheralRef<Peripheral>(PeripheralUse(*this, handle),
+                                   slot.peripheral.get());
+}
+
+void PeripheralController::acquire(uint16_t index) { slots_[index].users++; }
+
+void PeripheralController::release(uint16_t index) { slots_[index].users--; }
+
+std::vector<PeripheralController::IndexEntry>::iterator
+PeripheralController::findIndexEntry(const utils::UUID& uuid) {
+  return std::lower_bound(
+      index_.begin(), index_.end(), uuid,
+      [](const IndexEntry& entry, const utils::UUID& uuid) {
+        return entry.uuid < uuid;
+      });
 }
 
 void PeripheralController::addResultEntry(const JsonVariantConst& uuid,
@@ -3,27 +3,46 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 
-#include <map>
+#include <algorithm>
 #include <memory>
+#include <vector>
 
-#include "managers/io_types.h"
+#include "managers/error_result.h"
 #include "managers/server.h"
 #include "peripheral/invalid_peripheral.h"
 #include "peripheral/peripheral.h"
 #include "peripheral/peripheral_factory.h"
+#include "peripheral/peripheral_ref.h"
+#include "utils/json_document_pool.h"
 #include "utils/uuid.h"
 
 namespace bernd_box {
 namespace peripheral {
 
+/**
+ * Registry of the peripherals
+ *
+ * The peripherals are owned by slots of a contiguous array and found by their
+ * UUID with a binary search over a sorted index. Users of a peripheral hold a
+ * PeripheralRef, which prevents its removal, or a PeripheralHandle, which
+ * stops resolving after its removal.
+ */
 class PeripheralController {
  public:
   PeripheralController(Server& server, PeripheralFactory& peripheral_factory);
+  ~PeripheralController();
 
   static const String& type();
   
   void handleCallback(const JsonObjectConst& message);
 
+  /**
+   * Adds the keys of the messages read by handleCallback() to a filter
+   *
+   * \param filter The filter of a MessageParser
+   */
+  static void addFilterKeys(JsonObject filter);
+
   /**
    * Returns a list of all peripherals' IDs
    * 
@@ -32,14 +51,35 @@ class PeripheralController {
   std::vector<utils::UUID> getPeripheralIDs();
 
   /**
-   * Returns a shared pointer to the object or a nullptr if not found
+   * Returns a reference to the peripheral or an empty one if not found
+   *
+   * @param uuid UUID of the peripheral to be found
+   * @return A reference to the peripheral, empty if it does not exist
+   */
+  PeripheralRef<Peripheral> getPeripheral(const utils::UUID& uuid);
+
+  /**
+   * Resolves a handle to the peripheral if it was not removed since
    *
-   * @param name Name of the peripheral to be found
-   * @return A shared pointer of the object, or a nullptr if it does not exist
+   * \param handle The handle of a reference to the peripheral
+   * \return A reference to the peripheral, empty if it was removed
    */
-  std::shared_ptr<Peripheral> getPeripheral(const utils::UUID& name);
+  PeripheralRef<Peripheral> getPeripheral(PeripheralHandle handle);
 
  private:
+  struct Slot {
+    std::unique_ptr<Peripheral> peripheral;
+    /// Incremented when the peripheral is removed to invalidate its handles
+    uint16_t generation = 0;
+    /// Number of PeripheralUses of the peripheral
+    uint16_t users = 0;
+  };
+
+  struct IndexEntry {
+    utils::UUID uuid;
+    uint16_t slot;
+  };
+
   /**
    * Create a new peripheral according to the JSON doc
    *
@@ -56,14 +96,26 @@ class PeripheralController {
    */
   ErrorResult remove(const JsonObjectConst& doc);
 
+  /// Registers and unregisters the use of a slot by a PeripheralUse
+  friend class PeripheralUse;
+  void acquire(uint16_t index);
+  void release(uint16_t index);
+
+  /// Position of the UUID in the index or where it would be inserted
+  std::vector<IndexEntry>::iterator findIndexEntry(const utils::UUID& uuid);
+
   static void addResultEntry(const JsonVariantConst& uuid,
                              const ErrorResult& error,
                              const JsonArray& results);
 
   /// The server to which to reply to
   Server& server_;
-  /// Map of UUIDs to their respective peripherals
-  std::map<utils::UUID, std::shared_ptr<Peripheral>> peripherals_;
+  /// The peripherals, indexed by the handles
+  std::vector<Slot> slots_;
+  /// Slots whose peripherals were removed, to be reused
+  std::vector<uint16_t> free_slots_;
+  /// Slot of each peripheral, sorted by the UUIDs
+  std::vector<IndexEntry> index_;
   /// Factory to construct peripherals according to the JSON parameters
   PeripheralFactory& peripheral_factory_;
 
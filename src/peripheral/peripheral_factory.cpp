@@ -5,44 +5,30 @@ namespace peripheral {
 
 PeripheralFactory::PeripheralFactory(Server& server) : server_(server) {}
 
-bool PeripheralFactory::registerFactory(const String& name, Callback factory) {
-  if (getFactories().count(name) == 0) {
-    getFactories().emplace(name, factory);
-    return true;
-  }
-  return false;
-}
-
-std::shared_ptr<Peripheral> PeripheralFactory::createPeripheral(
+std::unique_ptr<Peripheral> PeripheralFactory::createPeripheral(
     const JsonObjectConst& parameter) {
   const JsonVariantConst type = parameter[type_key_];
   if (type.isNull() || !type.is<char*>()) {
-    return std::make_shared<InvalidPeripheral>(type_key_error_);
+    return std::unique_ptr<Peripheral>(new InvalidPeripheral(type_key_error_));
   }
 
-  auto factory = getFactories().find(type);
-  if (factory != getFactories().end()) {
-    return factory->second(parameter);
+  const Entry* entry = types_.find(type.as<const char*>());
+  if (entry) {
+    return entry->factory(parameter);
   } else {
-    return std::make_shared<InvalidPeripheral>(
-        unknownTypeError(type.as<char*>()));
+    return std::unique_ptr<Peripheral>(new InvalidPeripheral(
+        unknownTypeError(type.as<char*>())));
   }
 }
 
 std::vector<String> PeripheralFactory::getFactoryNames() {
   std::vector<String> names;
-  for (const auto& factory : getFactories()) {
-    names.push_back(factory.first);
+  for (const Entry& entry : types_) {
+    names.push_back(entry.name);
   }
   return names;
 }
 
-std::map<const String, PeripheralFactory::Callback>&
-PeripheralFactory::getFactories() {
-  static std::map<const String, Callback> factories;
-  return factories;
-}
-
 String PeripheralFactory::unknownTypeError(const String& type) {
   String error(F("Unknown peripheral type: "));
   error += type;
@@ -3,13 +3,13 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 
-#include <map>
 #include <memory>
 #include <vector>
 
 #include "managers/server.h"
 #include "peripheral/invalid_peripheral.h"
 #include "peripheral/peripheral.h"
+#include "utils/type_table.h"
 
 namespace bernd_box {
 namespace peripheral {
@@ -17,23 +17,33 @@ namespace peripheral {
 class PeripheralFactory {
  public:
   using Callback =
-      std::shared_ptr<Peripheral> (*)(const JsonObjectConst& parameter);
+      std::unique_ptr<Peripheral> (*)(const JsonObjectConst& parameter);
+
+  /// A peripheral type as listed in the type table
+  struct Entry {
+    const char* name;
+    Callback factory;
+  };
 
   PeripheralFactory(Server& server);
   virtual ~PeripheralFactory() = default;
 
-  static bool registerFactory(const String& name, Callback factory);
-
-  std::shared_ptr<Peripheral> createPeripheral(
+  std::unique_ptr<Peripheral> createPeripheral(
       const JsonObjectConst& parameter);
 
   std::vector<String> getFactoryNames();
 
  private:
-  static std::map<const String, Callback>& getFactories();
-
   static String unknownTypeError(const String& type);
 
+  /**
+   * The known peripheral types
+   *
+   * Defined in a single translation unit per build, which lists the types of
+   * the build. See peripheral_types.cpp
+   */
+  static const utils::TypeTable<Entry> types_;
+
   Server& server_;
 
   static const __FlashStringHelper* type_key_;
@@ -41,4 +51,4 @@ class PeripheralFactory {
 };
 
 }  // namespace peripheral
-}  // namespace bernd_box
\ No newline at end of file
+}  // namespace bernd_box
@@ -0,0 +1,43 @@
+#include "peripheral_ref.h"
+
+#include "peripheral/peripheral_controller.h"
+
+namespace bernd_box {
+namespace peripheral {
+
+PeripheralUse::PeripheralUse(PeripheralController& controller,
+                             PeripheralHandle handle)
+    : controller_(&controller), handle_(handle) {
+  controller_->acquire(handle_.index);
+}
+
+PeripheralUse::PeripheralUse(const PeripheralUse& other)
+    : controller_(other.controller_), handle_(other.handle_) {
+  if (controller_) {
+    controller_->acquire(handle_.index);
+  }
+}
+
+PeripheralUse::PeripheralUse(PeripheralUse&& other)
+    : controller_(other.controller_), handle_(other.handle_) {
+  other.controller_ = nullptr;
+  other.handle_ = PeripheralHandle();
+}
+
+PeripheralUse::~PeripheralUse() {
+  if (controller_) {
+    controller_->release(handle_.index);
+  }
+}
+
+constexpr uint16_t PeripheralHandle::invalid_index;
+
+PeripheralHandle PeripheralUse::getHandle() const { return handle_; }
+
+void PeripheralUse::swap(PeripheralUse& other) {
+  std::swap(controller_, other.controller_);
+  std::swap(handle_, other.handle_);
+}
+
+}  // namespace peripheral
+}  // namespace bernd_box
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "peripheral/peripheral.h"
+
+namespace bernd_box {
+namespace peripheral {
+
+class PeripheralController;
+
+/**
+ * Compact weak reference to a peripheral of the PeripheralController
+ *
+ * Refers to the peripheral's slot in the registry. The slot's generation is
+ * incremented when its peripheral is removed, so that the handle no longer
+ * resolves even if the slot is reused by another peripheral.
+ */
+struct PeripheralHandle {
+  static constexpr uint16_t invalid_index = 0xFFFF;
+
+  PeripheralHandle() = default;
+  PeripheralHandle(uint16_t index, uint16_t generation)
+      : index(index), generation(generation) {}
+
+  uint16_t index = invalid_index;
+  uint16_t generation = 0;
+
+  bool isValid() const { return index != invalid_index; }
+};
+
+/**
+ * Registers a use of a peripheral slot for as long as it lives
+ *
+ * The PeripheralController refuses to remove a peripheral which is in use.
+ * The count is kept in the slot instead of a separate control block and is
+ * not atomic, since peripherals are only used from the scheduler's thread.
+ */
+class PeripheralUse {
+ public:
+  PeripheralUse() = default;
+  PeripheralUse(const PeripheralUse& other);
+  PeripheralUse(PeripheralUse&& other);
+  ~PeripheralUse();
+
+  PeripheralUse& operator=(const PeripheralUse& other) = delete;
+
+  /// The handle of the used peripheral, invalid if empty
+  PeripheralHandle getHandle() const;
+
+ protected:
+  void swap(PeripheralUse& other);
+
+ private:
+  friend class PeripheralController;
+
+  /// Registers a use of a live slot. Only created by the controller
+  PeripheralUse(PeripheralController& controller, PeripheralHandle handle);
+
+  PeripheralController* controller_ = nullptr;
+  PeripheralHandle handle_;
+};
+
+/**
+ * Counted reference to a peripheral or one of its capability interfaces
+ *
+ * Replaces std::shared_ptr for peripherals. The registry keeps the ownership,
+ * while the reference prevents the removal of the peripheral.
+ *
+ * \tparam T Peripheral or a capability interface
+ */
+template <typename T>
+class PeripheralRef : public PeripheralUse {
+ public:
+  PeripheralRef() = default;
+  PeripheralRef(std::nullptr_t) {}
+
+  /**
+   * Shares the use of another reference but points to a different object
+   *
+   * \param use The use of the peripheral
+   * \param pointer An object owned by the peripheral, e.g. a capability
+   */
+  PeripheralRef(const PeripheralUse& use, T* pointer)
+      : PeripheralUse(use), pointer_(pointer) {}
+
+  PeripheralRef(const PeripheralRef& other) = default;
+  PeripheralRef(PeripheralRef&& other)
+      : PeripheralUse(std::move(other)), pointer_(other.pointer_) {
+    other.pointer_ = nullptr;
+  }
+
+  PeripheralRef& operator=(PeripheralRef other) {
+    swap(other);
+    std::swap(pointer_, other.pointer_);
+    return *this;
+  }
+
+  T* get() const { return pointer_; }
+  T* operator->() const { return pointer_; }
+  T& operator*() const { return *pointer_; }
+  explicit operator bool() const { return pointer_ != nullptr; }
+
+ private:
+  T* pointer_ = nullptr;
+};
+
+/**
+ * Gets a capability interface of a peripheral sharing its use
+ *
+ * \tparam T The capability interface, e.g. capabilities::GetValues
+ * \param peripheral The peripheral, may be empty
+ * \return The interface or an empty reference if the capability is not
+ *         supported
+ */
+template <typename T>
+PeripheralRef<T> capabilityCast(const PeripheralRef<Peripheral>& peripheral) {
+  if (!peripheral) {
+    return nullptr;
+  }
+  T* capability = peripheral->template getCapability<T>();
+  if (!capability) {
+    return nullptr;
+  }
+  return PeripheralRef<T>(peripheral, capability);
+}
+
+}  // namespace peripheral
+}  // namespace bernd_box
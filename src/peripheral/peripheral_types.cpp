@@ -0,0 +1,43 @@
+#include "peripheral_types.h"
+
+namespace bernd_box {
+namespace peripheral {
+namespace {
+
+/// To add a peripheral type, list it here
+constexpr PeripheralFactory::Entry peripheral_types[] = {
+    {InvalidPeripheral::type_name_, InvalidPeripheral::factory},
+    {peripherals::analog_in::AnalogIn::type_name_,
+     peripherals::analog_in::AnalogIn::factory},
+    {peripherals::analog_out::AnalogOut::type_name_,
+     peripherals::analog_out::AnalogOut::factory},
+    {peripherals::as_ec_meter::AsEcMeterI2C::type_name_,
+     peripherals::as_ec_meter::AsEcMeterI2C::factory},
+    {peripherals::bme280::BME280::type_name_,
+     peripherals::bme280::BME280::factory},
+    {peripherals::capacative_sensor::CapacitiveSensor::type_name_,
+     peripherals::capacative_sensor::CapacitiveSensor::factory},
+    {peripherals::digital_in::DigitalIn::type_name_,
+     peripherals::digital_in::DigitalIn::factory},
+    {peripherals::digital_out::DigitalOut::type_name_,
+     peripherals::digital_out::DigitalOut::factory},
+    {peripherals::dummy::DummyPeripheral::type_name_,
+     peripherals::dummy::DummyPeripheral::factory},
+    {peripherals::util::I2CAdapter::type_name_,
+     peripherals::util::I2CAdapter::factory},
+    {peripherals::neo_pixel::NeoPixel::type_name_,
+     peripherals::neo_pixel::NeoPixel::factory},
+    {peripherals::pwm::Pwm::type_name_, peripherals::pwm::Pwm::factory},
+};
+
+constexpr auto peripheral_types_hash = utils::makePerfectHash(peripheral_types);
+static_assert(peripheral_types_hash.isValid(),
+              "The names of the peripheral types are not unique");
+
+}  // namespace
+
+const utils::TypeTable<PeripheralFactory::Entry> PeripheralFactory::types_{
+    peripheral_types, peripheral_types_hash};
+
+}  // namespace peripheral
+}  // namespace bernd_box
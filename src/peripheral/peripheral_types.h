@@ -0,0 +1,22 @@
+#pragma once
+
+/**
+ * The peripheral types of the firmware
+ *
+ * Includes all peripherals listed in the PeripheralFactory's type table.
+ */
+
+#include "peripheral/invalid_peripheral.h"
+#include "peripheral/peripheral_factory.h"
+#include "peripheral/peripherals/analog_in/analog_in.h"
+#include "peripheral/peripherals/analog_out/analog_out.h"
+#include "peripheral/peripherals/as_ec_meter/as_ec_meter.h"
+#include "peripheral/peripherals/bme280/bme280.h"
+#include "peripheral/peripherals/capacitive_sensor/capacitive_sensor.h"
+#include "peripheral/peripherals/digital_in/digital_in.h"
+#include "peripheral/peripherals/digital_out/digital_out.h"
+#include "peripheral/peripherals/dummy/dummy_peripheral.h"
+#include "peripheral/peripherals/i2c_adapter/i2c_adapter.h"
+#include "peripheral/peripherals/neo_pixel/neo_pixel.h"
+#include "peripheral/peripherals/pwm/pwm.h"
+#include "utils/type_table.h"
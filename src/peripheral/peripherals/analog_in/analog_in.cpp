@@ -5,7 +5,11 @@ namespace peripheral {
 namespace peripherals {
 namespace analog_in {
 
-AnalogIn::AnalogIn(const JsonObjectConst& parameters) {
+AnalogIn::AnalogIn(const JsonObjectConst& parameters)
+    : adc_engine_(Services::getAdcEngine()) {
+  addCapability<capabilities::GetValues>(this);
+  addCapability<capabilities::StartMeasurement>(this);
+
   // Get the pin # for the GPIO output and validate data. Invalidate on error
   JsonVariantConst pin = parameters[pin_key_];
   if (!pin.is<unsigned int>()) {
@@ -30,21 +34,114 @@ AnalogIn::AnalogIn(const JsonObjectConst& parameters) {
     setInvalid(data_point_type_key_error_);
     return;
   }
+
+  // Optionally set the number of samples averaged per reading
+  JsonVariantConst average_samples = parameters[average_samples_key_];
+  if (!average_samples.isNull()) {
+    if (!average_samples.is<unsigned int>() ||
+        average_samples.as<unsigned int>() == 0 ||
+        average_samples.as<unsigned int>() > adc_buffer_size) {
+      setInvalid(average_samples_key_error_);
+      return;
+    }
+    average_samples_ = average_samples;
+  }
+
+  // Optionally filter the samples instead of averaging them
+  JsonVariantConst filter = parameters[utils::ValueFilter::filter_key_];
+  if (!filter.isNull()) {
+    filter_ = utils::ValueFilter::makeFilter(filter);
+    if (!filter_) {
+      setInvalid(utils::ValueFilter::filter_key_error_);
+      return;
+    }
+    raw_samples_.resize(adc_buffer_size);
+  }
+
+  // Optionally set the attenuation and characterize the ADC for it
+  JsonVariantConst attenuation = parameters[attenuation_key_];
+  if (!attenuation.isNull()) {
+    if (!getAttenuation(attenuation, attenuation_)) {
+      setInvalid(attenuation_key_error_);
+      return;
+    }
+  }
+  calibration_ = adc::AdcCalibration(attenuation_, adc_default_vref_mv);
+
+  // Optionally correct the voltages with a table measured against a
+  // reference
+  JsonVariantConst correction = parameters[correction_key_];
+  if (!correction.isNull()) {
+    if (!getCorrection(correction, correction_)) {
+      setInvalid(correction_key_error_);
+      return;
+    }
+  }
+
+  // Start sampling the pin in the background
+  is_channel_added_ = adc_engine_.addChannel(pin_, attenuation_);
+  if (!is_channel_added_) {
+    setInvalid(adc_channel_error_);
+    return;
+  }
+}
+
+AnalogIn::~AnalogIn() {
+  if (is_channel_added_) {
+    adc_engine_.removeChannel(pin_);
+  }
 }
 
 const String& AnalogIn::getType() const { return type(); }
 
 const String& AnalogIn::type() {
-  static const String name{"AnalogIn"};
+  static const String name{type_name_};
   return name;
 }
 
+capabilities::StartMeasurement::Result AnalogIn::startMeasurement(
+    const JsonVariantConst& parameters) {
+  measurement_start_ = std::chrono::steady_clock::now();
+  return handleMeasurement();
+}
+
+capabilities::StartMeasurement::Result AnalogIn::handleMeasurement() {
+  // Take the samples the source delivered since the engine's last drain
+  if (!has_samples_) {
+    adc_engine_.handle();
+    float value;
+    has_samples_ = readRawValue(value);
+  }
+  if (has_samples_) {
+    return {.wait = {}, .error = ErrorResult()};
+  }
+
+  if (std::chrono::steady_clock::now() - measurement_start_ >
+      samples_timeout_) {
+    return {.wait = {}, .error = ErrorResult(type(), samples_not_ready_error_)};
+  }
+
+  // Check again once the engine drained the source
+  return {.wait = adc_drain_interval, .error = ErrorResult()};
+}
+
 capabilities::GetValues::Result AnalogIn::getValues() {
   std::vector<utils::ValueUnit> values;
-  const uint16_t value = analogRead(pin_);
+
+  // A newly added pin has no samples until the source delivered them. Don't
+  // wait for them, as that would stall the scheduler. Tasks wait for them by
+  // starting a measurement
+  float value;
+  if (!readRawValue(value)) {
+    adc_engine_.handle();
+    if (!readRawValue(value)) {
+      return {.values = values,
+              .error = ErrorResult(type(), samples_not_ready_error_)};
+    }
+  }
 
   if (voltage_data_point_type_.isValid()) {
-    const float voltage = value * 3.3 / 4096.0;
+    const float voltage = correction_.evaluate(calibration_.toVolts(value));
     values.push_back({utils::ValueUnit{
         .value = voltage, .data_point_type = voltage_data_point_type_}});
   }
@@ -57,16 +154,75 @@ capabilities::GetValues::Result AnalogIn::getValues() {
   return {.values = values, .error = ErrorResult()};
 }
 
-std::shared_ptr<Peripheral> AnalogIn::factory(
-    const JsonObjectConst& parameters) {
-  return std::make_shared<AnalogIn>(parameters);
+bool AnalogIn::readRawValue(float& value) {
+  if (!filter_) {
+    return adc_engine_.getAverage(pin_, average_samples_, value);
+  }
+
+  // Stream all samples since the last reading through the filter
+  size_t count;
+  do {
+    count = adc_engine_.read(pin_, cursor_, raw_samples_.data(),
+                             raw_samples_.size());
+    for (size_t i = 0; i < count; i++) {
+      filtered_value_ = filter_->add(raw_samples_[i]);
+    }
+  } while (count == raw_samples_.size());
+
+  value = filtered_value_;
+  return !std::isnan(value);
+}
+
+bool AnalogIn::getAttenuation(const JsonVariantConst& attenuation_db,
+                              adc::Attenuation& attenuation) {
+  if (!attenuation_db.is<float>()) {
+    return false;
+  }
+
+  const float value = attenuation_db.as<float>();
+  if (value == 0) {
+    attenuation = adc::Attenuation::k0dB;
+  } else if (value == 2.5) {
+    attenuation = adc::Attenuation::k2_5dB;
+  } else if (value == 6) {
+    attenuation = adc::Attenuation::k6dB;
+  } else if (value == 11) {
+    attenuation = adc::Attenuation::k11dB;
+  } else {
+    return false;
+  }
+  return true;
 }
 
-bool AnalogIn::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
+bool AnalogIn::getCorrection(const JsonVariantConst& correction,
+                             utils::PiecewiseLinear& table) {
+  JsonArrayConst points_array = correction.as<JsonArrayConst>();
+  if (!points_array || points_array.size() > max_correction_points_) {
+    return false;
+  }
 
-bool AnalogIn::capability_get_values_ =
-    capabilities::GetValues::registerType(type());
+  std::vector<utils::PiecewiseLinear::Point> points;
+  points.reserve(points_array.size());
+  for (JsonVariantConst point : points_array) {
+    JsonArrayConst pair = point.as<JsonArrayConst>();
+    if (!pair || pair.size() != 2 || !pair[0].is<float>() ||
+        !pair[1].is<float>()) {
+      return false;
+    }
+    points.push_back({pair[0].as<float>(), pair[1].as<float>()});
+  }
+
+  if (!utils::PiecewiseLinear::isValid(points)) {
+    return false;
+  }
+  table = utils::PiecewiseLinear(std::move(points));
+  return true;
+}
+
+std::unique_ptr<Peripheral> AnalogIn::factory(
+    const JsonObjectConst& parameters) {
+  return std::unique_ptr<Peripheral>(new AnalogIn(parameters));
+}
 
 const std::array<uint8_t, 8> AnalogIn::valid_pins_ = {
     32, 33, 34, 35, 36, 37, 38, 39,
@@ -77,6 +233,25 @@ const __FlashStringHelper* AnalogIn::pin_key_error_ =
 const __FlashStringHelper* AnalogIn::invalid_pin_error_ =
     F("Pin # not valid (only ADC1: 32 - 39)");
 
+const __FlashStringHelper* AnalogIn::adc_channel_error_ =
+    F("Failed to start sampling the pin (in use with another attenuation?)");
+const __FlashStringHelper* AnalogIn::average_samples_key_ =
+    F("average_samples");
+const __FlashStringHelper* AnalogIn::average_samples_key_error_ =
+    F("Invalid property: average_samples (unsigned int, up to the ADC buffer "
+      "size)");
+const __FlashStringHelper* AnalogIn::attenuation_key_ = F("attenuation");
+const __FlashStringHelper* AnalogIn::attenuation_key_error_ =
+    F("Invalid property: attenuation (0, 2.5, 6 or 11 dB)");
+const __FlashStringHelper* AnalogIn::correction_key_ = F("correction");
+const __FlashStringHelper* AnalogIn::correction_key_error_ =
+    F("Invalid property: correction (array of 2 to 32 [measured, actual] "
+      "voltages with increasing measured voltages)");
+const size_t AnalogIn::max_correction_points_ = 32;
+const std::chrono::milliseconds AnalogIn::samples_timeout_{1000};
+const __FlashStringHelper* AnalogIn::samples_not_ready_error_ =
+    F("No ADC samples of the pin yet, try again later");
+
 const __FlashStringHelper* AnalogIn::voltage_data_point_type_key_ =
     F("voltage_data_point_type");
 const __FlashStringHelper* AnalogIn::percent_data_point_type_key_ =
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include <ArduinoJson.h>
 
 #include "managers/services.h"
+#include "peripheral/adc/adc_calibration.h"
 #include "peripheral/capabilities/get_values.h"
+#include "peripheral/capabilities/start_measurement.h"
 #include "peripheral/peripheral.h"
+#include "utils/filter.h"
+#include "utils/piecewise_linear.h"
+#include "utils/value_filter.h"
 
 namespace bernd_box {
 namespace peripheral {
@@ -14,36 +20,135 @@ namespace peripherals {
 namespace analog_in {
 
 /**
- * Peripheral to control a GPIO output
+ * Peripheral to read an analog input
+ *
+ * The pin is sampled in the background by the ADC engine. A reading is the
+ * average of the newest samples. If the optional "filter" property is set,
+ * all samples of the pin are streamed through the filter instead, and a
+ * reading is its newest output (see utils::ValueFilter for the format).
+ *
+ * The voltage is converted with the ADC's characterization for the pin's
+ * attenuation, and optionally corrected by a table of measured and actual
+ * voltages which is interpolated piecewise linearly.
+ *
+ * A newly added pin has no samples until the source delivered them. Starting
+ * a measurement waits for them, so that tasks don't read the pin too early.
  */
-class AnalogIn : public Peripheral, public capabilities::GetValues {
+class AnalogIn : public Peripheral,
+                 public capabilities::GetValues,
+                 public capabilities::StartMeasurement {
  public:
   AnalogIn(const JsonObjectConst& parameters);
-  virtual ~AnalogIn() = default;
+  virtual ~AnalogIn();
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "AnalogIn";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameter);
 
   /**
-   * Get the GPIO state
+   * Wait for the first samples of the pin
    *
-   * \return The value 1 represents the high state, 0 its low state
+   * The pin is sampled continuously, so there is nothing else to start.
+   *
+   * \param parameters No parameters required
+   * \return The time until the first samples are expected
+   */
+  capabilities::StartMeasurement::Result startMeasurement(
+      const JsonVariantConst& parameters) final;
+
+  /**
+   * Check if the pin has samples
+   *
+   * \return The time to wait, or an error if no samples arrived in time
+   */
+  capabilities::StartMeasurement::Result handleMeasurement() final;
+
+  /**
+   * Get the average of the newest samples as voltage and / or percent
+   *
+   * Doesn't wait for the first samples if the pin was only just added. Start
+   * a measurement to wait for them.
+   *
+   * \return The voltage and / or percent, or an error if there are no samples
    */
   capabilities::GetValues::Result getValues() final;
 
  private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameter);
-  static bool registered_;
-  static bool capability_get_values_;
+  /**
+   * Gets the raw value of a reading
+   *
+   * \param value The average of the newest samples or the filter's output
+   * \return False if there are no samples yet
+   */
+  bool readRawValue(float& value);
 
-  /// The pin to be used as a GPIO output
+  /// The pin to be used as an analog input
   unsigned int pin_;
   static const std::array<uint8_t, 8> valid_pins_;
   static const __FlashStringHelper* pin_key_;
   static const __FlashStringHelper* pin_key_error_;
   static const __FlashStringHelper* invalid_pin_error_;
 
+  /**
+   * Gets the attenuation from its value in dB
+   *
+   * \param attenuation_db The attenuation in dB: 0, 2.5, 6 or 11
+   * \param attenuation The attenuation of the ADC
+   * \return False if the value is not a supported attenuation
+   */
+  static bool getAttenuation(const JsonVariantConst& attenuation_db,
+                             adc::Attenuation& attenuation);
+
+  /**
+   * Gets the correction table from an array of [measured, actual] voltages
+   *
+   * \param correction The array, ordered by increasing measured voltages
+   * \param table The correction table
+   * \return False if the array is not a valid correction table
+   */
+  static bool getCorrection(const JsonVariantConst& correction,
+                            utils::PiecewiseLinear& table);
+
+  /// The ADC engine sampling the pin
+  adc::AdcEngine& adc_engine_;
+  /// Whether the pin was added to the ADC engine
+  bool is_channel_added_ = false;
+  static const __FlashStringHelper* adc_channel_error_;
+  /// How many samples are averaged for a reading
+  size_t average_samples_ = adc_default_average_samples;
+  static const __FlashStringHelper* average_samples_key_;
+  static const __FlashStringHelper* average_samples_key_error_;
+  /// Optional filter the raw samples are streamed through
+  std::unique_ptr<utils::Filter> filter_;
+  /// The newest output of the filter
+  float filtered_value_ = NAN;
+  /// Position of the filter in the sample stream of the pin
+  uint32_t cursor_ = 0;
+  /// Preallocated buffer to read the samples of the pin into
+  std::vector<uint16_t> raw_samples_;
+  /// The attenuation sets the voltage range of the pin [default: 11 dB]
+  adc::Attenuation attenuation_ = adc::Attenuation::k11dB;
+  static const __FlashStringHelper* attenuation_key_;
+  static const __FlashStringHelper* attenuation_key_error_;
+  /// Converts the raw values to voltages
+  adc::AdcCalibration calibration_{attenuation_, adc_default_vref_mv};
+  /// Optional correction of the converted voltages
+  utils::PiecewiseLinear correction_;
+  static const __FlashStringHelper* correction_key_;
+  static const __FlashStringHelper* correction_key_error_;
+  static const size_t max_correction_points_;
+  /// Set once the source delivered the first samples of the pin. The samples
+  /// are kept until the pin is removed
+  bool has_samples_ = false;
+  /// When the measurement waiting for the first samples was started
+  std::chrono::steady_clock::time_point measurement_start_;
+  /// How long a measurement waits for the first samples
+  static const std::chrono::milliseconds samples_timeout_;
+  /// Error until the source delivered the first samples of the pin
+  static const __FlashStringHelper* samples_not_ready_error_;
+
   /// Data point type for the reading as voltage
   utils::UUID voltage_data_point_type_{nullptr};
   static const __FlashStringHelper* voltage_data_point_type_key_;
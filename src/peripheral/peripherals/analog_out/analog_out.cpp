@@ -6,6 +6,8 @@ namespace peripherals {
 namespace analog_out {
 
 AnalogOut::AnalogOut(const JsonObjectConst& parameters) {
+  addCapability<capabilities::SetValue>(this);
+
   // Get the pin # for the GPIO output and validate data. Invalidate on error
   JsonVariantConst pin = parameters[pin_key_];
   if (!pin.is<unsigned int>()) {
@@ -35,7 +37,7 @@ AnalogOut::AnalogOut(const JsonObjectConst& parameters) {
 const String& AnalogOut::getType() const { return type(); }
 
 const String& AnalogOut::type() {
-  static const String name{"AnalogOut"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -65,17 +67,11 @@ void AnalogOut::setValue(utils::ValueUnit value_unit) {
   dacWrite(pin_, dac_value);
 }
 
-std::shared_ptr<Peripheral> AnalogOut::factory(
+std::unique_ptr<Peripheral> AnalogOut::factory(
     const JsonObjectConst& parameters) {
-  return std::make_shared<AnalogOut>(parameters);
+  return std::unique_ptr<Peripheral>(new AnalogOut(parameters));
 }
 
-bool AnalogOut::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
-bool AnalogOut::capability_set_value_ =
-    capabilities::SetValue::registerType(type());
-
 const __FlashStringHelper* AnalogOut::pin_key_ = F("pin");
 const __FlashStringHelper* AnalogOut::pin_key_error_ =
     F("Missing property: pin (unsigned int)");
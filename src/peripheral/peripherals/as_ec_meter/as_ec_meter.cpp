@@ -7,6 +7,10 @@ namespace as_ec_meter {
 
 AsEcMeterI2C::AsEcMeterI2C(const JsonObjectConst& parameters)
     : I2CAbstractPeripheral(parameters), Ezo_board(0) {
+  addCapability<capabilities::GetValues>(this);
+  addCapability<capabilities::StartMeasurement>(this);
+  addCapability<capabilities::Calibrate>(this);
+
   // If the base class constructor failed, abort the constructor
   if (!isValid()) {
     return;
@@ -52,7 +56,7 @@ AsEcMeterI2C::AsEcMeterI2C(const JsonObjectConst& parameters)
 const String& AsEcMeterI2C::getType() const { return type(); }
 
 const String& AsEcMeterI2C::type() {
-  static const String name{"AsEcMeterI2C"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -420,17 +424,11 @@ bool AsEcMeterI2C::isReadingStable() const {
   }
 }
 
-std::shared_ptr<Peripheral> AsEcMeterI2C::factory(
+std::unique_ptr<Peripheral> AsEcMeterI2C::factory(
     const JsonObjectConst& parameters) {
-  return std::make_shared<AsEcMeterI2C>(parameters);
+  return std::unique_ptr<Peripheral>(new AsEcMeterI2C(parameters));
 }
 
-bool AsEcMeterI2C::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
-bool AsEcMeterI2C::capability_get_values_ =
-    capabilities::GetValues::registerType(type());
-
 const __FlashStringHelper* AsEcMeterI2C::probe_type_key_ = F("probe_type");
 
 const __FlashStringHelper* AsEcMeterI2C::probe_type_key_error_ =
@@ -27,7 +27,9 @@ class AsEcMeterI2C : public peripherals::i2c_adapter::I2CAbstractPeripheral,
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "AsEcMeterI2C";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameters);
 
   /**
    * Perform a calibration step on the peripheral
@@ -210,10 +212,6 @@ class AsEcMeterI2C : public peripherals::i2c_adapter::I2CAbstractPeripheral,
    */
   bool isReadingStable() const;
 
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameters);
-  static bool registered_;
-  static bool capability_get_values_;
-
   utils::UUID data_point_type_{nullptr};
 
   static const __FlashStringHelper* probe_type_key_;
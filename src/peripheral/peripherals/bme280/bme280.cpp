@@ -7,6 +7,8 @@ namespace bme280 {
 
 BME280::BME280(const JsonObjectConst& parameters)
     : I2CAbstractPeripheral(parameters) {
+  addCapability<capabilities::GetValues>(this);
+
   // If the base class constructor failed, abort the constructor
   if (!isValid()) {
     return;
@@ -73,7 +75,7 @@ BME280::BME280(const JsonObjectConst& parameters)
 const String& BME280::getType() const { return type(); }
 
 const String& BME280::type() {
-  static const String name{"BME280"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -99,15 +101,10 @@ capabilities::GetValues::Result BME280::getValues() {
   return result;
 }
 
-std::shared_ptr<Peripheral> BME280::factory(const JsonObjectConst& parameters) {
-  return std::make_shared<BME280>(parameters);
+std::unique_ptr<Peripheral> BME280::factory(const JsonObjectConst& parameters) {
+  return std::unique_ptr<Peripheral>(new BME280(parameters));
 }
 
-bool BME280::registered_ = PeripheralFactory::registerFactory(type(), factory);
-
-bool BME280::capability_get_values_ =
-    capabilities::GetValues::registerType(type());
-
 const __FlashStringHelper* BME280::temperature_data_point_type_key_ =
     F("temperature_data_point_type");
 const __FlashStringHelper* BME280::temperature_data_point_type_key_error_ =
@@ -20,7 +20,9 @@ class BME280 : public peripherals::i2c_adapter::I2CAbstractPeripheral,
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "BME280";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameters);
 
   /**
    * Reads all available data points from the BME/P280
@@ -30,10 +32,6 @@ class BME280 : public peripherals::i2c_adapter::I2CAbstractPeripheral,
   capabilities::GetValues::Result getValues() final;
 
  private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameters);
-  static bool registered_;
-  static bool capability_get_values_;
-
   utils::UUID temperature_data_point_type_{nullptr};
   static const __FlashStringHelper* temperature_data_point_type_key_;
   static const __FlashStringHelper* temperature_data_point_type_key_error_;
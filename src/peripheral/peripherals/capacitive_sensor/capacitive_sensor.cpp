@@ -6,6 +6,8 @@ namespace peripherals {
 namespace capacative_sensor {
 
 CapacitiveSensor::CapacitiveSensor(const JsonObjectConst& parameters) {
+  addCapability<capabilities::GetValues>(this);
+
   JsonVariantConst sense_pin = parameters[sense_pin_key_];
   if (!sense_pin.is<unsigned int>()) {
     setInvalid(sense_pin_key_error_);
@@ -24,7 +26,7 @@ CapacitiveSensor::CapacitiveSensor(const JsonObjectConst& parameters) {
 const String& CapacitiveSensor::getType() const { return type(); }
 
 const String& CapacitiveSensor::type() {
-  static const String name{"CapacitiveSensor"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -38,17 +40,11 @@ const __FlashStringHelper* CapacitiveSensor::sense_pin_key_ = F("sense_pin");
 const __FlashStringHelper* CapacitiveSensor::sense_pin_key_error_ =
     F("Missing property: sense_pin (unsigned int)");
 
-std::shared_ptr<Peripheral> CapacitiveSensor::factory(
+std::unique_ptr<Peripheral> CapacitiveSensor::factory(
     const JsonObjectConst& parameters) {
-  return std::make_shared<CapacitiveSensor>(parameters);
+  return std::unique_ptr<Peripheral>(new CapacitiveSensor(parameters));
 }
 
-bool CapacitiveSensor::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
-bool CapacitiveSensor::capability_get_value_ =
-    capabilities::GetValues::registerType(type());
-
 }  // namespace capacative_sensor
 }  // namespace peripherals
 }  // namespace peripheral
@@ -24,7 +24,9 @@ class CapacitiveSensor : public Peripheral, public capabilities::GetValues {
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "CapacitiveSensor";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameters);
 
   /**
    * Read touch pad (values close to 0 mean touch detected)
@@ -34,10 +36,6 @@ class CapacitiveSensor : public Peripheral, public capabilities::GetValues {
   capabilities::GetValues::Result getValues() final;
 
  private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameters);
-  static bool registered_;
-  static bool capability_get_value_;
-
   unsigned int sense_pin_;
   utils::UUID data_point_type_;
 
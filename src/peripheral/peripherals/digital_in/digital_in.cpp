@@ -6,6 +6,8 @@ namespace peripherals {
 namespace digital_in {
 
 DigitalIn::DigitalIn(const JsonObjectConst& parameters) {
+  addCapability<capabilities::GetValues>(this);
+
   // Get the pin # for the GPIO output and validate data. Invalidate on error
   JsonVariantConst pin = parameters[pin_key_];
   if (!pin.is<unsigned int>()) {
@@ -42,7 +44,7 @@ DigitalIn::DigitalIn(const JsonObjectConst& parameters) {
 const String& DigitalIn::getType() const { return type(); }
 
 const String& DigitalIn::type() {
-  static const String name{"DigitalIn"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -52,17 +54,11 @@ capabilities::GetValues::Result DigitalIn::getValues() {
                                .data_point_type = data_point_type_}}};
 }
 
-std::shared_ptr<Peripheral> DigitalIn::factory(
+std::unique_ptr<Peripheral> DigitalIn::factory(
     const JsonObjectConst& parameters) {
-  return std::make_shared<DigitalIn>(parameters);
+  return std::unique_ptr<Peripheral>(new DigitalIn(parameters));
 }
 
-bool DigitalIn::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
-bool DigitalIn::capability_get_values_ =
-    capabilities::GetValues::registerType(type());
-
 const __FlashStringHelper* DigitalIn::pin_key_ = F("pin");
 const __FlashStringHelper* DigitalIn::pin_key_error_ =
     F("Missing property: pin (unsigned int)");
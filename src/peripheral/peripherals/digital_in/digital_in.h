@@ -21,7 +21,9 @@ class DigitalIn : public Peripheral, public capabilities::GetValues {
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "DigitalIn";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameter);
 
   /**
    * Get the GPIO state
@@ -31,10 +33,6 @@ class DigitalIn : public Peripheral, public capabilities::GetValues {
   capabilities::GetValues::Result getValues() final;
 
  private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameter);
-  static bool registered_;
-  static bool capability_get_values_;
-
   /// The pin to be used as a GPIO output
   unsigned int pin_;
   static const __FlashStringHelper* pin_key_;
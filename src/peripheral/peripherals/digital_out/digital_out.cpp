@@ -6,6 +6,8 @@ namespace peripherals {
 namespace digital_out {
 
 DigitalOut::DigitalOut(const JsonObjectConst& parameters) {
+  addCapability<capabilities::SetValue>(this);
+
   // Get the pin # for the GPIO output and validate data. Invalidate on error
   JsonVariantConst pin = parameters[pin_key_];
   if (!pin.is<unsigned int>()) {
@@ -27,7 +29,7 @@ DigitalOut::DigitalOut(const JsonObjectConst& parameters) {
 const String& DigitalOut::getType() const { return type(); }
 
 const String& DigitalOut::type() {
-  static const String name{"DigitalOut"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -49,17 +51,11 @@ const __FlashStringHelper* DigitalOut::pin_key_ = F("pin");
 const __FlashStringHelper* DigitalOut::pin_key_error_ =
     F("Missing property: pin (unsigned int)");
 
-std::shared_ptr<Peripheral> DigitalOut::factory(
+std::unique_ptr<Peripheral> DigitalOut::factory(
     const JsonObjectConst& parameters) {
-  return std::make_shared<DigitalOut>(parameters);
+  return std::unique_ptr<Peripheral>(new DigitalOut(parameters));
 }
 
-bool DigitalOut::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
-bool DigitalOut::capability_set_value_ =
-    capabilities::SetValue::registerType(type());
-
 }  // namespace digital_out
 }  // namespace peripherals
 }  // namespace peripheral
@@ -21,7 +21,9 @@ class DigitalOut : public Peripheral, public capabilities::SetValue {
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "DigitalOut";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameter);
 
   /**
    * Turns the GPIO on or off
@@ -31,10 +33,6 @@ class DigitalOut : public Peripheral, public capabilities::SetValue {
   void setValue(utils::ValueUnit value_unit) final;
 
  private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameter);
-  static bool registered_;
-  static bool capability_set_value_;
-
   /// The pin to be used as a GPIO output
   unsigned int pin_;
   static const __FlashStringHelper* pin_key_;
@@ -16,17 +16,14 @@ DummyPeripheral::~DummyPeripheral() {
 const String& DummyPeripheral::getType() const { return type(); }
 
 const String& DummyPeripheral::type() {
-  static const String name{"DummyPeripheral"};
+  static const String name{type_name_};
   return name;
 }
 
-std::shared_ptr<Peripheral> DummyPeripheral::factory(const JsonObjectConst&) {
-  return std::make_shared<DummyPeripheral>();
+std::unique_ptr<Peripheral> DummyPeripheral::factory(const JsonObjectConst&) {
+  return std::unique_ptr<Peripheral>(new DummyPeripheral());
 }
 
-bool DummyPeripheral::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
 }  // namespace dummy
 }  // namespace peripherals
 }  // namespace peripheral
@@ -46,17 +43,17 @@ void DummyTask::OnTaskDisable() {
 
 DummyTask::DummyTask(Scheduler& scheduler) : BaseTask(scheduler) {}
 
-bool DummyTask::registered_ = TaskFactory::registerTask(type(), factory);
-
 BaseTask* DummyTask::factory(const JsonObjectConst& parameters,
-                             Scheduler& scheduler) {
-  BaseTask* task = new DummyTask(scheduler);
-  task->setIterations(1);
+                             Scheduler& scheduler, TaskPool& pool) {
+  BaseTask* task = new (pool) DummyTask(scheduler);
+  if (task) {
+    task->setIterations(1);
+  }
   return task;
 }
 
 const String& DummyTask::type() {
-  static const String name{"DummyTask"};
+  static const String name{type_name_};
   return name;
 }
 
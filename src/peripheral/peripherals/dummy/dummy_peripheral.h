@@ -22,12 +22,9 @@ class DummyPeripheral : public Peripheral {
   virtual ~DummyPeripheral();
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "DummyPeripheral";
   static const String& type();
-
- private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst&);
-
-  static bool registered_;
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst&);
 };
 }  // namespace dummy
 }  // namespace peripherals
@@ -43,12 +40,10 @@ class DummyTask : public BaseTask {
   void OnTaskDisable() final;
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "DummyTask";
   static const String& type();
-
- private:
-  static bool registered_;
   static BaseTask* factory(const JsonObjectConst& parameters,
-                           Scheduler& scheduler);
+                           Scheduler& scheduler, TaskPool& pool);
 };
 }  // namespace tasks
 }  // namespace bernd_box
\ No newline at end of file
@@ -12,13 +12,14 @@ I2CAbstractPeripheral::I2CAbstractPeripheral(const JsonObjectConst& parameter) {
     return;
   }
 
-  std::shared_ptr<Peripheral> peripheral =
+  PeripheralRef<Peripheral> peripheral =
       Services::getPeripheralController().getPeripheral(i2c_adapter_uuid);
 
   // Since the UUID is specified externally, check the type
   if (peripheral->getType() == util::I2CAdapter::type() &&
       peripheral->isValid()) {
-    i2c_adapter_ = std::static_pointer_cast<util::I2CAdapter>(peripheral);
+    i2c_adapter_ = PeripheralRef<util::I2CAdapter>(
+        peripheral, static_cast<util::I2CAdapter*>(peripheral.get()));
   } else {
     setInvalid(invalidI2CAdapterError(i2c_adapter_uuid, peripheral->getType()));
     return;
@@ -3,6 +3,7 @@
 #include <Wire.h>
 
 #include "peripheral/peripheral.h"
+#include "peripheral/peripheral_ref.h"
 #include "peripheral/peripherals/i2c_adapter/i2c_adapter.h"
 
 namespace bernd_box {
@@ -36,7 +37,7 @@ class I2CAbstractPeripheral : public Peripheral {
   static const __FlashStringHelper* i2c_adapter_key_;
   static const __FlashStringHelper* i2c_adapter_key_error_;
 
-  std::shared_ptr<peripherals::util::I2CAdapter> i2c_adapter_;
+  PeripheralRef<peripherals::util::I2CAdapter> i2c_adapter_;
 };
 
 }  // namespace i2c_adapter
@@ -44,19 +44,17 @@ I2CAdapter::~I2CAdapter() { *taken_variable = false; }
 const String& I2CAdapter::getType() const { return type(); }
 
 const String& I2CAdapter::type() {
-  static const String name{"I2CAdapter"};
+  static const String name{type_name_};
   return name;
 }
 
 TwoWire* I2CAdapter::getWire() { return wire_; }
 
-std::shared_ptr<Peripheral> I2CAdapter::factory(
+std::unique_ptr<Peripheral> I2CAdapter::factory(
     const JsonObjectConst& parameter) {
-  return std::make_shared<I2CAdapter>(parameter);
+  return std::unique_ptr<Peripheral>(new I2CAdapter(parameter));
 }
 
-bool I2CAdapter::registered_ = PeripheralFactory::registerFactory(type(), factory);
-
 }  // namespace util
 }  // namespace peripherals
 }  // namespace peripheral
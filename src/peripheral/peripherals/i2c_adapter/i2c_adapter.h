@@ -19,15 +19,13 @@ class I2CAdapter : public Peripheral {
   virtual ~I2CAdapter();
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "I2CAdapter";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst&);
 
   TwoWire* getWire();
 
  private:
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst&);
-
-  static bool registered_;
-
   static bool wire_taken;
   static bool wire1_taken;
 
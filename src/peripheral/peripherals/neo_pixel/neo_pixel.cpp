@@ -6,6 +6,8 @@ namespace peripherals {
 namespace neo_pixel {
 
 NeoPixel::NeoPixel(const JsonObjectConst& parameters) {
+  addCapability<capabilities::LedStrip>(this);
+
   JsonVariantConst color_encoding_str = parameters[color_encoding_key_];
   if (color_encoding_str.isNull() || !color_encoding_str.is<String>()) {
     setInvalid(color_encoding_key_error_);
@@ -40,7 +42,7 @@ NeoPixel::NeoPixel(const JsonObjectConst& parameters) {
 const String& NeoPixel::getType() const { return type(); }
 
 const String& NeoPixel::type() {
-  static const String name{"NeoPixel"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -64,17 +66,11 @@ String NeoPixel::invalidColorEncodingError(const String& color_encoding) {
   return error;
 }
 
-std::shared_ptr<Peripheral> NeoPixel::factory(
+std::unique_ptr<Peripheral> NeoPixel::factory(
     const JsonObjectConst& parameter) {
-  return std::make_shared<NeoPixel>(parameter);
+  return std::unique_ptr<Peripheral>(new NeoPixel(parameter));
 }
 
-bool NeoPixel::registered_ =
-    PeripheralFactory::registerFactory(type(), factory);
-
-bool NeoPixel::capability_led_strip_ =
-    capabilities::LedStrip::registerType(type());
-
 const __FlashStringHelper* NeoPixel::color_encoding_key_ = F("color_encoding");
 const __FlashStringHelper* NeoPixel::color_encoding_key_error_ F(
     "Missing property: color_encoding (string)");
@@ -25,7 +25,9 @@ class NeoPixel : public Peripheral, public capabilities::LedStrip {
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "NeoPixel";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameters);
 
   /**
    * Turns on all LEDs in a strip to a specific color
@@ -42,10 +44,6 @@ class NeoPixel : public Peripheral, public capabilities::LedStrip {
  private:
   static String invalidColorEncodingError(const String& color_encoding);
 
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameters);
-  static bool registered_;
-  static bool capability_led_strip_;
-
   static const uint8_t blue_offset_{0};
   static const uint8_t green_offset_{2};
   static const uint8_t red_offset_{4};
@@ -6,6 +6,8 @@ namespace peripherals {
 namespace pwm {
 
 Pwm::Pwm(const JsonObjectConst& parameters) {
+  addCapability<capabilities::SetValue>(this);
+
   JsonVariantConst pin = parameters[pin_key_];
 
   if (!pin.is<unsigned int>()) {
@@ -32,7 +34,7 @@ Pwm::~Pwm() { freeResources(); }
 const String& Pwm::getType() const { return type(); }
 
 const String& Pwm::type() {
-  static const String name{"PWM"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -99,14 +101,10 @@ const __FlashStringHelper* Pwm::pin_key_error_ =
 const __FlashStringHelper* Pwm::no_channels_available_error_ =
     F("No remaining PWM channels available");
 
-std::shared_ptr<Peripheral> Pwm::factory(const JsonObjectConst& parameters) {
-  return std::make_shared<Pwm>(parameters);
+std::unique_ptr<Peripheral> Pwm::factory(const JsonObjectConst& parameters) {
+  return std::unique_ptr<Peripheral>(new Pwm(parameters));
 }
 
-bool Pwm::registered_ = PeripheralFactory::registerFactory(type(), factory);
-
-bool Pwm::capability_set_value_ = capabilities::SetValue::registerType(type());
-
 std::bitset<16> Pwm::busy_channels_;
 
 }  // namespace pwm
@@ -21,7 +21,9 @@ class Pwm : public Peripheral, public capabilities::SetValue {
 
   // Type registration in the peripheral factory
   const String& getType() const final;
+  static constexpr const char* type_name_ = "PWM";
   static const String& type();
+  static std::unique_ptr<Peripheral> factory(const JsonObjectConst& parameters);
 
   /**
    * Turn on the connected PWM signal to the specified value
@@ -46,10 +48,6 @@ class Pwm : public Peripheral, public capabilities::SetValue {
    */
   void freeResources();
 
-  static std::shared_ptr<Peripheral> factory(const JsonObjectConst& parameters);
-  static bool registered_;
-  static bool capability_set_value_;
-
   /// Name of the parameter to which the pin the PWM signal is connected
   static const __FlashStringHelper* pin_key_;
   static const __FlashStringHelper* pin_key_error_;
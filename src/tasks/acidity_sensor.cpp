@@ -35,14 +35,11 @@ float AciditySensor::getMedianMeasurement() {
     sample_count++;
   }
 
-  std::sort(samples_.begin(), samples_.begin() + sample_count);
-
-  float median;
-  if (sample_count % 2 == 0) {
-    median = (samples_[sample_count / 2 - 1] + samples_[sample_count / 2]) / 2;
-  } else {
-    median = samples_[sample_count / 2];
-  }
+  // Partially reorder a copy, so that the samples stay in the order they were
+  // measured in
+  auto samples = samples_;
+  const float median =
+      utils::median(samples.data(), samples.data() + sample_count);
 
   for (const auto& it : samples_) {
     Serial.printf("%f, ", it);
@@ -0,0 +1,164 @@
+#include "aggregate_sensor.h"
+
+namespace bernd_box {
+namespace tasks {
+namespace aggregate_sensor {
+
+AggregateSensor::AggregateSensor(const JsonObjectConst& parameters,
+                                 Scheduler& scheduler)
+    : GetValuesTask(parameters, scheduler) {
+  if (!isValid()) {
+    return;
+  }
+
+  // Get the interval with which to sample the sensor
+  JsonVariantConst sample_interval_ms = parameters[sample_interval_ms_key_];
+  if (!sample_interval_ms.is<unsigned int>()) {
+    setInvalid(sample_interval_ms_key_error_);
+    return;
+  }
+  sample_interval_ = std::chrono::milliseconds(sample_interval_ms);
+
+  // Get the length of the windows to send the statistics of
+  JsonVariantConst window_ms = parameters[window_ms_key_];
+  if (!window_ms.is<unsigned int>() || window_ms.as<unsigned int>() == 0) {
+    setInvalid(window_ms_key_error_);
+    return;
+  }
+  window_ = std::chrono::milliseconds(window_ms);
+
+  // Optionally get the duration for which to sample the sensor [default:
+  // forever]
+  JsonVariantConst duration_ms = parameters[duration_ms_key_];
+  if (duration_ms.is<unsigned int>()) {
+    run_until_ = std::chrono::steady_clock::now() +
+                 std::chrono::milliseconds(duration_ms);
+  } else if (duration_ms.isNull()) {
+    run_until_ = std::chrono::steady_clock::time_point::max();
+  } else {
+    setInvalid(duration_ms_key_error_);
+    return;
+  }
+  window_end_ = std::chrono::steady_clock::now() + window_;
+
+  startMeasurement(parameters);
+}
+
+const String& AggregateSensor::getType() const { return type(); }
+
+const String& AggregateSensor::type() {
+  static const String name{type_name_};
+  return name;
+}
+
+bool AggregateSensor::TaskCallback() {
+  // If using a startMeasurement peripheral, handle the measurement. Delay
+  // reading values if the result includes a wait duration.
+  auto start_measurement_peripheral = getStartMeasurementPeripheral();
+  if (start_measurement_peripheral) {
+    auto result = start_measurement_peripheral->handleMeasurement();
+    if (result.error.isError()) {
+      setInvalid(result.error.toString());
+      return false;
+    }
+    if (result.wait.count() != 0) {
+      Task::delay(
+          std::chrono::duration_cast<std::chrono::milliseconds>(result.wait)
+              .count());
+      return true;
+    }
+  }
+
+  auto values = readValues();
+  if (values.error.isError()) {
+    setInvalid(values.error.toString());
+    return false;
+  }
+  addValues(values.values);
+
+  // Send the last window when the duration is over
+  const auto now = std::chrono::steady_clock::now();
+  if (run_until_ < now) {
+    sendWindow();
+    return false;
+  }
+
+  // The windows stay aligned to the start of the task, unless it fell behind
+  // by more than a window
+  if (window_end_ <= now) {
+    sendWindow();
+    window_end_ += window_;
+    if (window_end_ <= now) {
+      window_end_ = now + window_;
+    }
+  }
+
+  Task::delay(sample_interval_.count());
+  return true;
+}
+
+void AggregateSensor::addValues(const std::vector<utils::ValueUnit>& values) {
+  // Peripherals only have a few data points, so a linear search is cheapest
+  for (const auto& value_unit : values) {
+    auto data_point = data_points_.begin();
+    while (data_point != data_points_.end() &&
+           data_point->data_point_type != value_unit.data_point_type) {
+      data_point++;
+    }
+    if (data_point == data_points_.end()) {
+      data_points_.push_back(DataPoint{value_unit.data_point_type, {}});
+      data_point = data_points_.end() - 1;
+    }
+    data_point->statistics.add(value_unit.value);
+  }
+}
+
+void AggregateSensor::sendWindow() {
+  // Borrow a JSON doc from the pool
+  auto result_doc_lease =
+      utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& result_doc = *result_doc_lease;
+  JsonObject result_object = result_doc.to<JsonObject>();
+
+  // Add the statistics of each data point type. The mean is the value
+  Server& server = Services::getServer();
+  JsonArray data_points_array =
+      result_object.createNestedArray(utils::ValueUnit::data_points_key);
+  for (auto& data_point : data_points_) {
+    const utils::RunningStatistics& statistics = data_point.statistics;
+    JsonObject data_point_object = data_points_array.createNestedObject();
+    data_point_object[utils::ValueUnit::value_key] = statistics.getMean();
+    data_point_object[min_key_] = statistics.getMin();
+    data_point_object[max_key_] = statistics.getMax();
+    data_point_object[stddev_key_] = statistics.getStandardDeviation();
+    data_point_object[count_key_] = statistics.getCount();
+    server.addUUID(data_point_object, utils::ValueUnit::data_point_type_key,
+                   data_point.data_point_type);
+    data_point.statistics.clear();
+  }
+  server.addUUID(result_object, peripheral_key_, getPeripheralUUID());
+  result_object[window_ms_key_] = window_.count();
+
+  server.sendTelemetry(getTaskID(), result_object);
+}
+
+BaseTask* AggregateSensor::factory(const JsonObjectConst& parameters,
+                                   Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) AggregateSensor(parameters, scheduler);
+}
+
+const __FlashStringHelper* AggregateSensor::sample_interval_ms_key_ =
+    F("sample_interval_ms");
+const __FlashStringHelper* AggregateSensor::sample_interval_ms_key_error_ =
+    F("Missing property: sample_interval_ms (unsigned int)");
+const __FlashStringHelper* AggregateSensor::window_ms_key_ = F("window_ms");
+const __FlashStringHelper* AggregateSensor::window_ms_key_error_ =
+    F("Missing property: window_ms (unsigned int > 0)");
+const __FlashStringHelper* AggregateSensor::min_key_ = F("min");
+const __FlashStringHelper* AggregateSensor::max_key_ = F("max");
+const __FlashStringHelper* AggregateSensor::stddev_key_ = F("stddev");
+const __FlashStringHelper* AggregateSensor::count_key_ = F("count");
+
+}  // namespace aggregate_sensor
+}  // namespace tasks
+}  // namespace bernd_box
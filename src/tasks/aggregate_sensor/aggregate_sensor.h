@@ -0,0 +1,80 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "peripheral/capabilities/start_measurement.h"
+#include "tasks/get_values_task/get_values_task.h"
+#include "utils/running_statistics.h"
+
+namespace bernd_box {
+namespace tasks {
+namespace aggregate_sensor {
+
+/**
+ * Samples a sensor at a fast rate and sends statistics of each window
+ *
+ * The sensor is read every sample interval via the GetValues capability, as
+ * PollSensor does. Instead of sending every reading, the minimum, maximum,
+ * mean and standard deviation of each data point type are kept in constant
+ * memory and sent once per window. The mean is sent as the data point's
+ * value.
+ *
+ * The optional duration specifies for how long the sensor is sampled. The
+ * statistics of the last, possibly shorter window are sent when it ends.
+ */
+class AggregateSensor : public get_values_task::GetValuesTask {
+ public:
+  AggregateSensor(const JsonObjectConst& parameters, Scheduler& scheduler);
+  virtual ~AggregateSensor() = default;
+
+  const String& getType() const final;
+  static constexpr const char* type_name_ = "AggregateSensor";
+  static const String& type();
+  static BaseTask* factory(const JsonObjectConst& parameters,
+                           Scheduler& scheduler, TaskPool& pool);
+
+  bool TaskCallback() final;
+
+ private:
+  /// The statistics of a data point type in the current window
+  struct DataPoint {
+    utils::UUID data_point_type;
+    utils::RunningStatistics statistics;
+  };
+
+  /**
+   * Adds the values of a reading to the statistics of their data point types
+   *
+   * \param values The values read from the peripheral
+   */
+  void addValues(const std::vector<utils::ValueUnit>& values);
+
+  /**
+   * Sends the statistics of the window and starts the next one
+   */
+  void sendWindow();
+
+  std::chrono::milliseconds sample_interval_;
+  std::chrono::milliseconds window_;
+  std::chrono::steady_clock::time_point window_end_;
+  std::chrono::steady_clock::time_point run_until_;
+
+  std::vector<DataPoint> data_points_;
+
+  static const __FlashStringHelper* sample_interval_ms_key_;
+  static const __FlashStringHelper* sample_interval_ms_key_error_;
+  static const __FlashStringHelper* window_ms_key_;
+  static const __FlashStringHelper* window_ms_key_error_;
+  static const __FlashStringHelper* min_key_;
+  static const __FlashStringHelper* max_key_;
+  static const __FlashStringHelper* stddev_key_;
+  static const __FlashStringHelper* count_key_;
+};
+
+}  // namespace aggregate_sensor
+}  // namespace tasks
+}  // namespace bernd_box
@@ -62,12 +62,12 @@ AlertSensor::AlertSensor(const JsonObjectConst& parameters,
 const String& AlertSensor::getType() const { return type(); }
 
 const String& AlertSensor::type() {
-  static const String name{"AlertSensor"};
+  static const String name{type_name_};
   return name;
 }
 
 bool AlertSensor::TaskCallback() {
-  auto result = getPeripheral()->getValues();
+  auto result = readValues();
   if (result.error.isError()) {
     setInvalid(result.error.toString());
     return false;
@@ -123,7 +123,10 @@ AlertSensor::TriggerType AlertSensor::getTriggerType() { return trigger_type_; }
 bool AlertSensor::sendAlert(TriggerType trigger_type) {
   if (trigger_type == TriggerType::kRising ||
       trigger_type == TriggerType::kFalling) {
-    DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
+    // Threshold, trigger type, peripheral UUID and the type and name added by
+    // the server. Only the UUID and the name are copied into the doc
+    auto doc_lease = utils::JsonDocumentPool::acquire(JSON_OBJECT_SIZE(5) + 64);
+    DynamicJsonDocument& doc = *doc_lease;
     doc[threshold_key_] = threshold_;
 
     auto trigger_type_string = trigger_type_strings_.find(trigger_type);
@@ -133,9 +136,10 @@ bool AlertSensor::sendAlert(TriggerType trigger_type) {
       return false;
     }
 
-    doc[peripheral_key_] = getPeripheralUUID().toString();
+    Server& server = Services::getServer();
+    server.addUUID(doc.as<JsonObject>(), peripheral_key_, getPeripheralUUID());
 
-    Services::getServer().send(type(), doc);
+    server.send(type(), doc);
     return true;
   }
 
@@ -150,11 +154,9 @@ bool AlertSensor::isFallingThreshold(const float value) {
   return value < threshold_ && last_value_ > threshold_;
 }
 
-bool AlertSensor::registered_ = TaskFactory::registerTask(type(), factory);
-
 BaseTask* AlertSensor::factory(const JsonObjectConst& parameters,
-                               Scheduler& scheduler) {
-  return new AlertSensor(parameters, scheduler);
+                               Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) AlertSensor(parameters, scheduler);
 }
 
 const std::map<AlertSensor::TriggerType, const __FlashStringHelper*>
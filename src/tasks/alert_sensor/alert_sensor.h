@@ -1,9 +1,11 @@
 #pragma once
 
+#include <map>
 #include <memory>
 
 #include "ArduinoJson.h"
 #include "tasks/get_values_task/get_values_task.h"
+#include "utils/json_document_pool.h"
 #include "utils/value_unit.h"
 
 namespace bernd_box {
@@ -18,7 +20,10 @@ class AlertSensor : public get_values_task::GetValuesTask {
   virtual ~AlertSensor() = default;
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "AlertSensor";
   static const String& type();
+  static BaseTask* factory(const JsonObjectConst& parameters,
+                           Scheduler& scheduler, TaskPool& pool);
 
   bool TaskCallback() final;
 
@@ -58,10 +63,6 @@ class AlertSensor : public get_values_task::GetValuesTask {
   bool isRisingThreshold(const float value);
   bool isFallingThreshold(const float value);
 
-  static bool registered_;
-  static BaseTask* factory(const JsonObjectConst& parameters,
-                           Scheduler& scheduler);
-
   static const std::map<TriggerType, const __FlashStringHelper*>
       trigger_type_strings_;
 
@@ -4,7 +4,9 @@ namespace bernd_box {
 namespace tasks {
 
 BaseTask::BaseTask(Scheduler& scheduler, utils::UUID task_id)
-    : Task(&scheduler), scheduler_(scheduler), task_id_(task_id) {}
+    : Task(&scheduler), scheduler_(scheduler), task_id_(task_id) {
+  registerTask();
+}
 
 BaseTask::BaseTask(Scheduler& scheduler, const JsonObjectConst& parameters)
     : Task(&scheduler), scheduler_(scheduler) {
@@ -14,6 +16,28 @@ BaseTask::BaseTask(Scheduler& scheduler, const JsonObjectConst& parameters)
     setInvalid(task_id_key_error_);
     return;
   }
+
+  registerTask();
+}
+
+BaseTask::~BaseTask() {
+  if (is_registered_) {
+    getRegistry().erase(task_id_);
+  }
+}
+
+void* BaseTask::operator new(size_t size) {
+  return TaskPool::allocateHeap(size);
+}
+
+void* BaseTask::operator new(size_t size, TaskPool& pool) noexcept {
+  return pool.allocate(size);
+}
+
+void BaseTask::operator delete(void* task) { TaskPool::deallocate(task); }
+
+void BaseTask::operator delete(void* task, TaskPool& pool) {
+  TaskPool::deallocate(task);
 }
 
 bool BaseTask::OnEnable() {
@@ -32,10 +56,27 @@ bool BaseTask::OnEnable() {
 bool BaseTask::OnTaskEnable() { return true; }
 
 bool BaseTask::Callback() {
+  // Measure how long the task waited past its scheduled time
+  SchedulingLatency& latency =
+      getSchedulingLatencies()[static_cast<size_t>(getPriority())];
+  const uint32_t delay_ms = getStartDelay();
+  latency.count++;
+  latency.total_ms += delay_ms;
+  if (delay_ms > latency.max_ms) {
+    latency.max_ms = delay_ms;
+  }
+  profile_.start_delay.add(delay_ms * 1000);
+
+  // A negative overrun is the time the callback started past the next interval
+  const long overrun_ms = getOverrun();
+  profile_.overrun.add(overrun_ms < 0 ? -overrun_ms * 1000 : 0);
+
   // Check that the task is valid before it is executed
   if (isValid()) {
     // Run the actual task logic
+    const unsigned long start_us = micros();
     bool is_ok = TaskCallback();
+    profile_.duration.add(micros() - start_us);
 
     // Check if the task is still valid. Disable task if not
     if (isValid() && is_ok) {
@@ -73,7 +114,50 @@ ErrorResult BaseTask::getError() const {
 
 const utils::UUID& BaseTask::getTaskID() const { return task_id_; }
 
-void BaseTask::setTaskRemovalCallback(std::function<void(Task&)> callback) {
+const TaskProfile& BaseTask::getProfile() const { return profile_; }
+
+void BaseTask::resetProfile() {
+  profile_.duration.clear();
+  profile_.start_delay.clear();
+  profile_.overrun.clear();
+}
+
+Priority BaseTask::getPriority() const {
+  if (&scheduler_ == high_priority_scheduler_) {
+    return Priority::kHigh;
+  }
+  return Priority::kNormal;
+}
+
+void BaseTask::setHighPriorityScheduler(Scheduler& scheduler) {
+  high_priority_scheduler_ = &scheduler;
+}
+
+const SchedulingLatency& BaseTask::getSchedulingLatency(Priority priority) {
+  return getSchedulingLatencies()[static_cast<size_t>(priority)];
+}
+
+void BaseTask::resetSchedulingLatency() {
+  for (auto& latency : getSchedulingLatencies()) {
+    latency = SchedulingLatency{0, 0, 0};
+  }
+}
+
+BaseTask* BaseTask::findTask(const utils::UUID& task_id) {
+  const auto& registry = getRegistry();
+  const auto it = registry.find(task_id);
+  if (it != registry.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+const std::unordered_map<utils::UUID, BaseTask*>& BaseTask::getTasks() {
+  return getRegistry();
+}
+
+void BaseTask::setTaskRemovalCallback(
+    std::function<void(BaseTask&)> callback) {
   task_removal_callback_ = callback;
 }
 
@@ -84,6 +168,23 @@ void BaseTask::setInvalid(const String& error_message) {
   error_message_ = error_message;
 }
 
+void BaseTask::registerTask() {
+  is_registered_ = getRegistry().insert({task_id_, this}).second;
+  if (!is_registered_) {
+    setInvalid(task_id_duplicate_error_);
+  }
+}
+
+std::unordered_map<utils::UUID, BaseTask*>& BaseTask::getRegistry() {
+  static std::unordered_map<utils::UUID, BaseTask*> registry;
+  return registry;
+}
+
+std::array<SchedulingLatency, 2>& BaseTask::getSchedulingLatencies() {
+  static std::array<SchedulingLatency, 2> latencies{};
+  return latencies;
+}
+
 String BaseTask::peripheralNotFoundError(const utils::UUID& uuid) {
   String error(peripheral_not_found_error_);
   error += uuid.toString();
@@ -98,8 +199,11 @@ const __FlashStringHelper* BaseTask::peripheral_not_found_error_ =
 const __FlashStringHelper* BaseTask::task_id_key_ = F("uuid");
 const __FlashStringHelper* BaseTask::task_id_key_error_ =
     F("Missing property: uuid (uuid)");
+const __FlashStringHelper* BaseTask::task_id_duplicate_error_ =
+    F("Task with the same uuid already exists");
 
-std::function<void(Task&)> BaseTask::task_removal_callback_ = nullptr;
+std::function<void(BaseTask&)> BaseTask::task_removal_callback_ = nullptr;
+Scheduler* BaseTask::high_priority_scheduler_ = nullptr;
 
 }  // namespace tasks
 }  // namespace bernd_box
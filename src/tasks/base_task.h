@@ -1,17 +1,54 @@
 #pragma once
 
 #include <Arduino.h>
+#include <ArduinoJson.h>
 #include <TaskSchedulerDeclarations.h>
 
+#include <array>
 #include <functional>
 #include <set>
+#include <unordered_map>
 
-#include "managers/io_types.h"
+#include "managers/error_result.h"
+#include "task_pool.h"
+#include "utils/duration_histogram.h"
 #include "utils/uuid.h"
 
 namespace bernd_box {
 namespace tasks {
 
+/**
+ * Scheduling priority of a task
+ *
+ * High priority tasks run on a separate scheduler layered on top of the
+ * normal one. It is evaluated before every normal priority task callback.
+ */
+enum class Priority { kNormal, kHigh };
+
+/// Delays between when tasks were due and when they were run
+struct SchedulingLatency {
+  /// Number of measured callbacks
+  uint32_t count;
+  /// Sum of the delays in milliseconds
+  uint32_t total_ms;
+  /// Longest delay in milliseconds
+  uint32_t max_ms;
+};
+
+/// Execution profile of a task
+struct TaskProfile {
+  /// Time spent in the task's callbacks
+  utils::DurationHistogram duration;
+  /// Delay of the callbacks past their scheduled time. The scheduler
+  /// measures it in milliseconds
+  utils::DurationHistogram start_delay{
+      utils::DurationHistogram::getMillisecondBounds()};
+  /// How far the callbacks ran past the start of the next interval. On time
+  /// callbacks count as 0. The scheduler measures it in milliseconds
+  utils::DurationHistogram overrun{
+      utils::DurationHistogram::getMillisecondBounds()};
+};
+
 class BaseTask : public Task {
  public:
   /**
@@ -30,7 +67,34 @@ class BaseTask : public Task {
    */
   BaseTask(Scheduler& scheduler, const JsonObjectConst& parameters);
 
-  virtual ~BaseTask() = default;
+  virtual ~BaseTask();
+
+  /**
+   * Allocate a task from the heap. Used for tasks which are not pooled
+   *
+   * \param size The size of the task object
+   * \return Pointer to the memory for the task
+   */
+  static void* operator new(size_t size);
+
+  /**
+   * Allocate a task from a task pool
+   *
+   * The new-expression evaluates to a nullptr if the pool is exhausted.
+   *
+   * \param size The size of the task object
+   * \param pool The pool of the task's type
+   * \return Pointer to the memory for the task or a nullptr
+   */
+  static void* operator new(size_t size, TaskPool& pool) noexcept;
+
+  /**
+   * Free a task's memory from the heap or the pool it was allocated from
+   *
+   * \param task Pointer to the memory of the task
+   */
+  static void operator delete(void* task);
+  static void operator delete(void* task, TaskPool& pool);
 
   virtual const String& getType() const = 0;
 
@@ -111,18 +175,78 @@ class BaseTask : public Task {
    */
   const utils::UUID& getTaskID() const;
 
+  /**
+   * Gets the task's execution profile since the last reset
+   *
+   * \return The profile recorded by Callback()
+   */
+  const TaskProfile& getProfile() const;
+
+  /**
+   * Restarts the task's execution profile
+   */
+  void resetProfile();
+
+  /**
+   * Gets the task's priority, which depends on the scheduler it runs on
+   *
+   * \see setHighPriorityScheduler()
+   *
+   * \return The task's priority
+   */
+  Priority getPriority() const;
+
+  /**
+   * Sets the scheduler of the high priority tasks
+   *
+   * \param scheduler The scheduler layered on top of the normal scheduler
+   */
+  static void setHighPriorityScheduler(Scheduler& scheduler);
+
+  /**
+   * Gets the scheduling latency of the tasks of a priority since the last
+   * reset
+   *
+   * \param priority The priority of the tasks
+   * \return The measured latency
+   */
+  static const SchedulingLatency& getSchedulingLatency(Priority priority);
+
+  /**
+   * Restarts the measurement of the scheduling latencies
+   */
+  static void resetSchedulingLatency();
+
+  /**
+   * Finds a task by its UUID in constant time
+   *
+   * \param task_id The UUID of the task
+   * \return Pointer to the task or a nullptr if not found
+   */
+  static BaseTask* findTask(const utils::UUID& task_id);
+
+  /**
+   * Gets all existing tasks, including disabled ones not yet removed
+   *
+   * \return Map of the task IDs to their tasks
+   */
+  static const std::unordered_map<utils::UUID, BaseTask*>& getTasks();
+
   /**
    * Sets the callback which accepts tasks to be removed
    *
    * \param callback The function to call to add a task to the removal queue
    */
-  static void setTaskRemovalCallback(std::function<void(Task&)> callback);
+  static void setTaskRemovalCallback(std::function<void(BaseTask&)> callback);
+
+  static String peripheralNotFoundError(const utils::UUID& uuid);
 
   static const __FlashStringHelper* peripheral_key_;
   static const __FlashStringHelper* peripheral_key_error_;
   static const __FlashStringHelper* peripheral_not_found_error_;
   static const __FlashStringHelper* task_id_key_;
   static const __FlashStringHelper* task_id_key_error_;
+  static const __FlashStringHelper* task_id_duplicate_error_;
 
  protected:
   /**
@@ -141,9 +265,19 @@ class BaseTask : public Task {
    */
   void setInvalid(const String& error_message);
 
-  static String peripheralNotFoundError(const utils::UUID& uuid);
-
  private:
+  /**
+   * Adds the task to the UUID index. Sets the task invalid if a task with the
+   * same UUID already exists
+   */
+  void registerTask();
+
+  /// Index of all existing tasks by their UUID
+  static std::unordered_map<utils::UUID, BaseTask*>& getRegistry();
+
+  /// The scheduling latency of each priority
+  static std::array<SchedulingLatency, 2>& getSchedulingLatencies();
+
   /// Whether the task is in a valid or invalid state
   bool is_valid_ = true;
   /// The cause for being in an invalid state
@@ -152,8 +286,14 @@ class BaseTask : public Task {
   Scheduler& scheduler_;
   /// The task's identifier
   utils::UUID task_id_ = utils::UUID(nullptr);
+  /// Whether the task owns its entry in the UUID index
+  bool is_registered_ = false;
+  /// Execution profile of the callbacks
+  TaskProfile profile_;
   /// Add task to removal queue callback
-  static std::function<void(Task&)> task_removal_callback_;
+  static std::function<void(BaseTask&)> task_removal_callback_;
+  /// The scheduler running the high priority tasks
+  static Scheduler* high_priority_scheduler_;
 };
 
 }  // namespace tasks
@@ -27,11 +27,12 @@ Calibrate::Calibrate(const JsonObjectConst& parameters, Scheduler& scheduler)
   }
 
   // Check that the peripheral supports the Calibrate interface capability
-  peripheral_ = std::dynamic_pointer_cast<peripheral::capabilities::Calibrate>(
-      peripheral);
+  peripheral_ =
+      peripheral::capabilityCast<peripheral::capabilities::Calibrate>(
+          peripheral);
   if (!peripheral_) {
     setInvalid(peripheral::capabilities::Calibrate::invalidTypeError(
-        peripheral_uuid, peripheral));
+        peripheral_uuid, *peripheral));
     return;
   }
 
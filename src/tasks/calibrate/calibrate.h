@@ -4,6 +4,7 @@
 
 #include "managers/services.h"
 #include "peripheral/capabilities/calibrate.h"
+#include "peripheral/peripheral_ref.h"
 #include "tasks/base_task.h"
 
 namespace bernd_box {
@@ -23,9 +24,9 @@ class Calibrate : public BaseTask {
  private:
   static bool registered_;
   static BaseTask* factory(const JsonObjectConst& parameters,
-                           Scheduler& scheduler);
+                           Scheduler& scheduler, TaskPool& pool);
 
-  std::shared_ptr<peripheral::capabilities::Calibrate> peripheral_;
+  peripheral::PeripheralRef<peripheral::capabilities::Calibrate> peripheral_;
 };
 
 }  // namespace calibrate
@@ -9,7 +9,8 @@ CheckConnectivity::CheckConnectivity(Scheduler* scheduler)
       network_(Services::getNetwork()),
       mqtt_(Services::getMqtt()),
       server_(Services::getServer()),
-      is_setup_(false) {
+      is_setup_(false),
+      wifi_backoff_(wifi_reconnect_min_delay, wifi_reconnect_max_delay) {
   Task::setIterations(TASK_FOREVER);
   Task::setInterval(
       std::chrono::milliseconds(check_connectivity_period).count());
@@ -18,58 +19,103 @@ CheckConnectivity::CheckConnectivity(Scheduler* scheduler)
 CheckConnectivity::~CheckConnectivity() {}
 
 bool CheckConnectivity::OnEnable() {
-  bool success = Callback();
-  is_setup_ = success;
-  return success;
+  is_setup_ = true;
+  return true;
 }
 
 bool CheckConnectivity::Callback() {
-  checkNetwork();
-  checkInternetTime();
-  handleServer();
+  handleNetwork();
+  server_.handle();
 
   return true;
 }
 
-bool CheckConnectivity::checkNetwork() {
-  if (!network_.isConnected()) {
-    if (network_.connect(wifi_connect_timeout) == false) {
-      Serial.println(
-          F("CheckConnectivity::Callback: Failed to connect to WiFi.\n"
-            "Restarting in 10s"));
-      delay(10000);
-      ESP.restart();
-    }
+void CheckConnectivity::handleNetwork() {
+  const std::chrono::milliseconds elapsed =
+      std::chrono::milliseconds(millis()) - state_start_;
+
+  switch (state_) {
+    case State::kOffline: {
+      if (elapsed >= retry_delay_) {
+        network_.startConnect();
+        setState(State::kConnecting);
+      }
+    } break;
+    case State::kConnecting: {
+      if (network_.isConnected()) {
+        Serial.print(F("CheckConnectivity: Connected to WiFi. IP address is "));
+        Serial.println(WiFi.localIP());
+        wifi_backoff_.reset();
+
+        // The time is kept after reconnecting
+        if (network_.isTimeSet()) {
+          setState(State::kOnline);
+        } else {
+          network_.startTimeSync();
+          setState(State::kSyncingTime);
+        }
+      } else if (elapsed > wifi_connect_timeout) {
+        Serial.println(F("CheckConnectivity: Failed to connect to WiFi"));
+        retryNetwork();
+      }
+    } break;
+    case State::kSyncingTime: {
+      if (!network_.isConnected()) {
+        retryNetwork();
+      } else if (network_.isTimeSet()) {
+        last_time_sync_ = std::chrono::milliseconds(millis());
+        setState(State::kOnline);
+      } else if (elapsed > time_sync_timeout) {
+        // Try the server anyway. The time is synchronized again later
+        Serial.println(F("CheckConnectivity: Failed to get the NTP time"));
+        last_time_sync_ = std::chrono::milliseconds(millis());
+        setState(State::kOnline);
+      }
+    } break;
+    case State::kOnline: {
+      if (!network_.isConnected()) {
+        Serial.println(F("CheckConnectivity: Lost the WiFi connection"));
+        // Reconnect right away, as the access point was just available
+        retry_delay_ = std::chrono::milliseconds(0);
+        setState(State::kOffline);
+      } else {
+        checkInternetTime();
+      }
+    } break;
+  }
+}
 
-    // Contact the server. If it fails there is something wrong. Do not proceed.
-    // String response = network_.pingSdgServer();
-    // if (response.isEmpty()) {
-    //   Serial.println(
-    //       F("CheckConnectivity::Callback: Failed to ping the server.\n"
-    //         "Restarting in 10s"));
-    //   delay(10000);
-    //   ESP.restart();
-    // }
+void CheckConnectivity::setState(State state) {
+  // TLS needs the time, so the server is connected once the time is set or
+  // its synchronization timed out. It then reconnects on its own
+  if (state == State::kOnline) {
+    server_.connect();
   }
 
-  return true;
+  state_ = state;
+  state_start_ = std::chrono::milliseconds(millis());
 }
 
-bool CheckConnectivity::checkInternetTime() {
-  if (millis() - last_time_check_ms > time_check_duration_ms) {
-    last_time_check_ms = millis();
+void CheckConnectivity::retryNetwork() {
+  retry_delay_ = wifi_backoff_.fail();
+  Serial.printf("CheckConnectivity: Retrying WiFi in %lu ms\n",
+                static_cast<unsigned long>(retry_delay_.count()));
+  setState(State::kOffline);
+}
 
-    int error = network_.setClock(std::chrono::seconds(30));
-    if (error) {
-      Serial.println(
-          F("CheckConnectivity::OnEnable: Failed to update time.\n"
-            "Restarting in 10s"));
-      delay(10000);
-      ESP.restart();
-    }
+void CheckConnectivity::checkInternetTime() {
+  // The NTP client keeps the clock running, so resynchronizing does not wait
+  // for the result. A failed synchronization is retried sooner
+  std::chrono::milliseconds interval = time_sync_interval_;
+  if (!network_.isTimeSet()) {
+    interval = time_sync_timeout;
   }
 
-  return true;
+  const std::chrono::milliseconds now(millis());
+  if (now - last_time_sync_ > interval) {
+    last_time_sync_ = now;
+    network_.startTimeSync();
+  }
 }
 
 bool CheckConnectivity::checkMqtt() {
@@ -104,23 +150,6 @@ bool CheckConnectivity::checkMqtt() {
   return true;
 }
 
-bool CheckConnectivity::handleServer() {
-  if (!server_.isConnected()) {
-    if (!server_.connect(server_connect_timeout)) {
-      Serial.println(F("Unable to connect to server. Restarting in 10s"));
-      ::delay(10000);
-      ESP.restart();
-    } else {
-      server_.sendRegister();
-      Serial.println(F("CheckConnectivity: Reconnected to server"));
-    }
-  }
-
-  server_.handle();
-
-  return true;
-}
-
 }  // namespace connectivity
 }  // namespace tasks
 }  // namespace bernd_box
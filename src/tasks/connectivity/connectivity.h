@@ -1,6 +1,6 @@
 #pragma once
 
-#include <limits>
+#include <chrono>
 
 #include "TaskSchedulerDeclarations.h"
 #include "configuration.h"
@@ -8,49 +8,63 @@
 #include "managers/mqtt.h"
 #include "managers/network.h"
 #include "managers/services.h"
+#include "utils/backoff.h"
 #include "utils/setupNode.h"
 
 namespace bernd_box {
 namespace tasks {
 namespace connectivity {
 
+/**
+ * Keeps the WiFi connection, the time and the server connection up
+ *
+ * The connection is established step by step in a state machine which is
+ * advanced with every iteration, so that no step blocks the scheduler. Failed
+ * WiFi connections are retried with an exponential backoff with jitter. The
+ * server connection reconnects on its own in the background. Peripherals and
+ * tasks keep running through outages.
+ */
 class CheckConnectivity : public Task {
  public:
   CheckConnectivity(Scheduler* scheduler);
   virtual ~CheckConnectivity();
 
  private:
+  enum class State {
+    /// Waiting for the backoff delay to connect to WiFi
+    kOffline,
+    /// Waiting for the WiFi connection
+    kConnecting,
+    /// Waiting for the NTP time after connecting to WiFi
+    kSyncingTime,
+    /// Connected to WiFi. The server connection is kept up in the background
+    kOnline,
+  };
+
   bool OnEnable() final;
   bool Callback() final;
 
   /**
-   * Connects to a network
-   * 
-   * Attempts to connect to a known WiFi access point. If it fails, restart.
-   * 
-   * \return True if all is ok
+   * Advances the WiFi and time synchronization state machine
    */
-  bool checkNetwork();
+  void handleNetwork();
 
   /**
-   * Performs time synchronization when necessary
+   * Changes the state
    *
-   * Attempts to perform time synchronization with an NTP server. If it fails,
-   * restart.
-   * 
-   * \return True if all is ok
+   * \param state The new state
    */
-  bool checkInternetTime();
+  void setState(State state);
 
   /**
-   * Performs server communication processing and ensure connected state
-   *
-   * Attempts to connect within a timeout. If it fails, restart. On success send
-   * a registeration message.
-   *
-   * \return True if all is ok
+   * Schedules the next WiFi connection attempt after a failed one
+   */
+  void retryNetwork();
+
+  /**
+   * Resynchronizes the time once a day while online
    */
-  bool handleServer();
+  void checkInternetTime();
 
   /**
    * Check the connection to the MQTT broker
@@ -67,10 +81,18 @@ class CheckConnectivity : public Task {
 
   /// The MQTT receive callback is only enabled after the setup is complete
   bool is_setup_;
-  /// Last time the internet time was checked
-  long last_time_check_ms = std::numeric_limits<long>::max();
-  /// Check the internet time every 24 hours
-  long time_check_duration_ms = 24 * 60 * 60 * 1000;
+
+  State state_ = State::kOffline;
+  /// When the current state was entered
+  std::chrono::milliseconds state_start_{0};
+  /// Delay of the next connection attempt in the offline state
+  std::chrono::milliseconds retry_delay_{0};
+  utils::Backoff wifi_backoff_;
+
+  /// Last time the internet time was synchronized
+  std::chrono::milliseconds last_time_sync_{0};
+  /// Synchronize the internet time every 24 hours
+  const std::chrono::hours time_sync_interval_{24};
 };
 
 }  // namespace connectivity
@@ -4,6 +4,7 @@
 
 #include "managers/io.h"
 #include "managers/mqtt.h"
+#include "utils/filter.h"
 
 namespace bernd_box {
 namespace tasks {
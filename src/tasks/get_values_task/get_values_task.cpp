@@ -4,9 +4,96 @@ namespace bernd_box {
 namespace tasks {
 namespace get_values_task {
 
+GetValuesTemplate::GetValuesTemplate(const JsonObjectConst& parameters)
+    : filter_(parameters) {
+  peripheral_uuid_ = utils::UUID(parameters[BaseTask::peripheral_key_]);
+  if (!peripheral_uuid_.isValid()) {
+    setInvalid(BaseTask::peripheral_key_error_);
+    return;
+  }
+
+  auto peripheral =
+      Services::getPeripheralController().getPeripheral(peripheral_uuid_);
+  if (!peripheral) {
+    setInvalid(BaseTask::peripheralNotFoundError(peripheral_uuid_));
+    return;
+  }
+
+  // The capability checks are done once for all tasks of the template
+  auto get_values_peripheral =
+      peripheral::capabilityCast<peripheral::capabilities::GetValues>(
+          peripheral);
+  if (!get_values_peripheral) {
+    setInvalid(peripheral::capabilities::GetValues::invalidTypeError(
+        peripheral_uuid_, *peripheral));
+    return;
+  }
+  peripheral_ = peripheral.getHandle();
+
+  if (!filter_.isValid()) {
+    setInvalid(utils::ValueFilter::filter_key_error_);
+    return;
+  }
+
+  // Tasks started later still need the measurement parameters, while the
+  // strings of the command are only valid until it is handled. Deserializing
+  // from a const buffer makes the copy own them
+  if (peripheral::capabilityCast<peripheral::capabilities::StartMeasurement>(
+          peripheral)) {
+    const size_t json_size = measureJson(parameters);
+    std::vector<char> json(json_size + 1);
+    serializeJson(parameters, json.data(), json.size());
+    parameters_.reset(new DynamicJsonDocument(parameters.memoryUsage() +
+                                              json_size));
+    DeserializationError error = deserializeJson(
+        *parameters_, static_cast<const char*>(json.data()), json_size);
+    if (error) {
+      setInvalid(parameters_copy_error_);
+      return;
+    }
+  }
+}
+
+const utils::UUID& GetValuesTemplate::getPeripheralUUID() const {
+  return peripheral_uuid_;
+}
+
+peripheral::PeripheralRef<peripheral::capabilities::GetValues>
+GetValuesTemplate::getPeripheral() const {
+  return peripheral::capabilityCast<peripheral::capabilities::GetValues>(
+      Services::getPeripheralController().getPeripheral(peripheral_));
+}
+
+peripheral::PeripheralRef<peripheral::capabilities::StartMeasurement>
+GetValuesTemplate::getStartMeasurementPeripheral() const {
+  return peripheral::capabilityCast<peripheral::capabilities::StartMeasurement>(
+      Services::getPeripheralController().getPeripheral(peripheral_));
+}
+
+const utils::ValueFilter& GetValuesTemplate::getFilter() const {
+  return filter_;
+}
+
+bool GetValuesTemplate::mergeParameters(const JsonObjectConst& overrides,
+                                        JsonDocument& parameters) const {
+  if (parameters_) {
+    parameters.set(*parameters_);
+  }
+  JsonObject object = parameters.as<JsonObject>();
+  if (!object) {
+    object = parameters.to<JsonObject>();
+  }
+
+  // The keys and strings are only referenced, not copied
+  for (JsonPairConst pair : overrides) {
+    object[pair.key().c_str()] = pair.value();
+  }
+  return !parameters.overflowed();
+}
+
 GetValuesTask::GetValuesTask(const JsonObjectConst& parameters,
                              Scheduler& scheduler)
-    : BaseTask(scheduler, parameters) {
+    : BaseTask(scheduler, parameters), filter_(parameters) {
   // Check if the init from the JSON doc was successful
   if (!isValid()) {
     return;
@@ -28,47 +115,130 @@ GetValuesTask::GetValuesTask(const JsonObjectConst& parameters,
   }
 
   // Check that the peripheral supports the GetValues interface capability
-  peripheral_ = std::dynamic_pointer_cast<peripheral::capabilities::GetValues>(
-      peripheral);
+  peripheral_ =
+      peripheral::capabilityCast<peripheral::capabilities::GetValues>(
+          peripheral);
   if (!peripheral_) {
     setInvalid(peripheral::capabilities::GetValues::invalidTypeError(
-        peripheral_uuid_, peripheral));
+        peripheral_uuid_, *peripheral));
+    return;
+  }
+  start_measurement_peripheral_ =
+      peripheral::capabilityCast<peripheral::capabilities::StartMeasurement>(
+          peripheral);
+
+  if (!filter_.isValid()) {
+    setInvalid(utils::ValueFilter::filter_key_error_);
     return;
   }
 }
 
-std::shared_ptr<peripheral::capabilities::GetValues>
+GetValuesTask::GetValuesTask(const GetValuesTemplate& task_template,
+                             const utils::UUID& task_id, Scheduler& scheduler)
+    : BaseTask(scheduler, task_id),
+      peripheral_(task_template.getPeripheral()),
+      start_measurement_peripheral_(
+          task_template.getStartMeasurementPeripheral()),
+      peripheral_uuid_(task_template.getPeripheralUUID()),
+      filter_(task_template.getFilter()) {
+  if (!isValid()) {
+    return;
+  }
+
+  // The peripheral may have been removed since the template was added
+  if (!peripheral_) {
+    setInvalid(peripheralNotFoundError(peripheral_uuid_));
+  }
+}
+
+peripheral::PeripheralRef<peripheral::capabilities::GetValues>
 GetValuesTask::getPeripheral() {
   return peripheral_;
 }
 
+peripheral::PeripheralRef<peripheral::capabilities::StartMeasurement>
+GetValuesTask::getStartMeasurementPeripheral() {
+  return start_measurement_peripheral_;
+}
+
 const utils::UUID& GetValuesTask::getPeripheralUUID() const {
   return peripheral_uuid_;
 }
 
-ErrorResult GetValuesTask::makeTelemetryJson(JsonObject& telemetry) {
-  // Create an array for the value units and get them from the peripheral
-  JsonArray value_units_doc =
-      telemetry.createNestedArray(utils::ValueUnit::data_points_key);
+void GetValuesTask::startMeasurement(const JsonObjectConst& parameters) {
+  if (!start_measurement_peripheral_) {
+    enable();
+    return;
+  }
+
+  // Wait the returned amount of time to check the measurement state
+  auto result = start_measurement_peripheral_->startMeasurement(parameters);
+  if (result.error.isError()) {
+    setInvalid(result.error.toString());
+    return;
+  }
+  enableDelayed(
+      std::chrono::duration_cast<std::chrono::milliseconds>(result.wait)
+          .count());
+}
+
+void GetValuesTask::startMeasurement(const GetValuesTemplate& task_template,
+                                     const JsonObjectConst& overrides) {
+  if (!start_measurement_peripheral_) {
+    enable();
+    return;
+  }
+
+  auto parameters_lease =
+      utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& parameters = *parameters_lease;
+  if (!task_template.mergeParameters(overrides, parameters)) {
+    setInvalid(GetValuesTemplate::parameters_copy_error_);
+    return;
+  }
+  startMeasurement(parameters.as<JsonObjectConst>());
+}
+
+peripheral::capabilities::GetValues::Result GetValuesTask::readValues() {
   peripheral::capabilities::GetValues::Result result = peripheral_->getValues();
+  if (!result.error.isError()) {
+    filter_.apply(result.values);
+  }
+  return result;
+}
+
+ErrorResult GetValuesTask::makeTelemetryJson(JsonObject& telemetry) {
+  // Get the value units from the peripheral
+  peripheral::capabilities::GetValues::Result result = readValues();
   if(result.error.isError()) {
     return result.error;
   }
 
+  makeTelemetryJson(telemetry, result.values);
+  return ErrorResult();
+}
 
-  // Create a JSON object representation for each value unit in the array
-  for (const auto& value_unit : result.values) {
+void GetValuesTask::makeTelemetryJson(
+    JsonObject& telemetry, const std::vector<utils::ValueUnit>& values) {
+  JsonArray value_units_doc =
+      telemetry.createNestedArray(utils::ValueUnit::data_points_key);
+
+  // Create a JSON object representation for each value unit in the array. The
+  // server decides how the UUIDs are represented on its connection
+  Server& server = Services::getServer();
+  for (const auto& value_unit : values) {
     JsonObject value_unit_object = value_units_doc.createNestedObject();
     value_unit_object[utils::ValueUnit::value_key] = value_unit.value;
-    value_unit_object[utils::ValueUnit::data_point_type_key] =
-        value_unit.data_point_type.toString();
+    server.addUUID(value_unit_object, utils::ValueUnit::data_point_type_key,
+                   value_unit.data_point_type);
   }
 
   // Add the peripheral UUID to the result
-  telemetry[peripheral_key_] = peripheral_uuid_.toString();
-  return ErrorResult();
+  server.addUUID(telemetry, peripheral_key_, peripheral_uuid_);
 }
 
+const __FlashStringHelper* GetValuesTemplate::parameters_copy_error_ =
+    F("Failed to copy the parameters");
 const __FlashStringHelper* GetValuesTask::threshold_key_ = F("threshold");
 const __FlashStringHelper* GetValuesTask::threshold_key_error_ =
     F("Missing property: threshold (int)");
@@ -81,6 +251,19 @@ const __FlashStringHelper* GetValuesTask::interval_ms_key_error_ =
 const __FlashStringHelper* GetValuesTask::duration_ms_key_ = F("duration_ms");
 const __FlashStringHelper* GetValuesTask::duration_ms_key_error_ =
     F("Wrong type for optional property: duration_ms (unsigned int)");
+const __FlashStringHelper* GetValuesTask::deadband_key_ = F("deadband");
+const __FlashStringHelper* GetValuesTask::deadband_absolute_key_ =
+    F("absolute");
+const __FlashStringHelper* GetValuesTask::deadband_relative_key_ =
+    F("relative");
+const __FlashStringHelper* GetValuesTask::deadband_key_error_ =
+    F("Wrong type for optional property: deadband (object with optional "
+      "absolute and relative floats >= 0)");
+const __FlashStringHelper* GetValuesTask::heartbeat_ms_key_ =
+    F("heartbeat_ms");
+const __FlashStringHelper* GetValuesTask::heartbeat_ms_key_error_ =
+    F("Wrong type for optional property: heartbeat_ms (unsigned int)");
+const __FlashStringHelper* GetValuesTask::suppressed_key_ = F("suppressed");
 
 }  // namespace get_values_task
 }  // namespace tasks
@@ -3,29 +3,124 @@
 #include <ArduinoJson.h>
 
 #include <memory>
+#include <vector>
 
 #include "managers/services.h"
 #include "peripheral/capabilities/get_values.h"
+#include "peripheral/capabilities/start_measurement.h"
 #include "peripheral/peripheral.h"
+#include "peripheral/peripheral_ref.h"
 #include "tasks/base_task.h"
+#include "tasks/task_template.h"
+#include "utils/json_document_pool.h"
 #include "utils/uuid.h"
+#include "utils/value_filter.h"
 
 namespace bernd_box {
 namespace tasks {
 namespace get_values_task {
 
+/**
+ * Abstract template that looks up a peripheral which supports the GetValues
+ * capability once for all tasks started from it
+ *
+ * The template only keeps a handle to the peripheral, so that it can still be
+ * removed. Tasks started after its removal fail.
+ *
+ * If the peripheral supports the StartMeasurement capability, the template
+ * keeps a copy of its parameters. The measurements of its tasks are started
+ * with them, overridden by the parameters of the start command.
+ */
+class GetValuesTemplate : public TaskTemplate {
+ public:
+  GetValuesTemplate(const JsonObjectConst& parameters);
+  virtual ~GetValuesTemplate() = default;
+
+  const utils::UUID& getPeripheralUUID() const;
+
+  /**
+   * Gets the peripheral if it still exists
+   *
+   * \return The peripheral or a nullptr if it was removed
+   */
+  peripheral::PeripheralRef<peripheral::capabilities::GetValues>
+  getPeripheral() const;
+
+  /**
+   * Gets the peripheral if it supports the StartMeasurement capability
+   *
+   * \return The peripheral or a nullptr if not supported or removed
+   */
+  peripheral::PeripheralRef<peripheral::capabilities::StartMeasurement>
+  getStartMeasurementPeripheral() const;
+
+  /// The filter configuration copied to each task started from the template
+  const utils::ValueFilter& getFilter() const;
+
+  /**
+   * Merges the parameters of a start command into the template's parameters
+   *
+   * The merged parameters reference the strings of the template and of the
+   * start command.
+   *
+   * \param overrides The parameters of the start command
+   * \param parameters The doc to hold the merged parameters
+   * \return False if the merged parameters don't fit into the doc
+   */
+  bool mergeParameters(const JsonObjectConst& overrides,
+                       JsonDocument& parameters) const;
+
+  static const __FlashStringHelper* parameters_copy_error_;
+
+ private:
+  utils::UUID peripheral_uuid_;
+  peripheral::PeripheralHandle peripheral_;
+  utils::ValueFilter filter_;
+  /// Copy of the parameters to start the measurements of the tasks with
+  std::unique_ptr<DynamicJsonDocument> parameters_;
+};
+
 /**
  * Abstract class that implements getting a peripheral which supports the
  * GetValue capability for a given name.
+ *
+ * The readings can be smoothed or cleaned of outliers by the optional
+ * "filter" property, see utils::ValueFilter.
  */
 class GetValuesTask : public BaseTask {
  public:
   GetValuesTask(const JsonObjectConst& parameters, Scheduler& scheduler);
+
+  /**
+   * Takes the peripheral of a template instead of looking it up
+   *
+   * \param task_template The template the task is started from
+   * \param task_id The UUID of the task
+   * \param scheduler The scheduler that executes the task
+   */
+  GetValuesTask(const GetValuesTemplate& task_template,
+                const utils::UUID& task_id, Scheduler& scheduler);
   virtual ~GetValuesTask() = default;
 
-  std::shared_ptr<peripheral::capabilities::GetValues> getPeripheral();
+  peripheral::PeripheralRef<peripheral::capabilities::GetValues>
+  getPeripheral();
   const utils::UUID& getPeripheralUUID() const;
 
+  /**
+   * Gets the peripheral if it supports the StartMeasurement capability
+   *
+   * \return The peripheral or a nullptr if not supported
+   */
+  peripheral::PeripheralRef<peripheral::capabilities::StartMeasurement>
+  getStartMeasurementPeripheral();
+
+  /**
+   * Reads the values from the peripheral and applies the task's filter
+   *
+   * \return The filtered values or the error of the peripheral
+   */
+  peripheral::capabilities::GetValues::Result readValues();
+
   /**
    * Make a JSON object with the value units and UUID from the peripheral
    *
@@ -34,6 +129,15 @@ class GetValuesTask : public BaseTask {
    */
   ErrorResult makeTelemetryJson(JsonObject& telemetry);
 
+  /**
+   * Make a JSON object with already read value units and the peripheral's UUID
+   *
+   * \param telemetry The JSON object to add the value units and UUID to
+   * \param values The value units read from the peripheral
+   */
+  void makeTelemetryJson(JsonObject& telemetry,
+                         const std::vector<utils::ValueUnit>& values);
+
   static const __FlashStringHelper* threshold_key_;
   static const __FlashStringHelper* threshold_key_error_;
   static const __FlashStringHelper* trigger_type_key_;
@@ -42,10 +146,42 @@ class GetValuesTask : public BaseTask {
   static const __FlashStringHelper* interval_ms_key_error_;
   static const __FlashStringHelper* duration_ms_key_;
   static const __FlashStringHelper* duration_ms_key_error_;
+  static const __FlashStringHelper* deadband_key_;
+  static const __FlashStringHelper* deadband_absolute_key_;
+  static const __FlashStringHelper* deadband_relative_key_;
+  static const __FlashStringHelper* deadband_key_error_;
+  static const __FlashStringHelper* heartbeat_ms_key_;
+  static const __FlashStringHelper* heartbeat_ms_key_error_;
+  static const __FlashStringHelper* suppressed_key_;
+
+ protected:
+  /**
+   * Start a measurement if the peripheral supports it and enable the task
+   *
+   * The task is enabled once the measurement's result is expected. If the
+   * peripheral doesn't support the StartMeasurement capability, it is enabled
+   * without delay.
+   *
+   * \param parameters The parameters passed to the peripheral
+   */
+  void startMeasurement(const JsonObjectConst& parameters);
+
+  /**
+   * Start a measurement with the template's parameters and enable the task
+   *
+   * \param task_template The template the task is started from
+   * \param overrides The parameters of the start command replacing the
+   *     template's
+   */
+  void startMeasurement(const GetValuesTemplate& task_template,
+                        const JsonObjectConst& overrides);
 
  private:
-  std::shared_ptr<peripheral::capabilities::GetValues> peripheral_;
+  peripheral::PeripheralRef<peripheral::capabilities::GetValues> peripheral_;
+  peripheral::PeripheralRef<peripheral::capabilities::StartMeasurement>
+      start_measurement_peripheral_;
   utils::UUID peripheral_uuid_;
+  utils::ValueFilter filter_;
 };
 
 }  // namespace get_values_task
@@ -0,0 +1,225 @@
+#include "poll_group.h"
+
+namespace bernd_box {
+namespace tasks {
+namespace poll_group {
+
+using get_values_task::GetValuesTask;
+
+PollGroup::PollGroup(const JsonObjectConst& parameters, Scheduler& scheduler)
+    : BaseTask(scheduler, parameters) {
+  if (!isValid()) {
+    return;
+  }
+
+  // Get the interval with which to poll the sensors
+  JsonVariantConst interval_ms = parameters[GetValuesTask::interval_ms_key_];
+  if (!interval_ms.is<unsigned int>()) {
+    setInvalid(GetValuesTask::interval_ms_key_error_);
+    return;
+  }
+  interval_ = std::chrono::milliseconds(interval_ms);
+
+  // Optionally get the duration for which to poll the sensors [default:
+  // forever]
+  JsonVariantConst duration_ms = parameters[GetValuesTask::duration_ms_key_];
+  if (duration_ms.is<unsigned int>()) {
+    run_until_ = std::chrono::steady_clock::now() +
+                 std::chrono::milliseconds(duration_ms);
+  } else if (duration_ms.isNull()) {
+    run_until_ = std::chrono::steady_clock::time_point::max();
+  } else {
+    setInvalid(GetValuesTask::duration_ms_key_error_);
+    return;
+  }
+
+  // Look up the peripherals and check their capabilities once
+  JsonArrayConst peripherals = parameters[peripherals_key_];
+  if (!peripherals || peripherals.size() == 0) {
+    setInvalid(peripherals_key_error_);
+    return;
+  }
+  members_.reserve(peripherals.size());
+  bool has_start_measurement = false;
+  for (JsonVariantConst peripheral_uuid_variant : peripherals) {
+    utils::UUID peripheral_uuid(peripheral_uuid_variant);
+    if (!peripheral_uuid.isValid()) {
+      setInvalid(peripherals_key_error_);
+      return;
+    }
+
+    auto peripheral =
+        Services::getPeripheralController().getPeripheral(peripheral_uuid);
+    if (!peripheral) {
+      setInvalid(peripheralNotFoundError(peripheral_uuid));
+      return;
+    }
+
+    auto get_values_peripheral =
+        peripheral::capabilityCast<peripheral::capabilities::GetValues>(
+            peripheral);
+    if (!get_values_peripheral) {
+      setInvalid(peripheral::capabilities::GetValues::invalidTypeError(
+          peripheral_uuid, *peripheral));
+      return;
+    }
+
+    auto start_measurement_peripheral = peripheral::capabilityCast<
+        peripheral::capabilities::StartMeasurement>(peripheral);
+    has_start_measurement |= bool(start_measurement_peripheral);
+    members_.push_back(Member{peripheral_uuid, get_values_peripheral,
+                              start_measurement_peripheral, false,
+                              ErrorResult()});
+  }
+
+  // The parameters of the command are freed after the task is created, but
+  // the measurements are started with them on every tick. Their strings point
+  // into the reused inbound buffer, so copy them by deserializing from a const
+  // buffer instead of a shallow set()
+  if (has_start_measurement) {
+    const size_t json_size = measureJson(parameters);
+    std::vector<char> json(json_size + 1);
+    serializeJson(parameters, json.data(), json.size());
+    parameters_.reset(new DynamicJsonDocument(parameters.memoryUsage() +
+                                              json_size));
+    DeserializationError error = deserializeJson(
+        *parameters_, static_cast<const char*>(json.data()), json_size);
+    if (error) {
+      setInvalid(parameters_copy_error_);
+      return;
+    }
+  }
+
+  enable();
+}
+
+const String& PollGroup::getType() const { return type(); }
+
+const String& PollGroup::type() {
+  static const String name{type_name_};
+  return name;
+}
+
+bool PollGroup::TaskCallback() {
+  // Start all measurements of the tick at once, so that the waits overlap.
+  // Then wait for the slowest one to be done
+  if (!is_measuring_) {
+    std::chrono::nanoseconds wait = startMeasurements();
+    if (is_measuring_) {
+      Task::delay(
+          std::chrono::duration_cast<std::chrono::milliseconds>(wait).count());
+      return true;
+    }
+  } else {
+    std::chrono::nanoseconds wait = handleMeasurements();
+    if (wait.count() != 0) {
+      Task::delay(
+          std::chrono::duration_cast<std::chrono::milliseconds>(wait).count());
+      return true;
+    }
+    is_measuring_ = false;
+  }
+
+  sendValues();
+
+  if (run_until_ < std::chrono::steady_clock::now()) {
+    return false;
+  }
+  Task::delay(interval_.count());
+  return true;
+}
+
+std::chrono::nanoseconds PollGroup::startMeasurements() {
+  std::chrono::nanoseconds wait(0);
+  for (auto& member : members_) {
+    member.error = ErrorResult();
+    if (!member.start_measurement) {
+      continue;
+    }
+
+    auto result = member.start_measurement->startMeasurement(*parameters_);
+    if (result.error.isError()) {
+      member.error = result.error;
+      continue;
+    }
+    member.is_measuring = true;
+    is_measuring_ = true;
+    wait = std::max(wait, result.wait);
+  }
+  return wait;
+}
+
+std::chrono::nanoseconds PollGroup::handleMeasurements() {
+  std::chrono::nanoseconds wait(0);
+  for (auto& member : members_) {
+    if (!member.is_measuring) {
+      continue;
+    }
+
+    auto result = member.start_measurement->handleMeasurement();
+    if (result.error.isError()) {
+      member.error = result.error;
+      member.is_measuring = false;
+    } else if (result.wait.count() == 0) {
+      member.is_measuring = false;
+    } else {
+      wait = std::max(wait, result.wait);
+    }
+  }
+  return wait;
+}
+
+void PollGroup::sendValues() {
+  // Borrow a JSON doc from the pool
+  auto result_doc_lease =
+      utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& result_doc = *result_doc_lease;
+  JsonObject result_object = result_doc.to<JsonObject>();
+
+  // Add an entry with the values or the error of each peripheral. The server
+  // decides how the UUIDs are represented on its connection
+  Server& server = Services::getServer();
+  JsonArray peripherals_array =
+      result_object.createNestedArray(peripherals_key_);
+  for (auto& member : members_) {
+    JsonObject peripheral_object = peripherals_array.createNestedObject();
+    server.addUUID(peripheral_object, peripheral_key_, member.uuid);
+
+    if (!member.error.isError()) {
+      auto result = member.peripheral->getValues();
+      member.error = result.error;
+      if (!result.error.isError()) {
+        JsonArray value_units_array = peripheral_object.createNestedArray(
+            utils::ValueUnit::data_points_key);
+        for (const auto& value_unit : result.values) {
+          JsonObject value_unit_object = value_units_array.createNestedObject();
+          value_unit_object[utils::ValueUnit::value_key] = value_unit.value;
+          server.addUUID(value_unit_object,
+                         utils::ValueUnit::data_point_type_key,
+                         value_unit.data_point_type);
+        }
+      }
+    }
+    if (member.error.isError()) {
+      peripheral_object[error_key_] = member.error.detail_;
+    }
+  }
+
+  server.sendTelemetry(getTaskID(), result_object);
+}
+
+BaseTask* PollGroup::factory(const JsonObjectConst& parameters,
+                             Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) PollGroup(parameters, scheduler);
+}
+
+const __FlashStringHelper* PollGroup::peripherals_key_ = F("peripherals");
+const __FlashStringHelper* PollGroup::peripherals_key_error_ =
+    F("Missing property: peripherals (array of uuid)");
+const __FlashStringHelper* PollGroup::parameters_copy_error_ =
+    F("Failed to copy the parameters");
+const __FlashStringHelper* PollGroup::error_key_ = F("error");
+
+}  // namespace poll_group
+}  // namespace tasks
+}  // namespace bernd_box
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "managers/services.h"
+#include "peripheral/capabilities/get_values.h"
+#include "peripheral/capabilities/start_measurement.h"
+#include "peripheral/peripheral_ref.h"
+#include "tasks/base_task.h"
+#include "tasks/get_values_task/get_values_task.h"
+#include "utils/json_document_pool.h"
+#include "utils/uuid.h"
+
+namespace bernd_box {
+namespace tasks {
+namespace poll_group {
+
+/**
+ * Polls several sensors on the same tick and sends one combined message
+ *
+ * On every tick, the measurements of all peripherals supporting the
+ * StartMeasurement capability are started at once, so that their waits
+ * overlap. Once the slowest measurement is done, all peripherals are read
+ * via the GetValues capability and sent in a single telemetry message. As
+ * with PollSensor, the interval is the time after a reading has completed.
+ *
+ * A peripheral failing to measure doesn't stop the group. Its error is sent
+ * in place of its values.
+ */
+class PollGroup : public BaseTask {
+ public:
+  PollGroup(const JsonObjectConst& parameters, Scheduler& scheduler);
+  virtual ~PollGroup() = default;
+
+  const String& getType() const final;
+  static constexpr const char* type_name_ = "PollGroup";
+  static const String& type();
+  static BaseTask* factory(const JsonObjectConst& parameters,
+                           Scheduler& scheduler, TaskPool& pool);
+
+  bool TaskCallback() final;
+
+ private:
+  /// A peripheral of the group and the state of its measurement
+  struct Member {
+    utils::UUID uuid;
+    peripheral::PeripheralRef<peripheral::capabilities::GetValues> peripheral;
+    /// Set if the peripheral supports the StartMeasurement capability
+    peripheral::PeripheralRef<peripheral::capabilities::StartMeasurement>
+        start_measurement;
+    bool is_measuring;
+    /// The error of the current tick's measurement
+    ErrorResult error;
+  };
+
+  /**
+   * Starts the measurements of all members supporting it
+   *
+   * Sets is_measuring_ if any measurement was started.
+   *
+   * \return The longest wait until a measurement is done
+   */
+  std::chrono::nanoseconds startMeasurements();
+
+  /**
+   * Checks the measurements which are not done yet
+   *
+   * \return The longest wait until a measurement is done. 0 if all are done
+   */
+  std::chrono::nanoseconds handleMeasurements();
+
+  /**
+   * Reads the values of all members and sends them in one message
+   */
+  void sendValues();
+
+  std::chrono::milliseconds interval_;
+  std::chrono::steady_clock::time_point run_until_;
+  std::vector<Member> members_;
+  /// Whether the measurements of the current tick are in progress
+  bool is_measuring_ = false;
+  /// Copy of the parameters to start the measurements with on every tick
+  std::unique_ptr<DynamicJsonDocument> parameters_;
+
+  static const __FlashStringHelper* peripherals_key_;
+  static const __FlashStringHelper* peripherals_key_error_;
+  static const __FlashStringHelper* parameters_copy_error_;
+  static const __FlashStringHelper* error_key_;
+};
+
+}  // namespace poll_group
+}  // namespace tasks
+}  // namespace bernd_box
@@ -3,6 +3,110 @@
 namespace bernd_box {
 namespace tasks {
 namespace poll_sensor {
+namespace {
+
+/**
+ * Reads the optional deadband and heartbeat of reporting by exception
+ *
+ * \param parameters The parameters of the task
+ * \param deadband Set if any of the parameters is present
+ * \return The error message or an empty string on success
+ */
+String parseDeadband(const JsonObjectConst& parameters,
+                     utils::Deadband& deadband) {
+  using get_values_task::GetValuesTask;
+
+  JsonVariantConst band = parameters[GetValuesTask::deadband_key_];
+  JsonVariantConst heartbeat_ms = parameters[GetValuesTask::heartbeat_ms_key_];
+  if (band.isNull() && heartbeat_ms.isNull()) {
+    return String();
+  }
+
+  // Without a band, only readings which changed at all are sent
+  float absolute = 0;
+  float relative = 0;
+  if (!band.isNull()) {
+    JsonVariantConst absolute_variant =
+        band[GetValuesTask::deadband_absolute_key_];
+    JsonVariantConst relative_variant =
+        band[GetValuesTask::deadband_relative_key_];
+    if (!band.is<JsonObjectConst>() ||
+        !(absolute_variant.isNull() || absolute_variant.is<float>()) ||
+        !(relative_variant.isNull() || relative_variant.is<float>())) {
+      return GetValuesTask::deadband_key_error_;
+    }
+    absolute = absolute_variant.as<float>();
+    relative = relative_variant.as<float>();
+    if (absolute < 0 || relative < 0) {
+      return GetValuesTask::deadband_key_error_;
+    }
+  }
+
+  std::chrono::milliseconds heartbeat(0);
+  if (heartbeat_ms.is<unsigned int>()) {
+    heartbeat = std::chrono::milliseconds(heartbeat_ms);
+  } else if (!heartbeat_ms.isNull()) {
+    return GetValuesTask::heartbeat_ms_key_error_;
+  }
+
+  deadband = utils::Deadband(absolute, relative, heartbeat);
+  return String();
+}
+
+}  // namespace
+
+PollSensorTemplate::PollSensorTemplate(const JsonObjectConst& parameters)
+    : GetValuesTemplate(parameters) {
+  if (!isValid()) {
+    return;
+  }
+
+  JsonVariantConst interval_ms =
+      parameters[get_values_task::GetValuesTask::interval_ms_key_];
+  if (!interval_ms.is<unsigned int>()) {
+    setInvalid(get_values_task::GetValuesTask::interval_ms_key_error_);
+    return;
+  }
+  interval_ = std::chrono::milliseconds(interval_ms);
+
+  JsonVariantConst duration_ms =
+      parameters[get_values_task::GetValuesTask::duration_ms_key_];
+  if (duration_ms.is<unsigned int>()) {
+    duration_ = std::chrono::milliseconds(duration_ms);
+  } else if (duration_ms.isNull()) {
+    duration_ = std::chrono::milliseconds::max();
+  } else {
+    setInvalid(get_values_task::GetValuesTask::duration_ms_key_error_);
+    return;
+  }
+
+  String error = parseDeadband(parameters, deadband_);
+  if (!error.isEmpty()) {
+    setInvalid(error);
+  }
+}
+
+const String& PollSensorTemplate::getType() const {
+  return PollSensor::type();
+}
+
+BaseTask* PollSensorTemplate::start(const utils::UUID& task_id,
+                                    const JsonObjectConst& overrides,
+                                    Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) PollSensor(*this, task_id, overrides, scheduler);
+}
+
+std::chrono::milliseconds PollSensorTemplate::getInterval() const {
+  return interval_;
+}
+
+std::chrono::milliseconds PollSensorTemplate::getDuration() const {
+  return duration_;
+}
+
+const utils::Deadband& PollSensorTemplate::getDeadband() const {
+  return deadband_;
+}
 
 PollSensor::PollSensor(const JsonObjectConst& parameters, Scheduler& scheduler)
     : GetValuesTask(parameters, scheduler) {
@@ -30,30 +134,57 @@ PollSensor::PollSensor(const JsonObjectConst& parameters, Scheduler& scheduler)
     return;
   }
 
-  // Check if the peripheral supports the startMeasurement capability. Start a
-  // measurement if yes. Wait the returned amount of time to check the
-  // measurement state. If doesn't support it, enable the task without delay.
-  auto start_measurement_peripheral =
-      std::dynamic_pointer_cast<peripheral::capabilities::StartMeasurement>(
-          getPeripheral());
-  if (start_measurement_peripheral) {
-    auto result = start_measurement_peripheral->startMeasurement(parameters);
-    if (result.error.isError()) {
-      setInvalid(result.error.toString());
-      return;
-    }
-    enableDelayed(
-        std::chrono::duration_cast<std::chrono::milliseconds>(result.wait)
-            .count());
+  // Optionally only send readings which changed [default: send all]
+  String error = parseDeadband(parameters, deadband_);
+  if (!error.isEmpty()) {
+    setInvalid(error);
+    return;
+  }
+
+  startMeasurement(parameters);
+}
+
+PollSensor::PollSensor(const PollSensorTemplate& task_template,
+                       const utils::UUID& task_id,
+                       const JsonObjectConst& overrides, Scheduler& scheduler)
+    : GetValuesTask(task_template, task_id, scheduler),
+      interval_(task_template.getInterval()),
+      deadband_(task_template.getDeadband()) {
+  if (!isValid()) {
+    return;
+  }
+
+  // The interval and duration of the start command replace the template's
+  JsonVariantConst interval_ms = overrides[interval_ms_key_];
+  if (interval_ms.is<unsigned int>()) {
+    interval_ = std::chrono::milliseconds(interval_ms);
+  } else if (!interval_ms.isNull()) {
+    setInvalid(interval_ms_key_error_);
+    return;
+  }
+
+  std::chrono::milliseconds duration = task_template.getDuration();
+  JsonVariantConst duration_ms = overrides[duration_ms_key_];
+  if (duration_ms.is<unsigned int>()) {
+    duration = std::chrono::milliseconds(duration_ms);
+  } else if (!duration_ms.isNull()) {
+    setInvalid(duration_ms_key_error_);
+    return;
+  }
+  if (duration == std::chrono::milliseconds::max()) {
+    run_until_ = std::chrono::steady_clock::time_point::max();
   } else {
-    enable();
+    run_until_ = std::chrono::steady_clock::now() + duration;
   }
+
+  // The capability was already checked by the template
+  startMeasurement(task_template, overrides);
 }
 
 const String& PollSensor::getType() const { return type(); }
 
 const String& PollSensor::type() {
-  static const String name{"PollSensor"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -61,8 +192,9 @@ bool PollSensor::TaskCallback() {
   // If using a startMeasurement peripheral, handle the measurement. Delay
   // reading values if the result includes a wait duration. Otherwise, read the
   // values and send them to the server.
-  if (start_measurement_peripheral_) {
-    auto result = start_measurement_peripheral_->handleMeasurement();
+  auto start_measurement_peripheral = getStartMeasurementPeripheral();
+  if (start_measurement_peripheral) {
+    auto result = start_measurement_peripheral->handleMeasurement();
     if (result.error.isError()) {
       setInvalid(result.error.toString());
       return false;
@@ -75,21 +207,31 @@ bool PollSensor::TaskCallback() {
     }
   }
 
-  // Create a JSON doc on the heap
-  DynamicJsonDocument result_doc(BB_JSON_PAYLOAD_SIZE);
-  JsonObject result_object = result_doc.to<JsonObject>();
-
-  // Read the peripheral's value units and its UUID and add them to the JSON doc
-  ErrorResult error = makeTelemetryJson(result_object);
-
-  // Check if the values could be successfully read
-  if (error.isError()) {
-    setInvalid(error.toString());
+  // Read the peripheral's value units and check if the values could be
+  // successfully read
+  auto values = readValues();
+  if (values.error.isError()) {
+    setInvalid(values.error.toString());
     return false;
   }
 
-  // Send the value units and peripheral UUID to the server
-  Services::getServer().send(type(), result_doc);
+  // Skip the JSON doc entirely for readings within the deadband
+  if (deadband_.check(values.values, std::chrono::steady_clock::now())) {
+    // Borrow a JSON doc from the pool
+    auto result_doc_lease =
+        utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+    DynamicJsonDocument& result_doc = *result_doc_lease;
+    JsonObject result_object = result_doc.to<JsonObject>();
+
+    // Add the value units and the peripheral's UUID to the JSON doc
+    makeTelemetryJson(result_object, values.values);
+    if (deadband_.isEnabled()) {
+      result_object[suppressed_key_] = deadband_.getSuppressed();
+    }
+
+    // Send the value units and peripheral UUID to the server
+    Services::getServer().send(type(), result_doc);
+  }
 
   if (run_until_ < std::chrono::steady_clock::now()) {
     return false;
@@ -100,11 +242,14 @@ bool PollSensor::TaskCallback() {
   return true;
 }
 
-bool PollSensor::registered_ = TaskFactory::registerTask(type(), factory);
-
 BaseTask* PollSensor::factory(const JsonObjectConst& parameters,
-                              Scheduler& scheduler) {
-  return new PollSensor(parameters, scheduler);
+                              Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) PollSensor(parameters, scheduler);
+}
+
+std::unique_ptr<TaskTemplate> PollSensor::templateFactory(
+    const JsonObjectConst& parameters) {
+  return std::unique_ptr<TaskTemplate>(new PollSensorTemplate(parameters));
 }
 
 }  // namespace poll_sensor
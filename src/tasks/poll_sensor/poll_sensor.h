@@ -6,11 +6,41 @@
 
 #include "peripheral/capabilities/start_measurement.h"
 #include "tasks/get_values_task/get_values_task.h"
+#include "utils/deadband.h"
 
 namespace bernd_box {
 namespace tasks {
 namespace poll_sensor {
 
+/**
+ * Template of PollSensor tasks
+ *
+ * Stores the interval, the duration and the deadband. The interval and the
+ * duration can be overridden per task.
+ */
+class PollSensorTemplate : public get_values_task::GetValuesTemplate {
+ public:
+  PollSensorTemplate(const JsonObjectConst& parameters);
+  virtual ~PollSensorTemplate() = default;
+
+  const String& getType() const final;
+
+  BaseTask* start(const utils::UUID& task_id, const JsonObjectConst& overrides,
+                  Scheduler& scheduler, TaskPool& pool) final;
+
+  std::chrono::milliseconds getInterval() const;
+
+  /// The duration to poll the sensor or max() to poll it forever
+  std::chrono::milliseconds getDuration() const;
+
+  const utils::Deadband& getDeadband() const;
+
+ private:
+  std::chrono::milliseconds interval_;
+  std::chrono::milliseconds duration_;
+  utils::Deadband deadband_;
+};
+
 /**
  * Polls the sensor via the GetValues capability
  *
@@ -23,26 +53,42 @@ namespace poll_sensor {
  * The duration parameter specifies for how long the sensor should be polled.
  * If a measurement has started before the duration ends, it will be completed
  * and sent to the server.
+ *
+ * With the optional deadband and heartbeat parameters, readings are only sent
+ * if they changed by more than the deadband or the heartbeat expired. Each
+ * sent reading contains the number of readings suppressed before it.
  */
 class PollSensor : public get_values_task::GetValuesTask {
  public:
   PollSensor(const JsonObjectConst& parameters, Scheduler& scheduler);
+
+  /**
+   * Start the task from a template
+   *
+   * \param task_template The template with the validated parameters
+   * \param task_id The UUID of the task
+   * \param overrides JSON object with the parameters replacing the template's
+   * \param scheduler The scheduler that executes the task
+   */
+  PollSensor(const PollSensorTemplate& task_template,
+             const utils::UUID& task_id, const JsonObjectConst& overrides,
+             Scheduler& scheduler);
   virtual ~PollSensor() = default;
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "PollSensor";
   static const String& type();
+  static BaseTask* factory(const JsonObjectConst& parameters,
+                           Scheduler& scheduler, TaskPool& pool);
+  static std::unique_ptr<TaskTemplate> templateFactory(
+      const JsonObjectConst& parameters);
 
   bool TaskCallback() final;
 
  private:
-  static bool registered_;
-  static BaseTask* factory(const JsonObjectConst& parameters,
-                           Scheduler& scheduler);
-
   std::chrono::milliseconds interval_;
   std::chrono::steady_clock::time_point run_until_;
-  std::shared_ptr<peripheral::capabilities::StartMeasurement>
-      start_measurement_peripheral_ = nullptr;
+  utils::Deadband deadband_;
 };
 
 }  // namespace poll_sensor
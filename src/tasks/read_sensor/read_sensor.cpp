@@ -4,36 +4,44 @@ namespace bernd_box {
 namespace tasks {
 namespace read_sensor {
 
+ReadSensorTemplate::ReadSensorTemplate(const JsonObjectConst& parameters)
+    : GetValuesTemplate(parameters) {}
+
+const String& ReadSensorTemplate::getType() const {
+  return ReadSensor::type();
+}
+
+BaseTask* ReadSensorTemplate::start(const utils::UUID& task_id,
+                                    const JsonObjectConst& overrides,
+                                    Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) ReadSensor(*this, task_id, overrides, scheduler);
+}
+
 ReadSensor::ReadSensor(const JsonObjectConst& parameters, Scheduler& scheduler)
     : GetValuesTask(parameters, scheduler) {
   if (!isValid()) {
     return;
   }
 
-  // Check if the peripheral supports the startMeasurement capability. Start a
-  // measurement if yes. Wait the returned amount of time to check the
-  // measurement state. If doesn't support it, enable the task without delay.
-  auto start_measurement_peripheral =
-      std::dynamic_pointer_cast<peripheral::capabilities::StartMeasurement>(
-          getPeripheral());
-  if (start_measurement_peripheral) {
-    auto result = start_measurement_peripheral->startMeasurement(parameters);
-    if (result.error.isError()) {
-      setInvalid(result.error.toString());
-      return;
-    }
-    enableDelayed(
-        std::chrono::duration_cast<std::chrono::milliseconds>(result.wait)
-            .count());
-  } else {
-    enable();
+  startMeasurement(parameters);
+}
+
+ReadSensor::ReadSensor(const ReadSensorTemplate& task_template,
+                       const utils::UUID& task_id,
+                       const JsonObjectConst& overrides, Scheduler& scheduler)
+    : GetValuesTask(task_template, task_id, scheduler) {
+  if (!isValid()) {
+    return;
   }
+
+  // The capability was already checked by the template
+  startMeasurement(task_template, overrides);
 }
 
 const String& ReadSensor::getType() const { return type(); }
 
 const String& ReadSensor::type() {
-  static const String name{"ReadSensor"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -41,8 +49,9 @@ bool ReadSensor::TaskCallback() {
   // If using a startMeasurement peripheral, handle the measurement. Delay
   // reading values if the result includes a wait duration. Otherwise, read the
   // values and send them to the server.
-  if (start_measurement_peripheral_) {
-    auto result = start_measurement_peripheral_->handleMeasurement();
+  auto start_measurement_peripheral = getStartMeasurementPeripheral();
+  if (start_measurement_peripheral) {
+    auto result = start_measurement_peripheral->handleMeasurement();
     if (result.error.isError()) {
       setInvalid(result.error.toString());
       return false;
@@ -56,7 +65,9 @@ bool ReadSensor::TaskCallback() {
   }
 
   // Create the JSON doc
-  DynamicJsonDocument result_doc(BB_JSON_PAYLOAD_SIZE);
+  auto result_doc_lease =
+      utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& result_doc = *result_doc_lease;
   JsonObject result_object = result_doc.to<JsonObject>();
 
   // Insert the value units and peripheral UUID
@@ -71,11 +82,14 @@ bool ReadSensor::TaskCallback() {
   return false;
 }
 
-bool ReadSensor::registered_ = TaskFactory::registerTask(type(), factory);
-
 BaseTask* ReadSensor::factory(const JsonObjectConst& parameters,
-                              Scheduler& scheduler) {
-  return new ReadSensor(parameters, scheduler);
+                              Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) ReadSensor(parameters, scheduler);
+}
+
+std::unique_ptr<TaskTemplate> ReadSensor::templateFactory(
+    const JsonObjectConst& parameters) {
+  return std::unique_ptr<TaskTemplate>(new ReadSensorTemplate(parameters));
 }
 
 }  // namespace read_sensor
@@ -12,25 +12,49 @@ namespace bernd_box {
 namespace tasks {
 namespace read_sensor {
 
+/**
+ * Template of ReadSensor tasks
+ */
+class ReadSensorTemplate : public get_values_task::GetValuesTemplate {
+ public:
+  ReadSensorTemplate(const JsonObjectConst& parameters);
+  virtual ~ReadSensorTemplate() = default;
+
+  const String& getType() const final;
+
+  BaseTask* start(const utils::UUID& task_id, const JsonObjectConst& overrides,
+                  Scheduler& scheduler, TaskPool& pool) final;
+};
+
 /**
  * Read a single value from a sensor and return it via MQTT
  */
 class ReadSensor : public get_values_task::GetValuesTask {
  public:
   ReadSensor(const JsonObjectConst& parameters, Scheduler& scheduler);
+
+  /**
+   * Start the task from a template
+   *
+   * \param task_template The template with the validated parameters
+   * \param task_id The UUID of the task
+   * \param overrides JSON object with the parameters passed to the peripheral
+   * \param scheduler The scheduler that executes the task
+   */
+  ReadSensor(const ReadSensorTemplate& task_template,
+             const utils::UUID& task_id, const JsonObjectConst& overrides,
+             Scheduler& scheduler);
   virtual ~ReadSensor() = default;
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "ReadSensor";
   static const String& type();
+  static BaseTask* factory(const JsonObjectConst& parameters,
+                           Scheduler& scheduler, TaskPool& pool);
+  static std::unique_ptr<TaskTemplate> templateFactory(
+      const JsonObjectConst& parameters);
 
   bool TaskCallback() final;
-
- private:
-  static bool registered_;
-  static BaseTask* factory(const JsonObjectConst& parameters,
-                           Scheduler& scheduler);
-  std::shared_ptr<peripheral::capabilities::StartMeasurement>
-      start_measurement_peripheral_ = nullptr;
 };
 
 }  // namespace read_sensor
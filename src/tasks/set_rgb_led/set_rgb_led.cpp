@@ -27,10 +27,11 @@ SetRgbLed::SetRgbLed(const JsonObjectConst& parameters, Scheduler& scheduler)
 
   // Check that the peripheral supports the GetValue interface capability
   peripheral_ =
-      std::dynamic_pointer_cast<peripheral::capabilities::LedStrip>(peripheral);
+      peripheral::capabilityCast<peripheral::capabilities::LedStrip>(
+          peripheral);
   if (!peripheral_) {
     setInvalid(peripheral::capabilities::LedStrip::invalidTypeError(
-        peripheral_uuid_, peripheral));
+        peripheral_uuid_, *peripheral));
     return;
   }
 
@@ -88,7 +89,7 @@ SetRgbLed::SetRgbLed(const JsonObjectConst& parameters, Scheduler& scheduler)
 const String& SetRgbLed::getType() const { return type(); }
 
 const String& SetRgbLed::type() {
-  static const String name{"SetRgbLed"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -97,11 +98,9 @@ bool SetRgbLed::TaskCallback() {
   return false;
 }
 
-bool SetRgbLed::registered_ = TaskFactory::registerTask(type(), factory);
-
 BaseTask* SetRgbLed::factory(const JsonObjectConst& parameters,
-                             Scheduler& scheduler) {
-  return new SetRgbLed(parameters, scheduler);
+                             Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) SetRgbLed(parameters, scheduler);
 }
 
 const __FlashStringHelper* SetRgbLed::color_key_ = F("color");
@@ -2,10 +2,9 @@
 
 #include <ArduinoJson.h>
 
-#include <memory>
-
 #include "managers/services.h"
 #include "peripheral/capabilities/led_strip.h"
+#include "peripheral/peripheral_ref.h"
 #include "tasks/base_task.h"
 #include "utils/color.h"
 #include "utils/uuid.h"
@@ -20,16 +19,15 @@ class SetRgbLed : public BaseTask {
   virtual ~SetRgbLed() = default;
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "SetRgbLed";
   static const String& type();
+  static BaseTask* factory(const JsonObjectConst& parameters,
+                           Scheduler& scheduler, TaskPool& pool);
 
   bool TaskCallback() final;
 
  private:
-  static bool registered_;
-  static BaseTask* factory(const JsonObjectConst& parameters,
-                           Scheduler& scheduler);
-
-  std::shared_ptr<peripheral::capabilities::LedStrip> peripheral_;
+  peripheral::PeripheralRef<peripheral::capabilities::LedStrip> peripheral_;
   utils::UUID peripheral_uuid_;
 
   static const __FlashStringHelper* color_key_;
@@ -4,6 +4,70 @@ namespace bernd_box {
 namespace tasks {
 namespace set_value {
 
+SetValueTemplate::SetValueTemplate(const JsonObjectConst& parameters) {
+  peripheral_uuid_ = utils::UUID(parameters[BaseTask::peripheral_key_]);
+  if (!peripheral_uuid_.isValid()) {
+    setInvalid(BaseTask::peripheral_key_error_);
+    return;
+  }
+
+  auto peripheral =
+      Services::getPeripheralController().getPeripheral(peripheral_uuid_);
+  if (!peripheral) {
+    setInvalid(BaseTask::peripheralNotFoundError(peripheral_uuid_));
+    return;
+  }
+
+  // The capability check is done once for all tasks of the template
+  auto set_value_peripheral =
+      peripheral::capabilityCast<peripheral::capabilities::SetValue>(
+          peripheral);
+  if (!set_value_peripheral) {
+    setInvalid(peripheral::capabilities::SetValue::invalidTypeError(
+        peripheral_uuid_, *peripheral));
+    return;
+  }
+  peripheral_ = peripheral.getHandle();
+
+  JsonVariantConst value = parameters[utils::ValueUnit::value_key];
+  if (!value.is<float>()) {
+    setInvalid(value_unit_.value_key_error);
+    return;
+  }
+
+  utils::UUID data_point_type(
+      parameters[utils::ValueUnit::data_point_type_key]);
+  if (!data_point_type.isValid()) {
+    setInvalid(value_unit_.data_point_type_key_error);
+    return;
+  }
+
+  value_unit_ =
+      utils::ValueUnit{.value = value, .data_point_type = data_point_type};
+}
+
+const String& SetValueTemplate::getType() const { return SetValue::type(); }
+
+BaseTask* SetValueTemplate::start(const utils::UUID& task_id,
+                                  const JsonObjectConst& overrides,
+                                  Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) SetValue(*this, task_id, overrides, scheduler);
+}
+
+const utils::UUID& SetValueTemplate::getPeripheralUUID() const {
+  return peripheral_uuid_;
+}
+
+peripheral::PeripheralRef<peripheral::capabilities::SetValue>
+SetValueTemplate::getPeripheral() const {
+  return peripheral::capabilityCast<peripheral::capabilities::SetValue>(
+      Services::getPeripheralController().getPeripheral(peripheral_));
+}
+
+const utils::ValueUnit& SetValueTemplate::getValueUnit() const {
+  return value_unit_;
+}
+
 SetValue::SetValue(const JsonObjectConst& parameters, Scheduler& scheduler)
     : BaseTask(scheduler, parameters) {
   // Abort if the base class failed initialization
@@ -28,10 +92,11 @@ SetValue::SetValue(const JsonObjectConst& parameters, Scheduler& scheduler)
 
   // Check that the peripheral supports the SetValue interface capability
   peripheral_ =
-      std::dynamic_pointer_cast<peripheral::capabilities::SetValue>(peripheral);
+      peripheral::capabilityCast<peripheral::capabilities::SetValue>(
+          peripheral);
   if (!peripheral_) {
     setInvalid(peripheral::capabilities::SetValue::invalidTypeError(
-        peripheral_uuid, peripheral));
+        peripheral_uuid, *peripheral));
     return;
   }
 
@@ -57,10 +122,38 @@ SetValue::SetValue(const JsonObjectConst& parameters, Scheduler& scheduler)
   enable();
 }
 
+SetValue::SetValue(const SetValueTemplate& task_template,
+                   const utils::UUID& task_id, const JsonObjectConst& overrides,
+                   Scheduler& scheduler)
+    : BaseTask(scheduler, task_id),
+      peripheral_(task_template.getPeripheral()),
+      value_unit_(task_template.getValueUnit()) {
+  if (!isValid()) {
+    return;
+  }
+
+  // The peripheral may have been removed since the template was added
+  if (!peripheral_) {
+    setInvalid(peripheralNotFoundError(task_template.getPeripheralUUID()));
+    return;
+  }
+
+  // The value of the start command replaces the template's
+  JsonVariantConst value = overrides[utils::ValueUnit::value_key];
+  if (value.is<float>()) {
+    value_unit_.value = value;
+  } else if (!value.isNull()) {
+    setInvalid(value_unit_.value_key_error);
+    return;
+  }
+
+  enable();
+}
+
 const String& SetValue::getType() const { return type(); }
 
 const String& SetValue::type() {
-  static const String name{"SetValue"};
+  static const String name{type_name_};
   return name;
 }
 
@@ -69,11 +162,14 @@ bool SetValue::TaskCallback() {
   return false;
 }
 
-bool SetValue::registered_ = TaskFactory::registerTask(type(), factory);
-
 BaseTask* SetValue::factory(const JsonObjectConst& parameters,
-                            Scheduler& scheduler) {
-  return new SetValue(parameters, scheduler);
+                            Scheduler& scheduler, TaskPool& pool) {
+  return new (pool) SetValue(parameters, scheduler);
+}
+
+std::unique_ptr<TaskTemplate> SetValue::templateFactory(
+    const JsonObjectConst& parameters) {
+  return std::unique_ptr<TaskTemplate>(new SetValueTemplate(parameters));
 }
 
 }  // namespace set_value
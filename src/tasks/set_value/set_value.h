@@ -6,28 +6,76 @@
 
 #include "managers/services.h"
 #include "peripheral/capabilities/set_value.h"
+#include "peripheral/peripheral_ref.h"
 #include "tasks/base_task.h"
+#include "tasks/task_template.h"
 
 namespace bernd_box {
 namespace tasks {
 namespace set_value {
 
+/**
+ * Template of SetValue tasks
+ *
+ * Stores the peripheral and the value unit. The value can be overridden per
+ * task.
+ */
+class SetValueTemplate : public TaskTemplate {
+ public:
+  SetValueTemplate(const JsonObjectConst& parameters);
+  virtual ~SetValueTemplate() = default;
+
+  const String& getType() const final;
+
+  BaseTask* start(const utils::UUID& task_id, const JsonObjectConst& overrides,
+                  Scheduler& scheduler, TaskPool& pool) final;
+
+  const utils::UUID& getPeripheralUUID() const;
+
+  /**
+   * Gets the peripheral if it still exists
+   *
+   * \return The peripheral or a nullptr if it was removed
+   */
+  peripheral::PeripheralRef<peripheral::capabilities::SetValue>
+  getPeripheral() const;
+
+  const utils::ValueUnit& getValueUnit() const;
+
+ private:
+  utils::UUID peripheral_uuid_;
+  peripheral::PeripheralHandle peripheral_;
+  utils::ValueUnit value_unit_;
+};
+
 class SetValue : public BaseTask {
  public:
   SetValue(const JsonObjectConst& parameters, Scheduler& scheduler);
+
+  /**
+   * Start the task from a template
+   *
+   * \param task_template The template with the validated parameters
+   * \param task_id The UUID of the task
+   * \param overrides JSON object with the value replacing the template's
+   * \param scheduler The scheduler that executes the task
+   */
+  SetValue(const SetValueTemplate& task_template, const utils::UUID& task_id,
+           const JsonObjectConst& overrides, Scheduler& scheduler);
   virtual ~SetValue() = default;
 
   const String& getType() const final;
+  static constexpr const char* type_name_ = "SetValue";
   static const String& type();
+  static BaseTask* factory(const JsonObjectConst& parameters,
+                           Scheduler& scheduler, TaskPool& pool);
+  static std::unique_ptr<TaskTemplate> templateFactory(
+      const JsonObjectConst& parameters);
 
   bool TaskCallback() final;
 
  private:
-  static bool registered_;
-  static BaseTask* factory(const JsonObjectConst& parameters,
-                           Scheduler& scheduler);
-
-  std::shared_ptr<peripheral::capabilities::SetValue> peripheral_;
+  peripheral::PeripheralRef<peripheral::capabilities::SetValue> peripheral_;
 
   utils::ValueUnit value_unit_;
 };
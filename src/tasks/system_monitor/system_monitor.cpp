@@ -34,7 +34,8 @@ bool SystemMonitor::Callback() {
   size_t max_malloc_bytes = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
   size_t least_free_bytes = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
 
-  DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
+  auto doc_lease = utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& doc = *doc_lease;
   doc["free_memory_bytes"] = free_bytes;
   doc["heap_fragmentation_percent"] =
       (float(free_bytes) - float(max_malloc_bytes)) / float(free_bytes) *
@@ -50,11 +51,145 @@ bool SystemMonitor::Callback() {
   doc["productive_percent"] = 100 - ((cpuIdle + cpuCycles) / cpuTotal * 100.0);
   doc["wifi_rssi"] = WiFi.RSSI();
 
+  // Occupancy of the preallocated task memory per task type
+  JsonObject task_pools = doc.createNestedObject("task_pools");
+  for (const auto& usage : Services::getTaskFactory().getPoolUsage()) {
+    JsonObject pool = task_pools.createNestedObject(usage.type);
+    pool["used"] = usage.used;
+    pool["peak"] = usage.peak;
+    pool["capacity"] = usage.capacity;
+  }
+
+  // Usage of the JSON doc size classes
+  JsonArray json_pools = doc.createNestedArray("json_pools");
+  for (const auto& statistics : utils::JsonDocumentPool::getStatistics()) {
+    JsonObject pool = json_pools.createNestedObject();
+    pool["capacity"] = statistics.capacity;
+    pool["in_use"] = statistics.in_use;
+    pool["high_water"] = statistics.high_water;
+    pool["overflows"] = statistics.overflows;
+  }
+
+  // Delay of the task callbacks past their scheduled time per priority
+  JsonObject scheduling_latency = doc.createNestedObject("scheduling_latency");
+  addSchedulingLatency(scheduling_latency.createNestedObject("normal"),
+                       BaseTask::getSchedulingLatency(Priority::kNormal));
+  addSchedulingLatency(scheduling_latency.createNestedObject("high"),
+                       BaseTask::getSchedulingLatency(Priority::kHigh));
+  BaseTask::resetSchedulingLatency();
+
+  // Fill level of the journal holding the frames not sent while disconnected
+  const TelemetryJournal::Statistics journal_statistics =
+      Services::getTelemetryJournal().getStatistics();
+  JsonObject journal = doc.createNestedObject("journal");
+  journal["capacity_bytes"] = journal_statistics.capacity_bytes;
+  journal["used_bytes"] = journal_statistics.used_bytes;
+  journal["fill_percent"] =
+      journal_statistics.capacity_bytes
+          ? float(journal_statistics.used_bytes) /
+                float(journal_statistics.capacity_bytes) * float(100)
+          : float(0);
+  journal["pending_records"] = journal_statistics.pending_records;
+  journal["dropped_records"] = journal_statistics.dropped_records;
+
+  // Readings not sent by the tasks reporting by exception
+  doc["suppressed_readings"] = utils::Deadband::getTotalSuppressed();
+
   server_.sendSystem(doc.as<JsonObject>());
+
+  sendTaskProfiles();
   return true;
 }
 
+void SystemMonitor::addSchedulingLatency(JsonObject object,
+                                         const SchedulingLatency& latency) {
+  object["count"] = latency.count;
+  object["max_ms"] = latency.max_ms;
+  if (latency.count > 0) {
+    object["mean_ms"] = float(latency.total_ms) / float(latency.count);
+  } else {
+    object["mean_ms"] = nullptr;
+  }
+}
+
+void SystemMonitor::sendTaskProfiles() {
+  // Tasks which did not run since the last report are skipped
+  std::vector<BaseTask*> tasks;
+  for (const auto& entry : BaseTask::getTasks()) {
+    if (entry.second->getProfile().duration.getCount() > 0) {
+      tasks.push_back(entry.second);
+    }
+  }
+
+  auto doc_lease = utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& doc = *doc_lease;
+  doc["truncated"] = false;
+
+  // The scheduler measures the start delay and the overrun in milliseconds,
+  // so their histograms have coarser buckets than the durations
+  JsonArray bounds = doc.createNestedArray("bucket_bounds_us");
+  for (uint32_t bound : utils::DurationHistogram::getMicrosecondBounds()) {
+    bounds.add(bound);
+  }
+  JsonArray delay_bounds = doc.createNestedArray("delay_bucket_bounds_us");
+  for (uint32_t bound : utils::DurationHistogram::getMillisecondBounds()) {
+    delay_bounds.add(bound);
+  }
+
+  // Summary of the tasks with the longest callbacks
+  const size_t count = std::min(slowest_task_count_, tasks.size());
+  std::partial_sort(tasks.begin(), tasks.begin() + count, tasks.end(),
+                    [](const BaseTask* lhs, const BaseTask* rhs) {
+                      return lhs->getProfile().duration.getMax() >
+                             rhs->getProfile().duration.getMax();
+                    });
+  JsonArray slowest_tasks = doc.createNestedArray("slowest_tasks");
+  for (size_t i = 0; i < count; i++) {
+    const utils::DurationHistogram& duration = tasks[i]->getProfile().duration;
+    JsonObject object = slowest_tasks.createNestedObject();
+    object[BaseTask::task_id_key_] = tasks[i]->getTaskID();
+    object["type"] = tasks[i]->getType().c_str();
+    object["max_us"] = duration.getMax();
+    object["mean_us"] = duration.getMean();
+  }
+
+  JsonObject profiles = doc.createNestedObject("task_profiles");
+  for (BaseTask* task : tasks) {
+    const TaskProfile& profile = task->getProfile();
+
+    // The key is copied into the doc
+    char task_id[utils::UUID::string_size];
+    JsonObject object =
+        profiles.createNestedObject(task->getTaskID().toChars(task_id));
+    object["type"] = task->getType().c_str();
+    addHistogram(object.createNestedObject("duration"), profile.duration);
+    addHistogram(object.createNestedObject("start_delay"),
+                 profile.start_delay);
+    addHistogram(object.createNestedObject("overrun"), profile.overrun);
+
+    task->resetProfile();
+  }
+
+  // The profiles not fitting into the doc are incomplete or missing
+  if (doc.overflowed()) {
+    doc["truncated"] = true;
+  }
+  server_.sendSystem(doc.as<JsonObject>());
+}
+
+void SystemMonitor::addHistogram(JsonObject object,
+                                 const utils::DurationHistogram& histogram) {
+  object["count"] = histogram.getCount();
+  object["max_us"] = histogram.getMax();
+  object["mean_us"] = histogram.getMean();
+  JsonArray buckets = object.createNestedArray("buckets");
+  for (uint16_t bucket : histogram.getBuckets()) {
+    buckets.add(bucket);
+  }
+}
+
 const std::chrono::seconds SystemMonitor::default_interval_{60};
+const size_t SystemMonitor::slowest_task_count_ = 5;
 
 }  // namespace system_monitor
 }  // namespace tasks
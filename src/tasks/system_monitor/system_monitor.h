@@ -1,9 +1,17 @@
 #pragma once
 
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+
+#include <algorithm>
 #include <chrono>
+#include <vector>
 
 #include "TaskSchedulerDeclarations.h"
 #include "managers/services.h"
+#include "tasks/task_factory.h"
+#include "utils/deadband.h"
+#include "utils/json_document_pool.h"
 
 namespace bernd_box {
 namespace tasks {
@@ -40,6 +48,33 @@ class SystemMonitor : public Task {
    */
   bool Callback() final;
 
+  /**
+   * Adds the count, mean and maximum of a scheduling latency to the object
+   *
+   * \param object The JSON object to add the latency to
+   * \param latency The measured latency
+   */
+  static void addSchedulingLatency(JsonObject object,
+                                   const SchedulingLatency& latency);
+
+  /**
+   * Sends the execution profiles of the tasks that ran since the last report
+   * and restarts them
+   *
+   * The profiles are keyed by the task's UUID. A summary lists the tasks with
+   * the longest callbacks first.
+   */
+  void sendTaskProfiles();
+
+  /**
+   * Adds the count, mean, maximum and bucket counts of a histogram
+   *
+   * \param object The JSON object to add the histogram to
+   * \param histogram The histogram
+   */
+  static void addHistogram(JsonObject object,
+                           const utils::DurationHistogram& histogram);
+
   Scheduler* scheduler_;
   Server& server_;
   /// The suffix of the telemetry and action topic to publish on
@@ -47,6 +82,8 @@ class SystemMonitor : public Task {
 
   // Max time is ~72 minutes due to an overflow in the CPU load counter
   static const std::chrono::seconds default_interval_;
+  /// Number of tasks listed in the slowest tasks summary
+  static const size_t slowest_task_count_;
 };
 
 }  // namespace system_monitor
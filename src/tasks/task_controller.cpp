@@ -20,7 +20,9 @@ void TaskController::handleCallback(const JsonObjectConst& message) {
   }
 
   // Init the result doc with type and the request ID
-  DynamicJsonDocument result_doc(BB_JSON_PAYLOAD_SIZE);
+  auto result_doc_lease =
+      utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& result_doc = *result_doc_lease;
   result_doc[Server::type_key_] = Server::result_type_;
   JsonVariantConst request_id = message[Server::request_id_key_];
   if (request_id) {
@@ -28,6 +30,20 @@ void TaskController::handleCallback(const JsonObjectConst& message) {
   }
   JsonObject task_results = result_doc.createNestedObject(task_results_key_);
 
+  // Store the templates first, so that tasks of the same message can be
+  // started from them
+  JsonArrayConst template_commands =
+      task_commands[template_command_key_].as<JsonArrayConst>();
+  if (template_commands) {
+    JsonArray template_results =
+        task_results.createNestedArray(template_command_key_);
+    for (JsonVariantConst template_command : template_commands) {
+      ErrorResult error = factory_.addTemplate(template_command);
+      addTemplateResultEntry(template_command[template_command_key_], error,
+                             template_results);
+    }
+  }
+
   // Start a task for each command and store the result
   JsonArrayConst start_commands =
       task_commands[start_command_key_].as<JsonArrayConst>();
@@ -66,15 +82,18 @@ void TaskController::handleCallback(const JsonObjectConst& message) {
   server_.sendResults(result_doc.as<JsonObject>());
 }
 
+void TaskController::addFilterKeys(JsonObject filter) {
+  // The parameters of the commands depend on the task type
+  filter[task_command_key_] = true;
+  filter[Server::request_id_key_] = true;
+}
+
 std::vector<utils::UUID> TaskController::getTaskIDs() {
   std::vector<utils::UUID> task_ids;
+  task_ids.reserve(BaseTask::getTasks().size());
 
-  for (Task* task = scheduler_.getFirstTask(); task != NULL;
-       task = task->getNextTask()) {
-    BaseTask* base_task = dynamic_cast<BaseTask*>(task);
-    if (base_task) {
-      task_ids.push_back(base_task->getTaskID());
-    }
+  for (const auto& task : BaseTask::getTasks()) {
+    task_ids.push_back(task.first);
   }
 
   return task_ids;
@@ -96,7 +115,7 @@ ErrorResult TaskController::stopTask(const JsonObjectConst& parameters) {
     return ErrorResult(type(), BaseTask::task_id_key_error_);
   }
 
-  BaseTask* base_task = findTask(task_uuid);
+  BaseTask* base_task = BaseTask::findTask(task_uuid);
   if (base_task) {
     base_task->disable();
   } else {
@@ -107,44 +126,19 @@ ErrorResult TaskController::stopTask(const JsonObjectConst& parameters) {
 }
 
 void TaskController::sendStatus() {
-  DynamicJsonDocument doc(BB_JSON_PAYLOAD_SIZE);
+  auto doc_lease = utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& doc = *doc_lease;
   JsonObject status_object = doc.createNestedObject("status");
   JsonArray tasks_array = status_object.createNestedArray("tasks");
 
-  for (Task* task = scheduler_.iFirst; task; task = task->iNext) {
-    BaseTask* base_task = dynamic_cast<BaseTask*>(task);
-    if (base_task) {
-      JsonObject task_object = tasks_array.createNestedObject();
-      task_object["task"] = base_task->getTaskID().toString();
-      task_object["type"] = base_task->getType().c_str();
-    }
+  for (const auto& task : BaseTask::getTasks()) {
+    JsonObject task_object = tasks_array.createNestedObject();
+    task_object["task"] = task.first;
+    task_object["type"] = task.second->getType().c_str();
   }
   server_.send(type(), doc);
 }
 
-BaseTask* TaskController::findTask(const utils::UUID& uuid) {
-  // Go through all tasks in the scheduler
-  for (Task* task = scheduler_.iFirst; task; task = task->iNext) {
-    // Check if it is a base task
-    BaseTask* base_task = dynamic_cast<BaseTask*>(task);
-    // If the UUIDs match, return the task and end the search
-    if (base_task && base_task->getTaskID() == uuid) {
-      return base_task;
-    }
-  }
-
-  return nullptr;
-}
-
-const String& TaskController::getTaskType(Task* task) {
-  BaseTask* base_task = dynamic_cast<BaseTask*>(task);
-  if (base_task) {
-    return base_task->getType();
-  } else {
-    return task_type_system_task_;
-  }
-}
-
 void TaskController::addResultEntry(const JsonVariantConst& uuid,
                                     const ErrorResult& error,
                                     const JsonArray& results) {
@@ -168,11 +162,26 @@ void TaskController::addResultEntry(const utils::UUID& uuid,
 
   // Save whether the task could be started or the reason for failing
   if (error.isError()) {
-    result[BaseTask::task_id_key_] = uuid.toString();
+    result[BaseTask::task_id_key_] = uuid;
+    result[result_status_key_] = result_fail_name_;
+    result[result_detail_key_] = error.detail_;
+  } else {
+    result[BaseTask::task_id_key_] = uuid;
+    result[result_status_key_] = result_success_name_;
+  }
+}
+
+void TaskController::addTemplateResultEntry(const JsonVariantConst& handle,
+                                            const ErrorResult& error,
+                                            const JsonArray& results) {
+  JsonObject result = results.createNestedObject();
+  result[template_command_key_] = handle;
+
+  // Save whether the template could be stored or the reason for failing
+  if (error.isError()) {
     result[result_status_key_] = result_fail_name_;
     result[result_detail_key_] = error.detail_;
   } else {
-    result[BaseTask::task_id_key_] = uuid.toString();
     result[result_status_key_] = result_success_name_;
   }
 }
@@ -181,6 +190,8 @@ const __FlashStringHelper* TaskController::task_command_key_ = F("task");
 const __FlashStringHelper* TaskController::start_command_key_ = F("start");
 const __FlashStringHelper* TaskController::stop_command_key_ = F("stop");
 const __FlashStringHelper* TaskController::status_command_key_ = F("status");
+const __FlashStringHelper* TaskController::template_command_key_ =
+    F("template");
 
 const __FlashStringHelper* TaskController::task_results_key_ = F("task");
 const __FlashStringHelper* TaskController::result_status_key_ = F("status");
@@ -188,7 +199,5 @@ const __FlashStringHelper* TaskController::result_detail_key_ = F("detail");
 const __FlashStringHelper* TaskController::result_success_name_ = F("success");
 const __FlashStringHelper* TaskController::result_fail_name_ = F("fail");
 
-const String TaskController::task_type_system_task_{"SystemTask"};
-
 }  // namespace tasks
 }  // namespace bernd_box
\ No newline at end of file
@@ -4,10 +4,12 @@
 #include <TaskSchedulerDeclarations.h>
 
 #include <memory>
+#include <vector>
 
 #include "base_task.h"
 #include "managers/server.h"
 #include "task_factory.h"
+#include "utils/json_document_pool.h"
 
 namespace bernd_box {
 namespace tasks {
@@ -33,6 +35,13 @@ class TaskController {
    */
   void handleCallback(const JsonObjectConst& message);
 
+  /**
+   * Adds the keys of the messages read by handleCallback() to a filter
+   *
+   * \param filter The filter of a MessageParser
+   */
+  static void addFilterKeys(JsonObject filter);
+
   /**
    * Gets all currently running task IDs
    *
@@ -62,21 +71,14 @@ class TaskController {
    */
   void sendStatus();
 
-  /**
-   * Find the base task by UUID
-   *
-   * \param uuid The ID of the base task
-   * \return Pointer to the found base task
-   */
-  BaseTask* findTask(const utils::UUID& uuid);
-
-  const String& getTaskType(Task* task);
-
   static void addResultEntry(const JsonVariantConst& uuid,
                              const ErrorResult& error,
                              const JsonArray& results);
   static void addResultEntry(const utils::UUID& uuid, const ErrorResult& error,
                              const JsonArray& results);
+  static void addTemplateResultEntry(const JsonVariantConst& handle,
+                                     const ErrorResult& error,
+                                     const JsonArray& results);
 
   Scheduler& scheduler_;
   TaskFactory& factory_;
@@ -86,14 +88,13 @@ class TaskController {
   static const __FlashStringHelper* start_command_key_;
   static const __FlashStringHelper* stop_command_key_;
   static const __FlashStringHelper* status_command_key_;
+  static const __FlashStringHelper* template_command_key_;
   
   static const __FlashStringHelper* task_results_key_;
   static const __FlashStringHelper* result_status_key_;
   static const __FlashStringHelper* result_detail_key_;
   static const __FlashStringHelper* result_success_name_;
   static const __FlashStringHelper* result_fail_name_;
-
-  static const String task_type_system_task_;
 };
 }  // namespace tasks
 }  // namespace bernd_box
\ No newline at end of file
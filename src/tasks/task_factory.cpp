@@ -3,29 +3,58 @@
 namespace bernd_box {
 namespace tasks {
 
-TaskFactory::TaskFactory(Server& server, Scheduler& scheduler)
-    : server_(server), scheduler_(scheduler) {}
+TaskFactory::TaskFactory(Server& server, Scheduler& scheduler,
+                         Scheduler& high_priority_scheduler,
+                         size_t template_capacity)
+    : server_(server),
+      scheduler_(scheduler),
+      high_priority_scheduler_(high_priority_scheduler),
+      templates_(template_capacity) {
+  scheduler_.setHighPriorityScheduler(&high_priority_scheduler_);
+  BaseTask::setHighPriorityScheduler(high_priority_scheduler_);
+
+  pools_.reserve(types_.size());
+  for (const Entry& entry : types_) {
+    pools_.emplace_back(new TaskPool(entry.task_size, entry.pool_capacity));
+  }
+}
 
 const String& TaskFactory::type() {
   static const String name{"TaskFactory"};
   return name;
 }
 
-bool TaskFactory::registerTask(const String& type, Factory factory) {
-  return getFactories().insert({type, factory}).second;
-}
-
 BaseTask* TaskFactory::startTask(const JsonObjectConst& parameters) {
+  // Tasks started from a template skip the parsing of the full parameters
+  JsonVariantConst handle = parameters[template_key_];
+  if (!handle.isNull()) {
+    return startTemplateTask(handle, parameters);
+  }
+
   JsonVariantConst type = parameters[type_key_];
   if (type.isNull() || !type.is<char*>()) {
     return new InvalidTask(scheduler_, type_key_error_);
   }
 
   // Check if a factory for the type exists. Then try to start such a task
-  const auto& factory = getFactories().find(type);
-  if (factory != getFactories().end()) {
-    // Start a task via the respective task factory
-    return factory->second(parameters, scheduler_);
+  const Entry* entry = types_.find(type.as<const char*>());
+  if (entry) {
+    // The priority can be overridden per task. It selects the scheduler
+    Scheduler* scheduler = getScheduler(parameters, entry->priority);
+    if (!scheduler) {
+      return new InvalidTask(
+          scheduler_,
+          invalidPriorityError(parameters[priority_key_].as<String>()));
+    }
+
+    // Start a task via the respective task factory in the type's pool
+    TaskPool& pool = getPool(*entry);
+    BaseTask* task = entry->factory(parameters, *scheduler, pool);
+    if (!task) {
+      return new InvalidTask(
+          scheduler_, poolExhaustedError(entry->name, pool.getCapacity()));
+    }
+    return task;
   } else {
     // Factory type not found, so return an invalid task
     return new InvalidTask(scheduler_,
@@ -33,17 +62,116 @@ BaseTask* TaskFactory::startTask(const JsonObjectConst& parameters) {
   }
 }
 
+ErrorResult TaskFactory::addTemplate(const JsonObjectConst& parameters) {
+  JsonVariantConst handle_variant = parameters[template_key_];
+  if (!handle_variant.is<unsigned int>()) {
+    return ErrorResult(type(), template_key_error_);
+  }
+  const unsigned int handle = handle_variant;
+  if (handle >= templates_.size()) {
+    return ErrorResult(type(), templateHandleError(handle, templates_.size()));
+  }
+
+  // Clear the handle first, so that no tasks are started from an outdated
+  // template if the new one is invalid
+  TemplateSlot& slot = templates_[handle];
+  slot.task_template.reset();
+
+  JsonVariantConst task_type = parameters[type_key_];
+  if (task_type.isNull() || !task_type.is<char*>()) {
+    return ErrorResult(type(), type_key_error_);
+  }
+  const Entry* entry = types_.find(task_type.as<const char*>());
+  if (!entry) {
+    return ErrorResult(type(), invalidFactoryTypeError(task_type.as<char*>()));
+  }
+  if (!entry->template_factory) {
+    return ErrorResult(type(),
+                       templateUnsupportedError(task_type.as<char*>()));
+  }
+
+  Scheduler* scheduler = getScheduler(parameters, entry->priority);
+  if (!scheduler) {
+    return ErrorResult(
+        type(), invalidPriorityError(parameters[priority_key_].as<String>()));
+  }
+
+  // Validate the parameters, look up the peripheral and check its
+  // capabilities once for all tasks started from the template
+  std::unique_ptr<TaskTemplate> task_template =
+      entry->template_factory(parameters);
+  if (!task_template->isValid()) {
+    return task_template->getError();
+  }
+
+  slot.task_template = std::move(task_template);
+  slot.pool = &getPool(*entry);
+  slot.scheduler = scheduler;
+  return ErrorResult();
+}
+
 const std::vector<String> TaskFactory::getFactoryNames() {
   std::vector<String> names;
-  for (const auto& factory : getFactories()) {
-    names.push_back(factory.first);
+  for (const Entry& entry : types_) {
+    names.push_back(entry.name);
   }
   return names;
 }
 
-std::map<String, TaskFactory::Factory>& TaskFactory::getFactories() {
-  static std::map<String, Factory> factories;
-  return factories;
+std::vector<TaskFactory::PoolUsage> TaskFactory::getPoolUsage() const {
+  std::vector<PoolUsage> usages;
+  for (const Entry& entry : types_) {
+    const TaskPool& pool = *pools_[types_.indexOf(entry)];
+    usages.push_back(PoolUsage{entry.name, pool.getUsed(), pool.getPeak(),
+                               pool.getCapacity()});
+  }
+  return usages;
+}
+
+TaskPool& TaskFactory::getPool(const Entry& entry) {
+  return *pools_[types_.indexOf(entry)];
+}
+
+BaseTask* TaskFactory::startTemplateTask(const JsonVariantConst& handle,
+                                         const JsonObjectConst& parameters) {
+  if (!handle.is<unsigned int>()) {
+    return new InvalidTask(scheduler_, template_key_error_);
+  }
+  const unsigned int index = handle;
+  if (index >= templates_.size() || !templates_[index].task_template) {
+    return new InvalidTask(scheduler_, templateNotFoundError(index));
+  }
+  TemplateSlot& slot = templates_[index];
+
+  utils::UUID task_id(parameters[BaseTask::task_id_key_]);
+  if (!task_id.isValid()) {
+    return new InvalidTask(scheduler_, BaseTask::task_id_key_error_);
+  }
+
+  TaskPool& pool = *slot.pool;
+  BaseTask* task =
+      slot.task_template->start(task_id, parameters, *slot.scheduler, pool);
+  if (!task) {
+    return new InvalidTask(
+        scheduler_,
+        poolExhaustedError(slot.task_template->getType(), pool.getCapacity()));
+  }
+  return task;
+}
+
+Scheduler* TaskFactory::getScheduler(const JsonObjectConst& parameters,
+                                     Priority priority) {
+  JsonVariantConst priority_name = parameters[priority_key_];
+  if (!priority_name.isNull()) {
+    if (priority_name == "high") {
+      priority = Priority::kHigh;
+    } else if (priority_name == "normal") {
+      priority = Priority::kNormal;
+    } else {
+      return nullptr;
+    }
+  }
+  return priority == Priority::kHigh ? &high_priority_scheduler_ : &scheduler_;
 }
 
 String TaskFactory::invalidFactoryTypeError(const String& type) {
@@ -52,5 +180,41 @@ String TaskFactory::invalidFactoryTypeError(const String& type) {
   return error;
 }
 
+String TaskFactory::invalidPriorityError(const String& priority) {
+  String error(F("Invalid priority (high or normal): "));
+  error += priority;
+  return error;
+}
+
+String TaskFactory::poolExhaustedError(const String& type, size_t capacity) {
+  String error(F("Maximum number of running tasks reached: "));
+  error += type;
+  error += F(" (");
+  error += capacity;
+  error += F(")");
+  return error;
+}
+
+String TaskFactory::templateNotFoundError(unsigned int handle) {
+  String error(F("Could not find the template: "));
+  error += handle;
+  return error;
+}
+
+String TaskFactory::templateHandleError(unsigned int handle, size_t capacity) {
+  String error(F("Template handle out of range: "));
+  error += handle;
+  error += F(" (< ");
+  error += capacity;
+  error += F(")");
+  return error;
+}
+
+String TaskFactory::templateUnsupportedError(const String& type) {
+  String error(F("Task type does not support templates: "));
+  error += type;
+  return error;
+}
+
 }  // namespace tasks
 }  // namespace bernd_box
@@ -3,12 +3,15 @@
 #include <ArduinoJson.h>
 #include <TaskSchedulerDeclarations.h>
 
-#include <map>
 #include <memory>
+#include <vector>
 
 #include "base_task.h"
 #include "invalid_task.h"
 #include "managers/server.h"
+#include "task_pool.h"
+#include "task_template.h"
+#include "utils/type_table.h"
 
 namespace bernd_box {
 namespace tasks {
@@ -20,40 +23,98 @@ namespace tasks {
  */
 class TaskFactory {
  public:
-  /// Callback to start a task
-  using Factory = BaseTask* (*)(
-      const JsonObjectConst& parameters, Scheduler& scheduler);
+  /**
+   * Callback to start a task
+   *
+   * The task has to be created in the pool with `new (pool) Task(...)`. If
+   * the pool is exhausted, the callback has to return a nullptr.
+   */
+  using Factory = BaseTask* (*)(const JsonObjectConst& parameters,
+                                Scheduler& scheduler, TaskPool& pool);
+
+  /**
+   * Callback to create a task template
+   *
+   * The template has to validate the parameters and set itself invalid on
+   * errors.
+   */
+  using TemplateFactory =
+      std::unique_ptr<TaskTemplate> (*)(const JsonObjectConst& parameters);
+
+  /**
+   * A task type as listed in the type table
+   *
+   * The factory allocates a pool holding up to pool_capacity tasks of the
+   * type. Starting more tasks of the type at once fails with an error.
+   */
+  struct Entry {
+    /// Name of the task type
+    const char* name;
+    /// Callback to start a task
+    Factory factory;
+    /// Size of the task's class (sizeof)
+    size_t task_size;
+    /// Maximum number of tasks of the type at once
+    size_t pool_capacity;
+    /// Priority of the tasks if not set by the parameters
+    Priority priority;
+    /// Callback to create templates, nullptr if not supported by the type
+    TemplateFactory template_factory;
+  };
+
+  /// Occupancy of a task type's pool
+  struct PoolUsage {
+    String type;
+    size_t used;
+    size_t peak;
+    size_t capacity;
+  };
 
   /**
    * Start a task factory that forwards 'add' commands to the subfactories
    *
+   * Allocates the pools of all task types in the type table.
+   *
    * In order to delete tasks after they have ended, the task factory acts as
    * a task itself to delete the task object after it has been disabled.
    *
+   * The high priority scheduler is layered on top of the scheduler, so that
+   * its tasks are evaluated between every normal priority task callback.
+   *
    * @param server Server object to send success and error notifications
+   * @param scheduler Scheduler of the normal priority tasks
+   * @param high_priority_scheduler Scheduler of the high priority tasks
+   * @param template_capacity Maximum number of stored task templates
    */
-  TaskFactory(Server& server, Scheduler& scheduler);
+  TaskFactory(Server& server, Scheduler& scheduler,
+              Scheduler& high_priority_scheduler, size_t template_capacity);
   virtual ~TaskFactory() = default;
 
   static const String& type();
 
-  /**
-   * Register a task factory as a callback to start a task
-   *
-   * @param type Name of the task factory
-   * @param factory Callback to the task factory
-   * @return True on success --> no type by that name exists
-   */
-  static bool registerTask(const String& type, Factory factory);
-
   /**
    * Start a Task object from a JSON object by passing it to the subfactories
    *
+   * If the parameters contain a template handle, the task is started from the
+   * stored template instead. The other parameters then override the
+   * template's.
+   *
    * @param parameters JSON object with the parameters to start a task
    * @return True on success
    */
   BaseTask* startTask(const JsonObjectConst& parameters);
 
+  /**
+   * Validate the parameters of a task and store them as a template
+   *
+   * The template replaces any previous template with the same handle. If the
+   * parameters are invalid, the handle is left empty.
+   *
+   * @param parameters JSON object with the handle and the task's parameters
+   * @return The reason if the template could not be stored
+   */
+  ErrorResult addTemplate(const JsonObjectConst& parameters);
+
   /**
    * Return all registered factories by name
    * 
@@ -61,20 +122,76 @@ class TaskFactory {
    */
   const std::vector<String> getFactoryNames();
 
+  /**
+   * Return the pool occupancy of all registered factories
+   *
+   * \return A vector with the usage of each task type's pool
+   */
+  std::vector<PoolUsage> getPoolUsage() const;
+
  private:
-   
-  /// Get the callback map of the sub-factories to start new task objects
-  static std::map<String, Factory>& getFactories();
+  /// A stored template and where its tasks are started
+  struct TemplateSlot {
+    std::unique_ptr<TaskTemplate> task_template;
+    TaskPool* pool;
+    Scheduler* scheduler;
+  };
+
+  /**
+   * The known task types
+   *
+   * Defined in a single translation unit per build, which lists the types of
+   * the build. See task_types.cpp
+   */
+  static const utils::TypeTable<Entry> types_;
+
+  /// Get the pool of the tasks of a type
+  TaskPool& getPool(const Entry& entry);
+
+  /**
+   * Start a task from a stored template
+   *
+   * @param handle The handle of the template
+   * @param parameters JSON object with the task's UUID and the overrides
+   * @return The started task or an invalid task
+   */
+  BaseTask* startTemplateTask(const JsonVariantConst& handle,
+                              const JsonObjectConst& parameters);
+
+  /**
+   * Select the scheduler by the priority parameter
+   *
+   * @param parameters JSON object with the optional priority
+   * @param priority The priority if none is set by the parameters
+   * @return The scheduler or a nullptr if the priority is invalid
+   */
+  Scheduler* getScheduler(const JsonObjectConst& parameters,
+                          Priority priority);
 
   static String invalidFactoryTypeError(const String& type);
+  static String invalidPriorityError(const String& priority);
+  static String poolExhaustedError(const String& type, size_t capacity);
+  static String templateNotFoundError(unsigned int handle);
+  static String templateHandleError(unsigned int handle, size_t capacity);
+  static String templateUnsupportedError(const String& type);
 
   /// Reference to the Server interface
   Server& server_;
   /// Refernce to the Scheduler
   Scheduler& scheduler_;
+  /// Reference to the Scheduler of the high priority tasks
+  Scheduler& high_priority_scheduler_;
+  /// The pools of the task types, in the order of the type table
+  std::vector<std::unique_ptr<TaskPool>> pools_;
+  /// The stored templates, indexed by their handle
+  std::vector<TemplateSlot> templates_;
 
   const __FlashStringHelper* type_key_ = F("type");
   const __FlashStringHelper* type_key_error_ = F("Missing property: type (string)");
+  const __FlashStringHelper* priority_key_ = F("priority");
+  const __FlashStringHelper* template_key_ = F("template");
+  const __FlashStringHelper* template_key_error_ =
+      F("Wrong type for property: template (unsigned int)");
 };
 
 }  // namespace tasks
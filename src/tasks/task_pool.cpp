@@ -0,0 +1,74 @@
+#include "task_pool.h"
+
+#include <new>
+
+namespace bernd_box {
+namespace tasks {
+
+TaskPool::TaskPool(size_t object_size, size_t capacity)
+    : object_size_(object_size), capacity_(capacity) {
+  // Round the blocks up so that every header is aligned
+  const size_t header_size = sizeof(Header);
+  block_size_ = (header_size + object_size + header_size - 1) / header_size *
+                header_size;
+  blocks_.reset(new uint8_t[block_size_ * capacity_]);
+
+  // Chain all blocks into the free list
+  for (size_t i = capacity_; i > 0; i--) {
+    Header* header =
+        reinterpret_cast<Header*>(&blocks_[(i - 1) * block_size_]);
+    header->next_free = free_list_;
+    free_list_ = header;
+  }
+}
+
+void* TaskPool::allocate(size_t size) {
+  if (size > object_size_ || !free_list_) {
+    return nullptr;
+  }
+
+  Header* header = free_list_;
+  free_list_ = header->next_free;
+  header->pool = this;
+
+  used_++;
+  if (used_ > peak_) {
+    peak_ = used_;
+  }
+  return header + 1;
+}
+
+void* TaskPool::allocateHeap(size_t size) {
+  Header* header =
+      static_cast<Header*>(::operator new(sizeof(Header) + size));
+  header->pool = nullptr;
+  return header + 1;
+}
+
+void TaskPool::deallocate(void* object) {
+  if (!object) {
+    return;
+  }
+
+  Header* header = static_cast<Header*>(object) - 1;
+  TaskPool* pool = header->pool;
+  if (!pool) {
+    ::operator delete(header);
+    return;
+  }
+
+  header->next_free = pool->free_list_;
+  pool->free_list_ = header;
+  pool->used_--;
+}
+
+size_t TaskPool::getObjectSize() const { return object_size_; }
+
+size_t TaskPool::getCapacity() const { return capacity_; }
+
+size_t TaskPool::getUsed() const { return used_; }
+
+size_t TaskPool::getPeak() const { return peak_; }
+
+}  // namespace tasks
+}  // namespace bernd_box
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace bernd_box {
+namespace tasks {
+
+/**
+ * Fixed capacity pool of equally sized memory blocks for task objects
+ *
+ * The pool's memory is allocated once when the task type is registered, so
+ * that continuously starting and ending tasks does not fragment the heap.
+ * Allocating and freeing a block is O(1) via an intrusive free list.
+ *
+ * Every block, also those allocated from the heap, is preceded by a header
+ * pointing to its owning pool. This allows deallocate() to return the memory
+ * to the right place without knowing the task's type.
+ */
+class TaskPool {
+ public:
+  /**
+   * Allocate the memory for all blocks of the pool
+   *
+   * \param object_size The maximum size of an object stored in the pool
+   * \param capacity The number of objects the pool can hold
+   */
+  TaskPool(size_t object_size, size_t capacity);
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  /**
+   * Get a free block from the pool
+   *
+   * \param size The size of the object to be stored
+   * \return Pointer to the memory or a nullptr if exhausted or too large
+   */
+  void* allocate(size_t size);
+
+  /**
+   * Allocate an object with a header from the heap
+   *
+   * \param size The size of the object to be stored
+   * \return Pointer to the memory
+   */
+  static void* allocateHeap(size_t size);
+
+  /**
+   * Free an object allocated by allocate() or allocateHeap()
+   *
+   * \param object Pointer to the object's memory
+   */
+  static void deallocate(void* object);
+
+  /// The maximum size of an object stored in the pool
+  size_t getObjectSize() const;
+  /// The number of objects the pool can hold
+  size_t getCapacity() const;
+  /// The number of blocks currently in use
+  size_t getUsed() const;
+  /// The highest number of blocks that were in use at once
+  size_t getPeak() const;
+
+ private:
+  /// Precedes every object. Keeps the object aligned like plain new
+  union Header {
+    TaskPool* pool;
+    Header* next_free;
+    std::max_align_t align;
+  };
+
+  /// Size of a block including its header
+  size_t block_size_;
+  size_t object_size_;
+  size_t capacity_;
+  size_t used_ = 0;
+  size_t peak_ = 0;
+  /// Memory of all blocks
+  std::unique_ptr<uint8_t[]> blocks_;
+  /// Head of the list of unused blocks
+  Header* free_list_ = nullptr;
+};
+
+}  // namespace tasks
+}  // namespace bernd_box
@@ -14,7 +14,7 @@ const String& TaskRemovalTask::type() {
   return name;
 }
 
-void TaskRemovalTask::add(Task& pt) {
+void TaskRemovalTask::add(BaseTask& pt) {
   tasks_.insert(&pt);
   setIterations(1);
   enableIfNot();
@@ -25,27 +25,19 @@ bool TaskRemovalTask::Callback() {
     return true;
   }
 
-  DynamicJsonDocument result_doc(BB_JSON_PAYLOAD_SIZE);
+  auto result_doc_lease =
+      utils::JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+  DynamicJsonDocument& result_doc = *result_doc_lease;
   result_doc[Server::type_key_] = Server::result_type_;
   JsonObject task_results =
       result_doc.createNestedObject(TaskController::task_results_key_);
   JsonArray stop_results =
       task_results.createNestedArray(TaskController::stop_command_key_);
 
-  for (auto it = tasks_.begin(); it != tasks_.end();) {
-    Task* task = *it;
-
-    BaseTask* base_task = dynamic_cast<BaseTask*>(task);
-    if (base_task) {
-      TaskController::addResultEntry(base_task->getTaskID(),
-                                     base_task->getError(), stop_results);
-      delete base_task;
-      it = tasks_.erase(it);
-    } else {
-      server_.sendError(
-          ErrorResult(type(), F("Attempted to delete non-base class")));
-      ++it;
-    }
+  for (BaseTask* task : tasks_) {
+    TaskController::addResultEntry(task->getTaskID(), task->getError(),
+                                   stop_results);
+    delete task;
   }
   tasks_.clear();
   server_.sendResults(result_doc.as<JsonObject>());
@@ -6,6 +6,7 @@
 #include "tasks/base_task.h"
 #include "tasks/task_controller.h"
 #include "managers/server.h"
+#include "utils/json_document_pool.h"
 
 namespace bernd_box {
 namespace tasks {
@@ -31,7 +32,7 @@ class TaskRemovalTask : public Task {
    *
    * \param to_be_removed The task to be deleted and removed
    */
-  void add(Task& to_be_removed);
+  void add(BaseTask& to_be_removed);
 
  private:
   /**
@@ -42,7 +43,7 @@ class TaskRemovalTask : public Task {
   bool Callback();
 
   /// Queued tasks to be removed
-  std::set<Task*> tasks_;
+  std::set<BaseTask*> tasks_;
   /// Server to send messages to
   Server& server_;
 };
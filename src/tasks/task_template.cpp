@@ -0,0 +1,22 @@
+#include "task_template.h"
+
+namespace bernd_box {
+namespace tasks {
+
+bool TaskTemplate::isValid() const { return is_valid_; }
+
+ErrorResult TaskTemplate::getError() const {
+  if (is_valid_) {
+    return ErrorResult();
+  } else {
+    return ErrorResult(getType(), error_message_);
+  }
+}
+
+void TaskTemplate::setInvalid(const String& error_message) {
+  is_valid_ = false;
+  error_message_ = error_message;
+}
+
+}  // namespace tasks
+}  // namespace bernd_box
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <TaskSchedulerDeclarations.h>
+
+#include "base_task.h"
+#include "managers/error_result.h"
+#include "task_pool.h"
+#include "utils/uuid.h"
+
+namespace bernd_box {
+namespace tasks {
+
+/**
+ * A validated task configuration to start tasks from
+ *
+ * The template parses the parameters, looks up the peripheral and checks its
+ * capabilities once when it is added. Starting a task from it only takes the
+ * task's UUID and the few parameters which may be overridden per task.
+ */
+class TaskTemplate {
+ public:
+  TaskTemplate() = default;
+  virtual ~TaskTemplate() = default;
+
+  /// The type of the tasks started from the template
+  virtual const String& getType() const = 0;
+
+  /**
+   * Start a task from the template
+   *
+   * The task has to be created in the pool with `new (pool) Task(...)`. If
+   * the pool is exhausted, a nullptr has to be returned.
+   *
+   * \param task_id The UUID of the new task
+   * \param overrides JSON object with the parameters replacing the template's
+   * \param scheduler The scheduler that executes the task
+   * \param pool The pool of the task's type
+   * \return The started task or a nullptr
+   */
+  virtual BaseTask* start(const utils::UUID& task_id,
+                          const JsonObjectConst& overrides,
+                          Scheduler& scheduler, TaskPool& pool) = 0;
+
+  /**
+   * Check if the parameters of the template were valid
+   *
+   * \return True if tasks can be started from the template
+   */
+  bool isValid() const;
+
+  /**
+   * Gets the reason for the template being invalid
+   *
+   * \return The template's error state
+   */
+  ErrorResult getError() const;
+
+ protected:
+  /**
+   * Mark the template as being invalid and the cause
+   *
+   * \param error_message The cause for being invalid
+   */
+  void setInvalid(const String& error_message);
+
+ private:
+  /// Whether the template is in a valid or invalid state
+  bool is_valid_ = true;
+  /// The cause for being in an invalid state
+  String error_message_;
+};
+
+}  // namespace tasks
+}  // namespace bernd_box
@@ -0,0 +1,41 @@
+#include "task_types.h"
+
+namespace bernd_box {
+namespace tasks {
+namespace {
+
+/// To add a task type, list it here with the capacity of its pool
+constexpr TaskFactory::Entry task_types[] = {
+    {aggregate_sensor::AggregateSensor::type_name_,
+     aggregate_sensor::AggregateSensor::factory,
+     sizeof(aggregate_sensor::AggregateSensor), 8, Priority::kHigh, nullptr},
+    {alert_sensor::AlertSensor::type_name_, alert_sensor::AlertSensor::factory,
+     sizeof(alert_sensor::AlertSensor), 32, Priority::kHigh, nullptr},
+    {DummyTask::type_name_, DummyTask::factory, sizeof(DummyTask), 2,
+     Priority::kNormal, nullptr},
+    {poll_group::PollGroup::type_name_, poll_group::PollGroup::factory,
+     sizeof(poll_group::PollGroup), 8, Priority::kHigh, nullptr},
+    {poll_sensor::PollSensor::type_name_, poll_sensor::PollSensor::factory,
+     sizeof(poll_sensor::PollSensor), 32, Priority::kHigh,
+     poll_sensor::PollSensor::templateFactory},
+    {read_sensor::ReadSensor::type_name_, read_sensor::ReadSensor::factory,
+     sizeof(read_sensor::ReadSensor), 8, Priority::kNormal,
+     read_sensor::ReadSensor::templateFactory},
+    {set_rgb_led::SetRgbLed::type_name_, set_rgb_led::SetRgbLed::factory,
+     sizeof(set_rgb_led::SetRgbLed), 4, Priority::kNormal, nullptr},
+    {set_value::SetValue::type_name_, set_value::SetValue::factory,
+     sizeof(set_value::SetValue), 8, Priority::kNormal,
+     set_value::SetValue::templateFactory},
+};
+
+constexpr auto task_types_hash = utils::makePerfectHash(task_types);
+static_assert(task_types_hash.isValid(),
+              "The names of the task types are not unique");
+
+}  // namespace
+
+const utils::TypeTable<TaskFactory::Entry> TaskFactory::types_{
+    task_types, task_types_hash};
+
+}  // namespace tasks
+}  // namespace bernd_box
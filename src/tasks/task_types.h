@@ -0,0 +1,18 @@
+#pragma once
+
+/**
+ * The task types of the firmware
+ *
+ * Includes all tasks listed in the TaskFactory's type table.
+ */
+
+#include "peripheral/peripherals/dummy/dummy_peripheral.h"
+#include "tasks/aggregate_sensor/aggregate_sensor.h"
+#include "tasks/alert_sensor/alert_sensor.h"
+#include "tasks/poll_group/poll_group.h"
+#include "tasks/poll_sensor/poll_sensor.h"
+#include "tasks/read_sensor/read_sensor.h"
+#include "tasks/set_rgb_led/set_rgb_led.h"
+#include "tasks/set_value/set_value.h"
+#include "tasks/task_factory.h"
+#include "utils/type_table.h"
@@ -0,0 +1,30 @@
+#include "backoff.h"
+
+namespace bernd_box {
+namespace utils {
+
+Backoff::Backoff(std::chrono::milliseconds min_delay,
+                 std::chrono::milliseconds max_delay)
+    : min_delay_(min_delay), max_delay_(max_delay), delay_(min_delay) {}
+
+std::chrono::milliseconds Backoff::fail() {
+  if (failures_ > 0) {
+    delay_ = std::min(delay_ * 2, max_delay_);
+  }
+  failures_++;
+
+  // Wait between half and the full delay
+  const uint32_t half = delay_.count() / 2;
+  return std::chrono::milliseconds(delay_.count() - half +
+                                   (half ? esp_random() % (half + 1) : 0));
+}
+
+void Backoff::reset() {
+  failures_ = 0;
+  delay_ = min_delay_;
+}
+
+uint32_t Backoff::getFailures() const { return failures_; }
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Exponential backoff with jitter between connection attempts
+ *
+ * The delay doubles with every failed attempt up to the maximum. A random
+ * jitter of up to half the delay spreads the reconnects of many controllers
+ * after an outage of the server or access point.
+ */
+class Backoff {
+ public:
+  /**
+   * \param min_delay The delay after the first failed attempt
+   * \param max_delay The upper bound of the delay
+   */
+  Backoff(std::chrono::milliseconds min_delay,
+          std::chrono::milliseconds max_delay);
+
+  /**
+   * Registers a failed attempt
+   *
+   * \return The delay until the next attempt
+   */
+  std::chrono::milliseconds fail();
+
+  /**
+   * Starts over with the minimum delay after a successful attempt
+   */
+  void reset();
+
+  /// Number of failed attempts since the last reset
+  uint32_t getFailures() const;
+
+ private:
+  const std::chrono::milliseconds min_delay_;
+  const std::chrono::milliseconds max_delay_;
+
+  uint32_t failures_ = 0;
+  /// The delay before adding the jitter
+  std::chrono::milliseconds delay_;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
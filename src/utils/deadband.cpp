@@ -0,0 +1,58 @@
+#include "deadband.h"
+
+namespace bernd_box {
+namespace utils {
+
+Deadband::Deadband(float absolute, float relative,
+                   std::chrono::milliseconds heartbeat)
+    : is_enabled_(true),
+      absolute_(absolute),
+      relative_(relative),
+      heartbeat_(heartbeat) {}
+
+bool Deadband::isEnabled() const { return is_enabled_; }
+
+bool Deadband::check(const std::vector<ValueUnit>& values,
+                     std::chrono::steady_clock::time_point now) {
+  // The first reading and readings with other data points are always reported
+  const bool is_heartbeat_due =
+      heartbeat_.count() > 0 && now - reported_at_ >= heartbeat_;
+  bool is_reported = !is_enabled_ || reported_.empty() ||
+                     reported_.size() != values.size() || is_heartbeat_due;
+  for (size_t i = 0; !is_reported && i < values.size(); i++) {
+    is_reported = isOutside(values[i].value, reported_[i]);
+  }
+
+  if (!is_reported) {
+    suppressed_++;
+    total_suppressed_++;
+    return false;
+  }
+
+  reported_.resize(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    reported_[i] = values[i].value;
+  }
+  reported_at_ = now;
+  last_suppressed_ = suppressed_;
+  suppressed_ = 0;
+  return true;
+}
+
+uint32_t Deadband::getSuppressed() const { return last_suppressed_; }
+
+uint32_t Deadband::getTotalSuppressed() { return total_suppressed_; }
+
+bool Deadband::isOutside(float value, float reported) const {
+  // Readings becoming or ceasing to be NaN are always reported
+  if (std::isnan(value) || std::isnan(reported)) {
+    return std::isnan(value) != std::isnan(reported);
+  }
+  const float band = std::max(absolute_, relative_ * std::fabs(reported));
+  return std::fabs(value - reported) > band;
+}
+
+uint32_t Deadband::total_suppressed_ = 0;
+
+}  // namespace utils
+}  // namespace bernd_box
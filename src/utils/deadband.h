@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "value_unit.h"
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Decides which readings to report when reporting by exception
+ *
+ * A reading is reported if any of its data points moved out of the band
+ * around the value that was last reported for it. The band is the larger of
+ * the absolute deadband and the relative deadband times the reported value.
+ * Comparing against the reported instead of the previous value keeps slow
+ * drifts from going unreported. The heartbeat reports a reading after the
+ * maximum silence even if nothing changed.
+ */
+class Deadband {
+ public:
+  /**
+   * Reports every reading
+   */
+  Deadband() = default;
+
+  /**
+   * \param absolute Minimum change of a data point to report a reading
+   * \param relative Minimum change relative to the reported value
+   * \param heartbeat Maximum time between two reported readings. 0 for no
+   *                  heartbeat
+   */
+  Deadband(float absolute, float relative,
+           std::chrono::milliseconds heartbeat);
+
+  /// Whether readings can be suppressed
+  bool isEnabled() const;
+
+  /**
+   * Checks if a reading has to be reported and counts it as suppressed if not
+   *
+   * \param values The data points of the reading
+   * \param now The time of the reading
+   * \return True if the reading is to be reported
+   */
+  bool check(const std::vector<ValueUnit>& values,
+             std::chrono::steady_clock::time_point now);
+
+  /// Number of readings suppressed before the last reported one
+  uint32_t getSuppressed() const;
+
+  /// Number of readings suppressed by all deadbands since the start
+  static uint32_t getTotalSuppressed();
+
+ private:
+  /**
+   * Checks if a data point moved out of the band around its reported value
+   *
+   * \param value The current value
+   * \param reported The last reported value
+   * \return True if the value changed by more than the band
+   */
+  bool isOutside(float value, float reported) const;
+
+  bool is_enabled_ = false;
+  float absolute_ = 0;
+  float relative_ = 0;
+  std::chrono::milliseconds heartbeat_{0};
+
+  /// The values of the last reported reading
+  std::vector<float> reported_;
+  std::chrono::steady_clock::time_point reported_at_;
+
+  /// Readings suppressed since the last reported one
+  uint32_t suppressed_ = 0;
+  uint32_t last_suppressed_ = 0;
+  static uint32_t total_suppressed_;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
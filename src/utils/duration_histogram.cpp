@@ -0,0 +1,62 @@
+#include "duration_histogram.h"
+
+#include <limits>
+
+namespace bernd_box {
+namespace utils {
+
+DurationHistogram::DurationHistogram(const Bounds& bounds)
+    : bounds_(&bounds) {}
+
+void DurationHistogram::add(uint32_t duration_us) {
+  const Bounds& bounds = *bounds_;
+  size_t bucket = 0;
+  while (bucket < bounds.size() && duration_us >= bounds[bucket]) {
+    bucket++;
+  }
+  if (buckets_[bucket] < std::numeric_limits<uint16_t>::max()) {
+    buckets_[bucket]++;
+  }
+
+  count_++;
+  total_ += duration_us;
+  if (duration_us > max_) {
+    max_ = duration_us;
+  }
+}
+
+void DurationHistogram::clear() { *this = DurationHistogram(*bounds_); }
+
+uint32_t DurationHistogram::getCount() const { return count_; }
+
+uint32_t DurationHistogram::getMax() const { return max_; }
+
+float DurationHistogram::getMean() const {
+  if (count_ == 0) {
+    return 0;
+  }
+  return float(total_) / float(count_);
+}
+
+const std::array<uint16_t, DurationHistogram::bucket_count>&
+DurationHistogram::getBuckets() const {
+  return buckets_;
+}
+
+const DurationHistogram::Bounds& DurationHistogram::getBounds() const {
+  return *bounds_;
+}
+
+const DurationHistogram::Bounds& DurationHistogram::getMicrosecondBounds() {
+  static const Bounds bounds{{100, 300, 1000, 3000, 10000, 30000, 100000}};
+  return bounds;
+}
+
+const DurationHistogram::Bounds& DurationHistogram::getMillisecondBounds() {
+  static const Bounds bounds{
+      {1000, 3000, 10000, 30000, 100000, 300000, 1000000}};
+  return bounds;
+}
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Histogram of durations with fixed buckets
+ *
+ * The buckets grow roughly by a factor of three, with a last bucket for
+ * everything longer. The counts of the buckets saturate instead of
+ * overflowing. The maximum and mean are kept exactly.
+ */
+class DurationHistogram {
+ public:
+  static constexpr size_t bucket_count = 8;
+
+  /// Exclusive upper bounds of the buckets in microseconds
+  using Bounds = std::array<uint32_t, bucket_count - 1>;
+
+  /**
+   * \param bounds The bounds of the buckets, e.g. getMicrosecondBounds()
+   */
+  explicit DurationHistogram(const Bounds& bounds = getMicrosecondBounds());
+
+  /**
+   * Adds a duration to its bucket
+   *
+   * \param duration_us The duration in microseconds
+   */
+  void add(uint32_t duration_us);
+
+  /**
+   * Removes all durations
+   */
+  void clear();
+
+  /// Number of added durations
+  uint32_t getCount() const;
+
+  /// Longest added duration in microseconds
+  uint32_t getMax() const;
+
+  /// Mean of the added durations in microseconds, 0 if empty
+  float getMean() const;
+
+  /// Number of durations in each bucket
+  const std::array<uint16_t, bucket_count>& getBuckets() const;
+
+  /**
+   * Gets the exclusive upper bounds of the buckets. The last bucket is open
+   *
+   * \return The bounds in microseconds
+   */
+  const Bounds& getBounds() const;
+
+  /// Bounds from 100 us to 100 ms for durations measured in microseconds
+  static const Bounds& getMicrosecondBounds();
+
+  /// Bounds from 1 ms to 1 s for durations measured in milliseconds
+  static const Bounds& getMillisecondBounds();
+
+ private:
+  const Bounds* bounds_;
+  std::array<uint16_t, bucket_count> buckets_{};
+  uint32_t count_ = 0;
+  uint32_t max_ = 0;
+  uint64_t total_ = 0;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
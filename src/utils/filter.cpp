@@ -0,0 +1,285 @@
+#include "filter.h"
+
+namespace bernd_box {
+namespace utils {
+
+float median(float* begin, float* end) {
+  const size_t count = end - begin;
+  if (count == 0) {
+    return NAN;
+  }
+
+  // The lower middle value is the largest of the lower half after
+  // partitioning around the upper middle value
+  float* upper = begin + count / 2;
+  std::nth_element(begin, upper, end);
+  if (count % 2 == 1) {
+    return *upper;
+  }
+  return (*std::max_element(begin, upper) + *upper) / 2;
+}
+
+MovingAverage::MovingAverage(size_t window) : samples_(window) {}
+
+float MovingAverage::add(float value) {
+  if (std::isnan(value)) {
+    return count_ ? sum_ / count_ : NAN;
+  }
+
+  if (count_ < samples_.size()) {
+    count_++;
+  } else {
+    sum_ -= samples_[index_];
+  }
+  samples_[index_] = value;
+  sum_ += value;
+  index_ = (index_ + 1) % samples_.size();
+  return sum_ / count_;
+}
+
+void MovingAverage::clear() {
+  count_ = 0;
+  index_ = 0;
+  sum_ = 0;
+}
+
+std::unique_ptr<Filter> MovingAverage::clone() const {
+  return std::unique_ptr<Filter>(new MovingAverage(samples_.size()));
+}
+
+Ewma::Ewma(float alpha) : alpha_(alpha) {}
+
+float Ewma::add(float value) {
+  if (std::isnan(value)) {
+    return output_;
+  }
+
+  if (std::isnan(output_)) {
+    output_ = value;
+  } else {
+    output_ += alpha_ * (value - output_);
+  }
+  return output_;
+}
+
+void Ewma::clear() { output_ = NAN; }
+
+std::unique_ptr<Filter> Ewma::clone() const {
+  return std::unique_ptr<Filter>(new Ewma(alpha_));
+}
+
+SlidingMedian::SlidingMedian(size_t window)
+    : window_(window), samples_(window), positions_(window), heap_(window) {
+  clear();
+}
+
+float SlidingMedian::add(float value) {
+  if (std::isnan(value)) {
+    return getMedian();
+  }
+
+  // Replace the oldest sample at its heap position
+  const bool is_new = count_ < window_;
+  const int position = positions_[index_];
+  const float old = samples_[index_];
+  samples_[index_] = value;
+  index_ = (index_ + 1) % window_;
+  if (is_new) {
+    count_++;
+  }
+
+  // Restore the heap properties, moving the sample across the median if it
+  // belongs to the other half
+  if (position > 0) {
+    if (!is_new && old < value) {
+      minSortDown(position * 2);
+    } else if (minSortUp(position)) {
+      maxSortDown(-1);
+    }
+  } else if (position < 0) {
+    if (!is_new && value < old) {
+      maxSortDown(position * 2);
+    } else if (maxSortUp(position)) {
+      minSortDown(1);
+    }
+  } else {
+    if (getMaxCount()) {
+      maxSortDown(-1);
+    }
+    if (getMinCount()) {
+      minSortDown(1);
+    }
+  }
+  return getMedian();
+}
+
+void SlidingMedian::clear() {
+  count_ = 0;
+  index_ = 0;
+
+  // Fill the positions alternating around the median: 0, -1, 1, -2, 2, ...
+  for (int i = 0; i < window_; i++) {
+    positions_[i] = ((i + 1) / 2) * (i % 2 ? -1 : 1);
+    heap(positions_[i]) = i;
+  }
+}
+
+std::unique_ptr<Filter> SlidingMedian::clone() const {
+  return std::unique_ptr<Filter>(new SlidingMedian(window_));
+}
+
+float SlidingMedian::getMedian() const {
+  if (count_ == 0) {
+    return NAN;
+  }
+
+  const float median = samples_[heap(0)];
+  if (count_ % 2 == 0) {
+    return (median + samples_[heap(-1)]) / 2;
+  }
+  return median;
+}
+
+size_t SlidingMedian::getCount() const { return count_; }
+
+int& SlidingMedian::heap(int position) {
+  return heap_[position + window_ / 2];
+}
+
+int SlidingMedian::heap(int position) const {
+  return heap_[position + window_ / 2];
+}
+
+int SlidingMedian::getMinCount() const { return (count_ - 1) / 2; }
+
+int SlidingMedian::getMaxCount() const { return count_ / 2; }
+
+bool SlidingMedian::isLess(int position_a, int position_b) const {
+  return samples_[heap(position_a)] < samples_[heap(position_b)];
+}
+
+void SlidingMedian::exchange(int position_a, int position_b) {
+  std::swap(heap(position_a), heap(position_b));
+  positions_[heap(position_a)] = position_a;
+  positions_[heap(position_b)] = position_b;
+}
+
+bool SlidingMedian::exchangeIfLess(int position_a, int position_b) {
+  if (isLess(position_a, position_b)) {
+    exchange(position_a, position_b);
+    return true;
+  }
+  return false;
+}
+
+void SlidingMedian::minSortDown(int position) {
+  // The children of position i are 2i and 2i + 1, except for the median
+  for (; position <= getMinCount(); position *= 2) {
+    if (position > 1 && position < getMinCount() &&
+        isLess(position + 1, position)) {
+      position++;
+    }
+    if (!exchangeIfLess(position, position / 2)) {
+      break;
+    }
+  }
+}
+
+void SlidingMedian::maxSortDown(int position) {
+  // The children of position -i are -2i and -2i - 1, except for the median
+  for (; position >= -getMaxCount(); position *= 2) {
+    if (position < -1 && position > -getMaxCount() &&
+        isLess(position, position - 1)) {
+      position--;
+    }
+    if (!exchangeIfLess(position / 2, position)) {
+      break;
+    }
+  }
+}
+
+bool SlidingMedian::minSortUp(int position) {
+  while (position > 0 && exchangeIfLess(position, position / 2)) {
+    position /= 2;
+  }
+  return position == 0;
+}
+
+bool SlidingMedian::maxSortUp(int position) {
+  while (position < 0 && exchangeIfLess(position / 2, position)) {
+    position /= 2;
+  }
+  return position == 0;
+}
+
+HampelFilter::HampelFilter(size_t window, float threshold)
+    : median_(window),
+      threshold_(threshold),
+      samples_(window),
+      deviations_(window) {}
+
+float HampelFilter::add(float value) {
+  if (std::isnan(value)) {
+    return output_;
+  }
+
+  samples_[index_] = value;
+  index_ = (index_ + 1) % samples_.size();
+  const float median = median_.add(value);
+
+  // The median absolute deviation is robust against the outliers themselves
+  const size_t count = median_.getCount();
+  for (size_t i = 0; i < count; i++) {
+    deviations_[i] = std::fabs(samples_[i] - median);
+  }
+  const float mad =
+      utils::median(deviations_.data(), deviations_.data() + count);
+
+  if (std::fabs(value - median) > threshold_ * mad_scale_ * mad) {
+    output_ = median;
+  } else {
+    output_ = value;
+  }
+  return output_;
+}
+
+void HampelFilter::clear() {
+  median_.clear();
+  index_ = 0;
+  output_ = NAN;
+}
+
+std::unique_ptr<Filter> HampelFilter::clone() const {
+  return std::unique_ptr<Filter>(
+      new HampelFilter(samples_.size(), threshold_));
+}
+
+void FilterChain::append(std::unique_ptr<Filter> filter) {
+  filters_.push_back(std::move(filter));
+}
+
+bool FilterChain::isEmpty() const { return filters_.empty(); }
+
+float FilterChain::add(float value) {
+  for (auto& filter : filters_) {
+    value = filter->add(value);
+  }
+  return value;
+}
+
+void FilterChain::clear() {
+  for (auto& filter : filters_) {
+    filter->clear();
+  }
+}
+
+std::unique_ptr<Filter> FilterChain::clone() const {
+  std::unique_ptr<FilterChain> chain(new FilterChain());
+  for (const auto& filter : filters_) {
+    chain->append(filter->clone());
+  }
+  return chain;
+}
+
+}  // namespace utils
+}  // namespace bernd_box
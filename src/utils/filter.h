@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Gets the median of values by partially reordering them
+ *
+ * Takes linear time instead of sorting the values.
+ *
+ * \param begin Iterator to the first value
+ * \param end Iterator past the last value
+ * \return The median, the mean of the two middle values for an even count or
+ *         NaN if empty
+ */
+float median(float* begin, float* end);
+
+/**
+ * Streaming filter of a signal
+ *
+ * The memory is allocated on construction, so that adding samples never
+ * allocates. NaN samples are skipped and return the last output.
+ */
+class Filter {
+ public:
+  virtual ~Filter() = default;
+
+  /**
+   * Adds a sample and gets the filtered value
+   *
+   * \param value The new sample
+   * \return The filtered value, NaN before the first sample
+   */
+  virtual float add(float value) = 0;
+
+  /**
+   * Removes all samples
+   */
+  virtual void clear() = 0;
+
+  /**
+   * Creates a filter with the same parameters and no samples
+   *
+   * \return The new filter
+   */
+  virtual std::unique_ptr<Filter> clone() const = 0;
+};
+
+/**
+ * Mean of the newest samples
+ */
+class MovingAverage : public Filter {
+ public:
+  /**
+   * \param window Number of samples averaged, > 0
+   */
+  MovingAverage(size_t window);
+  virtual ~MovingAverage() = default;
+
+  float add(float value) final;
+  void clear() final;
+  std::unique_ptr<Filter> clone() const final;
+
+ private:
+  /// Ring buffer of the newest samples
+  std::vector<float> samples_;
+  size_t count_ = 0;
+  size_t index_ = 0;
+  /// Sum of the samples in the ring buffer
+  double sum_ = 0;
+};
+
+/**
+ * Exponentially weighted moving average
+ *
+ * Each sample is weighted by alpha and the previous output by 1 - alpha.
+ */
+class Ewma : public Filter {
+ public:
+  /**
+   * \param alpha Weight of a new sample, in (0, 1]
+   */
+  Ewma(float alpha);
+  virtual ~Ewma() = default;
+
+  float add(float value) final;
+  void clear() final;
+  std::unique_ptr<Filter> clone() const final;
+
+ private:
+  const float alpha_;
+  float output_ = NAN;
+};
+
+/**
+ * Median of the newest samples in logarithmic time per sample
+ *
+ * The samples are kept in a ring buffer and indexed by two heaps sharing one
+ * array, with the median at its center. The max-heap of the smaller half
+ * grows to the negative indices, the min-heap of the larger half to the
+ * positive ones. A new sample replaces the oldest one in place and is moved
+ * up or down its heap, and across the median if needed. Until the window is
+ * full, the median of the samples so far is returned.
+ */
+class SlidingMedian : public Filter {
+ public:
+  /**
+   * \param window Number of samples, > 0
+   */
+  SlidingMedian(size_t window);
+  virtual ~SlidingMedian() = default;
+
+  float add(float value) final;
+  void clear() final;
+  std::unique_ptr<Filter> clone() const final;
+
+  /// The median of the samples, NaN if empty
+  float getMedian() const;
+
+  /// Number of samples in the window
+  size_t getCount() const;
+
+ private:
+  /// The index into samples_ at a heap position. 0 is the median
+  int& heap(int position);
+  int heap(int position) const;
+
+  /// Number of samples in the min-heap, excluding the median
+  int getMinCount() const;
+  /// Number of samples in the max-heap, excluding the median
+  int getMaxCount() const;
+
+  bool isLess(int position_a, int position_b) const;
+  void exchange(int position_a, int position_b);
+  /// Exchanges the samples if the first is less. Returns true if exchanged
+  bool exchangeIfLess(int position_a, int position_b);
+
+  /// Moves the samples from the position down to restore the heap property
+  /// below its parent
+  void minSortDown(int position);
+  void maxSortDown(int position);
+  /// Returns true if the sample moved to the median
+  bool minSortUp(int position);
+  /// Returns true if the sample moved to the median
+  bool maxSortUp(int position);
+
+  const int window_;
+  /// Ring buffer of the samples
+  std::vector<float> samples_;
+  /// Heap position of each sample
+  std::vector<int> positions_;
+  /// Sample index at each heap position, offset by window_ / 2
+  std::vector<int> heap_;
+  int count_ = 0;
+  int index_ = 0;
+};
+
+/**
+ * Hampel outlier filter
+ *
+ * Replaces a sample by the median of the newest samples if it deviates from
+ * the median by more than the threshold times the scaled median absolute
+ * deviation. Other samples pass unchanged.
+ */
+class HampelFilter : public Filter {
+ public:
+  /**
+   * \param window Number of samples the median is taken of, > 0
+   * \param threshold Deviations in standard deviations to reject a sample
+   */
+  HampelFilter(size_t window, float threshold);
+  virtual ~HampelFilter() = default;
+
+  float add(float value) final;
+  void clear() final;
+  std::unique_ptr<Filter> clone() const final;
+
+ private:
+  SlidingMedian median_;
+  const float threshold_;
+  /// Ring buffer of the samples to take their deviations
+  std::vector<float> samples_;
+  /// Preallocated buffer for the deviations from the median
+  std::vector<float> deviations_;
+  size_t index_ = 0;
+  float output_ = NAN;
+
+  /// Scales the median absolute deviation to the standard deviation of
+  /// normally distributed samples
+  static constexpr float mad_scale_ = 1.4826f;
+};
+
+/**
+ * Filters applied one after another
+ */
+class FilterChain : public Filter {
+ public:
+  FilterChain() = default;
+  virtual ~FilterChain() = default;
+
+  /**
+   * Appends a filter to the chain
+   *
+   * \param filter The filter applied to the output of the previous ones
+   */
+  void append(std::unique_ptr<Filter> filter);
+
+  /// Whether the chain has no filters and passes the samples unchanged
+  bool isEmpty() const;
+
+  float add(float value) final;
+  void clear() final;
+  std::unique_ptr<Filter> clone() const final;
+
+ private:
+  std::vector<std::unique_ptr<Filter>> filters_;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,51 @@
+#include "flash_storage.h"
+
+namespace bernd_box {
+namespace utils {
+
+RamStorage::RamStorage(size_t sector_count, size_t sector_size)
+    : sector_size_(sector_size), memory_(sector_count * sector_size, 0xFF) {}
+
+bool RamStorage::begin() { return true; }
+
+size_t RamStorage::getSize() const { return memory_.size(); }
+
+size_t RamStorage::getSectorSize() const { return sector_size_; }
+
+bool RamStorage::erase(size_t sector) {
+  if ((sector + 1) * sector_size_ > memory_.size()) {
+    return false;
+  }
+
+  std::fill(memory_.begin() + sector * sector_size_,
+            memory_.begin() + (sector + 1) * sector_size_, 0xFF);
+  erase_count_++;
+  return true;
+}
+
+bool RamStorage::write(size_t offset, const void* data, size_t length) {
+  if (offset + length > memory_.size()) {
+    return false;
+  }
+
+  // Like NOR flash, writing only clears bits
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < length; i++) {
+    memory_[offset + i] &= bytes[i];
+  }
+  return true;
+}
+
+bool RamStorage::read(size_t offset, void* data, size_t length) {
+  if (offset + length > memory_.size()) {
+    return false;
+  }
+
+  memcpy(data, &memory_[offset], length);
+  return true;
+}
+
+size_t RamStorage::getEraseCount() const { return erase_count_; }
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Interface of a NOR flash region
+ *
+ * Erasing a sector sets all its bytes to 0xFF. Writing can only clear bits,
+ * so a byte can be written again as long as no bit has to be set.
+ */
+class FlashStorage {
+ public:
+  virtual ~FlashStorage() = default;
+
+  /**
+   * Prepares the region. Has to be called before any other function
+   *
+   * \return True if the region can be used
+   */
+  virtual bool begin() = 0;
+
+  /// Size of the region in bytes
+  virtual size_t getSize() const = 0;
+
+  /// Size of the erasable sectors in bytes
+  virtual size_t getSectorSize() const = 0;
+
+  /**
+   * Erases a sector
+   *
+   * \param sector The index of the sector
+   * \return True on success
+   */
+  virtual bool erase(size_t sector) = 0;
+
+  /**
+   * Writes data to the region
+   *
+   * \param offset Offset in bytes from the start of the region
+   * \param data The data to write
+   * \param length The length of the data in bytes
+   * \return True on success
+   */
+  virtual bool write(size_t offset, const void* data, size_t length) = 0;
+
+  /**
+   * Reads data from the region
+   *
+   * \param offset Offset in bytes from the start of the region
+   * \param data Buffer to read the data into
+   * \param length The length of the data in bytes
+   * \return True on success
+   */
+  virtual bool read(size_t offset, void* data, size_t length) = 0;
+};
+
+/**
+ * Flash emulated in RAM, used on the host and in tests
+ */
+class RamStorage : public FlashStorage {
+ public:
+  /**
+   * Creates an erased region
+   *
+   * \param sector_count Number of sectors
+   * \param sector_size Size of each sector in bytes
+   */
+  RamStorage(size_t sector_count, size_t sector_size);
+  virtual ~RamStorage() = default;
+
+  bool begin() final;
+  size_t getSize() const final;
+  size_t getSectorSize() const final;
+  bool erase(size_t sector) final;
+  bool write(size_t offset, const void* data, size_t length) final;
+  bool read(size_t offset, void* data, size_t length) final;
+
+  /// Number of erased sectors since the creation to compare flash wear
+  size_t getEraseCount() const;
+
+ private:
+  const size_t sector_size_;
+  std::vector<uint8_t> memory_;
+  size_t erase_count_ = 0;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,92 @@
+#include "json_document_pool.h"
+
+namespace bernd_box {
+namespace utils {
+
+JsonDocumentLease::JsonDocumentLease(DynamicJsonDocument* doc, int size_class)
+    : doc_(doc), size_class_(size_class) {}
+
+JsonDocumentLease::JsonDocumentLease(JsonDocumentLease&& other)
+    : doc_(other.doc_), size_class_(other.size_class_) {
+  other.doc_ = nullptr;
+}
+
+JsonDocumentLease::~JsonDocumentLease() {
+  if (doc_) {
+    JsonDocumentPool::release(doc_, size_class_);
+  }
+}
+
+DynamicJsonDocument& JsonDocumentLease::operator*() const { return *doc_; }
+
+DynamicJsonDocument* JsonDocumentLease::operator->() const { return doc_; }
+
+JsonDocumentLease JsonDocumentPool::acquire(size_t capacity) {
+  auto& size_classes = getSizeClasses();
+  for (size_t i = 0; i < size_classes.size(); i++) {
+    SizeClass& size_class = size_classes[i];
+    if (size_class.capacity < capacity) {
+      continue;
+    }
+
+    size_class.in_use++;
+    if (size_class.in_use > size_class.high_water) {
+      size_class.high_water = size_class.in_use;
+    }
+
+    // Reuse a returned doc. Docs are cleared when they are returned
+    if (!size_class.free.empty()) {
+      DynamicJsonDocument* doc = size_class.free.back().release();
+      size_class.free.pop_back();
+      return JsonDocumentLease(doc, i);
+    }
+
+    if (size_class.in_use > size_class.retain) {
+      size_class.overflows++;
+    }
+    return JsonDocumentLease(new DynamicJsonDocument(size_class.capacity), i);
+  }
+
+  // Larger than any size class, so it is not pooled
+  return JsonDocumentLease(new DynamicJsonDocument(capacity), -1);
+}
+
+std::vector<JsonDocumentPool::Statistics> JsonDocumentPool::getStatistics() {
+  std::vector<Statistics> statistics;
+  for (const auto& size_class : getSizeClasses()) {
+    statistics.push_back(Statistics{size_class.capacity, size_class.in_use,
+                                    size_class.high_water,
+                                    size_class.overflows});
+  }
+  return statistics;
+}
+
+void JsonDocumentPool::release(DynamicJsonDocument* doc, int size_class) {
+  if (size_class < 0) {
+    delete doc;
+    return;
+  }
+
+  SizeClass& pool = getSizeClasses()[size_class];
+  pool.in_use--;
+  if (pool.free.size() < pool.retain) {
+    doc->clear();
+    pool.free.emplace_back(doc);
+  } else {
+    delete doc;
+  }
+}
+
+std::array<JsonDocumentPool::SizeClass, 2>&
+JsonDocumentPool::getSizeClasses() {
+  // Small docs for errors and alerts, payload sized docs for everything else.
+  // Nested handlers (receive -> command -> result) borrow several at once
+  static std::array<SizeClass, 2> size_classes{{
+      {256, 4, {}, 0, 0, 0},
+      {BB_JSON_PAYLOAD_SIZE, 4, {}, 0, 0, 0},
+  }};
+  return size_classes;
+}
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace bernd_box {
+namespace utils {
+
+class JsonDocumentPool;
+
+/**
+ * A JSON doc borrowed from the JsonDocumentPool
+ *
+ * The doc is cleared and returned to the pool when the lease goes out of
+ * scope. Leases can be moved but not copied.
+ */
+class JsonDocumentLease {
+ public:
+  JsonDocumentLease(JsonDocumentLease&& other);
+  JsonDocumentLease(const JsonDocumentLease&) = delete;
+  JsonDocumentLease& operator=(const JsonDocumentLease&) = delete;
+  ~JsonDocumentLease();
+
+  DynamicJsonDocument& operator*() const;
+  DynamicJsonDocument* operator->() const;
+
+ private:
+  friend class JsonDocumentPool;
+
+  /**
+   * \param doc The borrowed doc
+   * \param size_class Index of the doc's size class or -1 if not pooled
+   */
+  JsonDocumentLease(DynamicJsonDocument* doc, int size_class);
+
+  DynamicJsonDocument* doc_;
+  int size_class_;
+};
+
+/**
+ * Pool of preallocated JSON docs in fixed size classes
+ *
+ * Docs are allocated on first use and kept for reuse after being returned, so
+ * that the steady-state message path does not allocate. Each size class keeps
+ * up to a fixed number of docs. Docs borrowed beyond that number are counted
+ * as overflows and deleted when returned. Requests larger than the largest
+ * size class are served from the heap.
+ *
+ * Usage:
+ *   auto lease = JsonDocumentPool::acquire(BB_JSON_PAYLOAD_SIZE);
+ *   DynamicJsonDocument& doc = *lease;
+ */
+class JsonDocumentPool {
+ public:
+  /// Usage of a size class
+  struct Statistics {
+    /// Capacity of the docs of the size class in bytes
+    size_t capacity;
+    /// Number of docs currently borrowed
+    size_t in_use;
+    /// Highest number of docs borrowed at once
+    size_t high_water;
+    /// Number of docs allocated beyond the kept docs
+    size_t overflows;
+  };
+
+  /**
+   * Borrow a cleared doc from the smallest fitting size class
+   *
+   * \param capacity The minimum capacity of the doc in bytes
+   * \return Lease of the doc which returns it on destruction
+   */
+  static JsonDocumentLease acquire(size_t capacity);
+
+  /**
+   * Gets the usage of all size classes
+   *
+   * \return The statistics of each size class
+   */
+  static std::vector<Statistics> getStatistics();
+
+ private:
+  friend class JsonDocumentLease;
+
+  struct SizeClass {
+    /// Capacity of the docs
+    const size_t capacity;
+    /// Number of docs kept for reuse
+    const size_t retain;
+    /// Docs ready for reuse
+    std::vector<std::unique_ptr<DynamicJsonDocument>> free;
+    size_t in_use;
+    size_t high_water;
+    size_t overflows;
+  };
+
+  /**
+   * Clears the doc and keeps it for reuse or deletes it
+   *
+   * \param doc The returned doc
+   * \param size_class Index of the doc's size class or -1 if not pooled
+   */
+  static void release(DynamicJsonDocument* doc, int size_class);
+
+  static std::array<SizeClass, 2>& getSizeClasses();
+};
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,43 @@
+#ifdef ARDUINO_ARCH_ESP32
+
+#include "partition_storage.h"
+
+namespace bernd_box {
+namespace utils {
+
+PartitionStorage::PartitionStorage(const char* label,
+                                   esp_partition_subtype_t subtype)
+    : label_(label), subtype_(subtype) {}
+
+bool PartitionStorage::begin() {
+  partition_ =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, subtype_, label_);
+  return partition_ != nullptr;
+}
+
+size_t PartitionStorage::getSize() const {
+  return partition_ ? partition_->size : 0;
+}
+
+size_t PartitionStorage::getSectorSize() const { return SPI_FLASH_SEC_SIZE; }
+
+bool PartitionStorage::erase(size_t sector) {
+  return partition_ &&
+         esp_partition_erase_range(partition_, sector * SPI_FLASH_SEC_SIZE,
+                                   SPI_FLASH_SEC_SIZE) == ESP_OK;
+}
+
+bool PartitionStorage::write(size_t offset, const void* data, size_t length) {
+  return partition_ &&
+         esp_partition_write(partition_, offset, data, length) == ESP_OK;
+}
+
+bool PartitionStorage::read(size_t offset, void* data, size_t length) {
+  return partition_ &&
+         esp_partition_read(partition_, offset, data, length) == ESP_OK;
+}
+
+}  // namespace utils
+}  // namespace bernd_box
+
+#endif
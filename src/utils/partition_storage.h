@@ -0,0 +1,42 @@
+#pragma once
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+#include "flash_storage.h"
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * A data partition of the ESP32's flash, see partitions.csv
+ */
+class PartitionStorage : public FlashStorage {
+ public:
+  /**
+   * \param label The name of the partition
+   * \param subtype The subtype of the data partition
+   */
+  PartitionStorage(const char* label, esp_partition_subtype_t subtype);
+  virtual ~PartitionStorage() = default;
+
+  /// Looks up the partition. False if it does not exist
+  bool begin() final;
+  size_t getSize() const final;
+  size_t getSectorSize() const final;
+  bool erase(size_t sector) final;
+  bool write(size_t offset, const void* data, size_t length) final;
+  bool read(size_t offset, void* data, size_t length) final;
+
+ private:
+  const char* label_;
+  const esp_partition_subtype_t subtype_;
+  const esp_partition_t* partition_ = nullptr;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
+
+#endif
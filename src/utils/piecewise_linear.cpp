@@ -0,0 +1,39 @@
+#include "piecewise_linear.h"
+
+namespace bernd_box {
+namespace utils {
+
+PiecewiseLinear::PiecewiseLinear(std::vector<Point> points)
+    : points_(std::move(points)) {}
+
+bool PiecewiseLinear::isEmpty() const { return points_.empty(); }
+
+float PiecewiseLinear::evaluate(float x) const {
+  if (points_.size() < 2) {
+    return x;
+  }
+
+  // Find the first point after x. The segment ends there, but the first and
+  // last segments are extended beyond the points
+  auto upper = std::upper_bound(
+      points_.begin() + 1, points_.end() - 1, x,
+      [](float value, const Point& point) { return value < point.x; });
+  const Point& a = *(upper - 1);
+  const Point& b = *upper;
+  return a.y + (x - a.x) * (b.y - a.y) / (b.x - a.x);
+}
+
+bool PiecewiseLinear::isValid(const std::vector<Point>& points) {
+  if (points.size() < 2) {
+    return false;
+  }
+  for (size_t i = 1; i < points.size(); i++) {
+    if (!(points[i - 1].x < points[i].x)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace utils
+}  // namespace bernd_box
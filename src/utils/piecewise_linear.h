@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Function interpolating linearly between points
+ *
+ * Used as a lookup table to correct measurements, for example with reference
+ * values measured during calibration. The segment of a value is found by
+ * binary search. Values outside of the points are extrapolated from the
+ * first or last segment.
+ */
+class PiecewiseLinear {
+ public:
+  struct Point {
+    float x;
+    float y;
+  };
+
+  /// Creates an empty function which returns values unchanged
+  PiecewiseLinear() = default;
+
+  /**
+   * \param points At least two points, ordered by strictly increasing x
+   */
+  PiecewiseLinear(std::vector<Point> points);
+
+  bool isEmpty() const;
+
+  /**
+   * Evaluates the function
+   *
+   * \param x The value to look up
+   * \return The interpolated value, or x if the function is empty
+   */
+  float evaluate(float x) const;
+
+  /**
+   * Checks if points are valid for a function
+   *
+   * \param points The points to check
+   * \return True if there are at least two points with strictly increasing x
+   */
+  static bool isValid(const std::vector<Point>& points);
+
+ private:
+  std::vector<Point> points_;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,43 @@
+#include "running_statistics.h"
+
+namespace bernd_box {
+namespace utils {
+
+void RunningStatistics::add(float value) {
+  if (std::isnan(value)) {
+    return;
+  }
+
+  count_++;
+  if (count_ == 1) {
+    min_ = value;
+    max_ = value;
+  } else {
+    min_ = std::fmin(min_, value);
+    max_ = std::fmax(max_, value);
+  }
+
+  const double delta = value - mean_;
+  mean_ += delta / count_;
+  m2_ += delta * (value - mean_);
+}
+
+void RunningStatistics::clear() { *this = RunningStatistics(); }
+
+uint32_t RunningStatistics::getCount() const { return count_; }
+
+float RunningStatistics::getMin() const { return min_; }
+
+float RunningStatistics::getMax() const { return max_; }
+
+float RunningStatistics::getMean() const { return count_ ? mean_ : NAN; }
+
+float RunningStatistics::getStandardDeviation() const {
+  if (count_ < 2) {
+    return 0;
+  }
+  return std::sqrt(m2_ / (count_ - 1));
+}
+
+}  // namespace utils
+}  // namespace bernd_box
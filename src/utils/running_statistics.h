@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Minimum, maximum, mean and standard deviation of a stream of values
+ *
+ * Uses Welford's algorithm, which updates the mean and the sum of squared
+ * differences from it with every value. It needs constant memory and avoids
+ * the cancellation of summing the squares of values with a large offset. NaN
+ * values are ignored.
+ */
+class RunningStatistics {
+ public:
+  /**
+   * Adds a value to the statistics
+   *
+   * \param value The value to add
+   */
+  void add(float value);
+
+  /**
+   * Removes all values
+   */
+  void clear();
+
+  /// Number of added values
+  uint32_t getCount() const;
+
+  /// Smallest added value, NaN if empty
+  float getMin() const;
+
+  /// Largest added value, NaN if empty
+  float getMax() const;
+
+  /// Mean of the added values, NaN if empty
+  float getMean() const;
+
+  /// Sample standard deviation of the added values, 0 for less than 2 values
+  float getStandardDeviation() const;
+
+ private:
+  uint32_t count_ = 0;
+  float min_ = NAN;
+  float max_ = NAN;
+  /// Kept in double precision, as the updates get small for long windows
+  double mean_ = 0;
+  /// Sum of the squared differences from the mean
+  double m2_ = 0;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
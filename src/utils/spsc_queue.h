@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Bounded lock-free queue between exactly one producer and one consumer
+ *
+ * The slots are allocated once and reused. Instead of copying elements in
+ * and out, the producer fills the slot returned by getWriteSlot() and
+ * publishes it with push(), while the consumer reads the slot returned by
+ * getReadSlot() and releases it with pop(). Buffers held by a slot (for
+ * example a std::vector) therefore keep their capacity between uses.
+ *
+ * The producer and the consumer may run on different cores or threads. Each
+ * side must only be used from a single thread.
+ */
+template <typename T>
+class SpscQueue {
+ public:
+  /**
+   * Allocates the slots of the queue
+   *
+   * \param capacity Maximum number of elements in the queue
+   */
+  explicit SpscQueue(size_t capacity) : slots_(capacity + 1) {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /**
+   * Gets the next free slot. Only called by the producer
+   *
+   * \return The slot to fill or a nullptr if the queue is full
+   */
+  T* getWriteSlot() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (next(tail) == head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slots_[tail];
+  }
+
+  /**
+   * Publishes the slot returned by getWriteSlot() to the consumer. Only
+   * called by the producer
+   */
+  void push() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    tail_.store(next(tail), std::memory_order_release);
+  }
+
+  /**
+   * Gets the oldest published slot. Only called by the consumer
+   *
+   * \return The slot to read or a nullptr if the queue is empty
+   */
+  T* getReadSlot() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slots_[head];
+  }
+
+  /**
+   * Returns the slot returned by getReadSlot() to the producer. Only called
+   * by the consumer
+   */
+  void pop() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    head_.store(next(head), std::memory_order_release);
+  }
+
+  /// Number of published elements. Exact only on the producer or consumer
+  size_t size() const {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : tail + slots_.size() - head;
+  }
+
+  /// Maximum number of elements in the queue
+  size_t capacity() const { return slots_.size() - 1; }
+
+ private:
+  size_t next(size_t index) const {
+    return index + 1 == slots_.size() ? 0 : index + 1;
+  }
+
+  /// One slot more than the capacity to tell a full from an empty queue
+  std::vector<T> slots_;
+  /// Index of the oldest published slot. Written by the consumer
+  std::atomic<size_t> head_{0};
+  /// Index of the next free slot. Written by the producer
+  std::atomic<size_t> tail_{0};
+};
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Hashes a type name with FNV-1a
+ *
+ * Usable at compile time to build a TypeTable and at run time to look up a
+ * type name.
+ *
+ * \param name The null terminated type name
+ * \param hash The hash of the preceding characters
+ * \return The hash of the name
+ */
+constexpr uint32_t hashTypeName(const char* name, uint32_t hash = 2166136261u) {
+  return *name ? hashTypeName(
+                     name + 1,
+                     (hash ^ static_cast<uint8_t>(*name)) * 16777619u)
+               : hash;
+}
+
+namespace type_table {
+
+/// Number of seeds tried to find a perfect hash
+constexpr uint32_t max_seeds = 128;
+
+/// Bucket of a type name's hash for a seed. Uses the high bits of the product
+constexpr uint32_t bucketOf(uint32_t hash, uint32_t seed, uint8_t bits) {
+  return ((hash ^ seed) * 2654435769u) >> (32 - bits);
+}
+
+/// Smallest number of bits addressing at least four buckets per type
+constexpr uint8_t bucketBits(size_t size, uint8_t bits = 1) {
+  return (size_t(1) << bits) >= 4 * size ? bits : bucketBits(size, bits + 1);
+}
+
+template <typename Entry, size_t N>
+constexpr uint32_t bucketOfEntry(const Entry (&entries)[N], size_t index,
+                                 uint32_t seed, uint8_t bits) {
+  return bucketOf(hashTypeName(entries[index].name), seed, bits);
+}
+
+/// Whether no two type names share a bucket, comparing the pairs from (i, j)
+template <typename Entry, size_t N>
+constexpr bool isPerfect(const Entry (&entries)[N], uint32_t seed,
+                         uint8_t bits, size_t i = 0, size_t j = 1) {
+  return i >= N   ? true
+         : j >= N ? isPerfect(entries, seed, bits, i + 1, i + 2)
+                  : bucketOfEntry(entries, i, seed, bits) !=
+                            bucketOfEntry(entries, j, seed, bits) &&
+                        isPerfect(entries, seed, bits, i, j + 1);
+}
+
+/// The first seed from the given one without collisions, max_seeds if none
+template <typename Entry, size_t N>
+constexpr uint32_t findSeed(const Entry (&entries)[N], uint8_t bits,
+                            uint32_t seed = 0) {
+  return seed >= max_seeds                  ? max_seeds
+         : isPerfect(entries, seed, bits) ? seed
+                                            : findSeed(entries, bits, seed + 1);
+}
+
+/// Index of the entry in the bucket, N if the bucket is empty
+template <typename Entry, size_t N>
+constexpr uint8_t entryInBucket(const Entry (&entries)[N], uint32_t bucket,
+                                uint32_t seed, uint8_t bits, size_t index = 0) {
+  return index >= N ? N
+         : bucketOfEntry(entries, index, seed, bits) == bucket
+             ? index
+             : entryInBucket(entries, bucket, seed, bits, index + 1);
+}
+
+template <size_t... I>
+struct IndexSequence {};
+
+template <size_t N, size_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct MakeIndexSequence<0, I...> {
+  using type = IndexSequence<I...>;
+};
+
+}  // namespace type_table
+
+/**
+ * Perfect hash of the names of a type table, computed at compile time
+ *
+ * \tparam BucketCount Number of buckets, a power of two
+ */
+template <size_t BucketCount>
+struct PerfectHash {
+  uint32_t seed;
+  uint8_t bits;
+  /// Index of the entry in each bucket, the number of entries if empty
+  uint8_t buckets[BucketCount];
+
+  /// False if the names are not unique
+  constexpr bool isValid() const { return seed < type_table::max_seeds; }
+};
+
+namespace type_table {
+
+template <typename Entry, size_t N, size_t... B>
+constexpr PerfectHash<sizeof...(B)> makePerfectHash(
+    const Entry (&entries)[N], uint32_t seed, uint8_t bits,
+    IndexSequence<B...>) {
+  return PerfectHash<sizeof...(B)>{
+      seed, bits, {entryInBucket(entries, B, seed, bits)...}};
+}
+
+}  // namespace type_table
+
+/**
+ * Finds a seed for which the type names fall into distinct buckets and
+ * assigns the entries to their buckets
+ *
+ * Evaluate it as a constexpr and check isValid() with a static_assert.
+ *
+ * \param entries The types, each with a `const char* name`
+ * \return The perfect hash of the names
+ */
+template <typename Entry, size_t N>
+constexpr PerfectHash<size_t(1) << type_table::bucketBits(N)> makePerfectHash(
+    const Entry (&entries)[N]) {
+  static_assert(N < UINT8_MAX, "Too many types for a type table");
+  return type_table::makePerfectHash(
+      entries, type_table::findSeed(entries, type_table::bucketBits(N)),
+      type_table::bucketBits(N),
+      typename type_table::MakeIndexSequence<size_t(1)
+                                             << type_table::bucketBits(
+                                                    N)>::type());
+}
+
+/**
+ * Constant table of the types known to a factory, found by their names
+ *
+ * The table is built at compile time and placed in flash, so that it needs
+ * no registration at start-up. A lookup hashes the name once and compares it
+ * with the single type name in its bucket.
+ *
+ * \tparam Entry The type's properties, with a `const char* name`
+ */
+template <typename Entry>
+class TypeTable {
+ public:
+  /**
+   * \param entries The types
+   * \param hash The perfect hash of the type names
+   */
+  template <size_t N, size_t BucketCount>
+  constexpr TypeTable(const Entry (&entries)[N],
+                      const PerfectHash<BucketCount>& hash)
+      : entries_(entries),
+        size_(N),
+        buckets_(hash.buckets),
+        seed_(hash.seed),
+        bits_(hash.bits) {}
+
+  /**
+   * Finds a type by its name
+   *
+   * \param name The type name
+   * \return The type or a nullptr if unknown
+   */
+  const Entry* find(const char* name) const {
+    if (!name) {
+      return nullptr;
+    }
+    const uint8_t index =
+        buckets_[type_table::bucketOf(hashTypeName(name), seed_, bits_)];
+    if (index >= size_ || std::strcmp(entries_[index].name, name) != 0) {
+      return nullptr;
+    }
+    return &entries_[index];
+  }
+
+  const Entry* begin() const { return entries_; }
+  const Entry* end() const { return entries_ + size_; }
+  size_t size() const { return size_; }
+
+  /// Position of a type in the table, to keep state per type in an array
+  size_t indexOf(const Entry& entry) const { return &entry - entries_; }
+
+ private:
+  const Entry* entries_;
+  size_t size_;
+  const uint8_t* buckets_;
+  uint32_t seed_;
+  uint8_t bits_;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
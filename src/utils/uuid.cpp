@@ -17,12 +17,7 @@ UUID::UUID() {
 UUID::UUID(const char* str) { fromString(str); }
 
 UUID::UUID(const JsonVariantConst& uuid) {
-  if (uuid.isNull() || !uuid.is<char*>()) {
-    clear();
-    return;
-  }
-
-  fromString(uuid.as<char*>());
+  fromString(uuid.as<const char*>());
 }
 
 bool UUID::operator<(const UUID& rhs) const { return buffer_ < rhs.buffer_; }
@@ -34,67 +29,65 @@ bool UUID::operator==(const UUID& rhs) const { return buffer_ == rhs.buffer_; }
 bool UUID::operator!=(const UUID& rhs) const { return !(*this == rhs); }
 
 size_t UUID::printTo(Print& p) const {
-  size_t n = 0;
-
-  // Convert to HEX and break up into blocks (8, 4, 4, 4, 12)
-  for (int i = 0; i < 16; i++) {
-    if (i == 4 || i == 6 || i == 8 || i == 10) {
-      n += p.write("-");
-    }
-    n += p.print(buffer_[i] >> 4, HEX);
-    n += p.print(buffer_[i] & 0x0F, HEX);
-  }
-  return n;
+  char buffer[string_size];
+  return p.write(toChars(buffer), string_size - 1);
 }
 
 String UUID::toString() const {
-  String uuid_str;
-  uuid_str.reserve(36 + 1);  // Include NULL / terminator byte
+  char buffer[string_size];
+  return String(toChars(buffer));
+}
 
-  for (int i = 0; i < 16; i++) {
+char* UUID::toChars(char (&buffer)[string_size]) const {
+  char* out = buffer;
+  for (size_t i = 0; i < buffer_.size(); i++) {
     if (i == 4 || i == 6 || i == 8 || i == 10) {
-      uuid_str += "-";
+      *out++ = '-';
     }
-    uuid_str += String(buffer_[i] >> 4, HEX);
-    uuid_str += String(buffer_[i] & 0x0F, HEX);
+    *out++ = hex_chars_[buffer_[i] >> 4];
+    *out++ = hex_chars_[buffer_[i] & 0x0F];
   }
-  return uuid_str;
+  *out = '\0';
+  return buffer;
 }
 
 bool UUID::fromString(const char* uuid) {
-  if (!uuid || strlen(uuid) != 36) {
+  if (!uuid) {
     clear();
     return false;
   }
 
-  char uuid_str[32];
-  char* outc = uuid_str;
-  for (int i = 0; i < 36; ++i) {
-    char c = uuid[i];
-    if (i == 8 || i == 13 || i == 18 || i == 23) {
-      if (c != '-') {
-        return false;
-      }
-    } else {
-      if (!isxdigit(c)) {
-        return false;
-      }
-      *outc = (char)tolower(c);
-      ++outc;
+  // Parse into a copy so that a malformed string does not leave a partially
+  // overwritten UUID behind
+  std::array<uint8_t, 16> bytes;
+  for (size_t i = 0; i < bytes.size(); i++) {
+    const uint8_t offset = char_offsets_[i];
+    if ((i == 4 || i == 6 || i == 8 || i == 10) && uuid[offset - 1] != '-') {
+      clear();
+      return false;
     }
-  }
 
-#define UUID_HEXCHRTO_DEC(c)               \
-  (unsigned char)((c) <= '9' ? ((c) - '0') \
-                             : 10 + (c) - ((c) <= 'F' ? 'A' : 'a'))
+    // A null terminator maps to invalid, so a short string stops here. The
+    // low nibble is only read if the high one was not the terminator
+    const uint8_t high = hex_values_[static_cast<uint8_t>(uuid[offset])];
+    if (high & 0xF0) {
+      clear();
+      return false;
+    }
+    const uint8_t low = hex_values_[static_cast<uint8_t>(uuid[offset + 1])];
+    if (low & 0xF0) {
+      clear();
+      return false;
+    }
+    bytes[i] = (high << 4) | low;
+  }
 
-  for (int byte = 0; byte < 16; ++byte) {
-    unsigned char v1 = UUID_HEXCHRTO_DEC(uuid_str[byte * 2]);
-    unsigned char v2 = UUID_HEXCHRTO_DEC(uuid_str[byte * 2 + 1]);
-    buffer_[byte] = (unsigned char)((v1 << 4) | v2);
+  if (uuid[string_size - 1] != '\0') {
+    clear();
+    return false;
   }
-#undef UUID_HEXCHRTO_DEC
 
+  buffer_ = bytes;
   if (isValid()) {
     return true;
   } else {
@@ -123,5 +116,54 @@ bool UUID::isValid() const {
   return true;
 }
 
+size_t UUID::hash() const {
+  size_t hash;
+  memcpy(&hash, buffer_.data(), sizeof(hash));
+  return hash;
+}
+
+bool convertToJson(const UUID& src, JsonVariant dst) {
+  // A non-const char* makes ArduinoJson copy the string into the doc
+  char buffer[UUID::string_size];
+  return dst.set(static_cast<char*>(src.toChars(buffer)));
+}
+
+void convertFromJson(JsonVariantConst src, UUID& dst) {
+  dst.fromString(src.as<const char*>());
+}
+
+bool canConvertFromJson(JsonVariantConst src, const UUID&) {
+  return src.is<const char*>();
+}
+
+const char UUID::hex_chars_[] = "0123456789abcdef";
+
+const uint8_t UUID::char_offsets_[] = {0,  2,  4,  6,  9,  11, 14, 16,
+                                       19, 21, 24, 26, 28, 30, 32, 34};
+
+const uint8_t UUID::hex_values_[] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF};
+
 }  // namespace utils
 }  // namespace bernd_box
@@ -4,8 +4,9 @@
 #include <ArduinoJson.h>
 
 #include <array>
+#include <functional>
 
-#include "managers/io_types.h"
+#include "managers/error_result.h"
 
 namespace bernd_box {
 namespace utils {
@@ -18,6 +19,9 @@ namespace utils {
  */
 class UUID : public Printable {
  public:
+  /// Size of the string representation including the null terminator
+  static constexpr size_t string_size = 37;
+
   /**
    * Create a new UUID
    */
@@ -53,16 +57,27 @@ class UUID : public Printable {
 
   /**
    * Creates a string representation of the UUID
+   *
+   * \see toChars() to avoid the String allocation
    */
   String toString() const;
 
+  /**
+   * Writes the string representation of the UUID (lower case hex 8-4-4-4-12)
+   * into the caller's buffer and null terminates it
+   *
+   * \param buffer The buffer for the 36 characters and the null terminator
+   * \return The buffer
+   */
+  char* toChars(char (&buffer)[string_size]) const;
+
   /**
    * Tries to change to the UUID string provided
    *
    * \see isValid() for the validity constraints
    *
    * \param uuid The UUID in string form (Hex 8-4-4-4-12)
-   * \return True if it is a valid UUID string
+   * \return True if it is a valid UUID string. Else the UUID is cleared
    */
   bool fromString(const char* uuid);
 
@@ -78,10 +93,56 @@ class UUID : public Printable {
    */
   bool isValid() const;
 
+  /**
+   * Hashes the UUID to be used as a key in unordered STL containers
+   *
+   * As V4 UUIDs are random, the leading bytes are used as is.
+   *
+   * \return The hash of the UUID
+   */
+  size_t hash() const;
+
  private:
+  /// Lower case hex digits indexed by their value
+  static const char hex_chars_[];
+  /// Position of each byte's first hex digit in the string representation
+  static const uint8_t char_offsets_[];
+  /// Value of each character as a hex digit, 0xFF if it is not a hex digit
+  static const uint8_t hex_values_[];
+
   /// The internal binary buffer holding the UUID
   std::array<uint8_t, 16> buffer_;
 };
 
+/**
+ * ArduinoJson converter to assign a UUID to a JsonVariant as a string
+ *
+ * The string is copied into the JSON doc without an intermediate String.
+ */
+bool convertToJson(const UUID& src, JsonVariant dst);
+
+/**
+ * ArduinoJson converter to read a UUID from a JSON string
+ *
+ * The UUID is cleared if the string is not a valid UUID.
+ */
+void convertFromJson(JsonVariantConst src, UUID& dst);
+
+/**
+ * ArduinoJson converter check whether the variant can be read as a UUID
+ */
+bool canConvertFromJson(JsonVariantConst src, const UUID&);
+
 }  // namespace utils
 }  // namespace bernd_box
+
+namespace std {
+
+template <>
+struct hash<bernd_box::utils::UUID> {
+  size_t operator()(const bernd_box::utils::UUID& uuid) const {
+    return uuid.hash();
+  }
+};
+
+}  // namespace std
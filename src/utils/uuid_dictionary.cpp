@@ -0,0 +1,30 @@
+#include "uuid_dictionary.h"
+
+namespace bernd_box {
+namespace utils {
+
+UUIDDictionary::UUIDDictionary(size_t capacity) : capacity_(capacity) {
+  handles_.reserve(capacity_);
+}
+
+UUIDDictionary::Handle UUIDDictionary::getHandle(const UUID& uuid) {
+  const auto it = handles_.find(uuid);
+  if (it != handles_.end()) {
+    return Handle{true, false, it->second};
+  }
+
+  if (handles_.size() >= capacity_) {
+    return Handle{false, false, 0};
+  }
+
+  const uint16_t id = handles_.size();
+  handles_.emplace(uuid, id);
+  return Handle{true, true, id};
+}
+
+void UUIDDictionary::clear() { handles_.clear(); }
+
+size_t UUIDDictionary::size() const { return handles_.size(); }
+
+}  // namespace utils
+}  // namespace bernd_box
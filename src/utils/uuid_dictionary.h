@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "utils/uuid.h"
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Assigns short integer handles to UUIDs
+ *
+ * Used per connection, so that a UUID only has to be sent once together with
+ * its handle and can be referenced by the handle afterwards. The handles are
+ * assigned in order starting at zero. Once the capacity is reached, no new
+ * handles are assigned.
+ */
+class UUIDDictionary {
+ public:
+  struct Handle {
+    /// Whether a handle could be assigned
+    bool is_valid;
+    /// Whether the handle was assigned by this lookup and is still unknown
+    /// to the receiver
+    bool is_new;
+    uint16_t id;
+  };
+
+  /**
+   * \param capacity Maximum number of handles
+   */
+  UUIDDictionary(size_t capacity);
+  virtual ~UUIDDictionary() = default;
+
+  /**
+   * Gets the UUID's handle or assigns it a new one
+   *
+   * \param uuid The UUID to be referenced
+   * \return The handle, which is invalid if the dictionary is full
+   */
+  Handle getHandle(const UUID& uuid);
+
+  /**
+   * Removes all handles, e.g. when the connection was lost
+   */
+  void clear();
+
+  /// Number of assigned handles
+  size_t size() const;
+
+ private:
+  size_t capacity_;
+  std::unordered_map<UUID, uint16_t> handles_;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
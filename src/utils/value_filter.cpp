@@ -0,0 +1,139 @@
+#include "value_filter.h"
+
+namespace bernd_box {
+namespace utils {
+
+ValueFilter::ValueFilter(const JsonObjectConst& parameters) {
+  JsonVariantConst filter = parameters[filter_key_];
+  if (filter.isNull()) {
+    return;
+  }
+
+  prototype_ = makeFilter(filter);
+  if (!prototype_) {
+    is_valid_ = false;
+  }
+}
+
+ValueFilter::ValueFilter(const ValueFilter& other)
+    : is_valid_(other.is_valid_) {
+  if (other.prototype_) {
+    prototype_ = other.prototype_->clone();
+  }
+}
+
+bool ValueFilter::isEnabled() const { return bool(prototype_); }
+
+bool ValueFilter::isValid() const { return is_valid_; }
+
+void ValueFilter::apply(std::vector<ValueUnit>& values) {
+  if (!prototype_) {
+    return;
+  }
+
+  // Peripherals only have a few data points, so a linear search is cheapest
+  for (auto& value_unit : values) {
+    auto data_point = data_points_.begin();
+    while (data_point != data_points_.end() &&
+           data_point->data_point_type != value_unit.data_point_type) {
+      data_point++;
+    }
+    if (data_point == data_points_.end()) {
+      data_points_.push_back(
+          DataPoint{value_unit.data_point_type, prototype_->clone()});
+      data_point = data_points_.end() - 1;
+    }
+    value_unit.value = data_point->filter->add(value_unit.value);
+  }
+}
+
+std::unique_ptr<Filter> ValueFilter::makeFilter(
+    const JsonVariantConst& filter) {
+  if (filter.is<JsonObjectConst>()) {
+    return makeSingleFilter(filter);
+  }
+
+  JsonArrayConst filters = filter.as<JsonArrayConst>();
+  if (!filters || filters.size() == 0) {
+    return nullptr;
+  }
+
+  std::unique_ptr<FilterChain> chain(new FilterChain());
+  for (JsonVariantConst element : filters) {
+    std::unique_ptr<Filter> single_filter =
+        makeSingleFilter(element.as<JsonObjectConst>());
+    if (!single_filter) {
+      return nullptr;
+    }
+    chain->append(std::move(single_filter));
+  }
+  return chain;
+}
+
+std::unique_ptr<Filter> ValueFilter::makeSingleFilter(
+    const JsonObjectConst& filter) {
+  if (!filter) {
+    return nullptr;
+  }
+
+  const String type = filter[type_key_].as<String>();
+
+  // The EWMA has no window
+  if (type == ewma_type_) {
+    JsonVariantConst alpha = filter[alpha_key_];
+    if (!alpha.is<float>() || alpha.as<float>() <= 0 ||
+        alpha.as<float>() > 1) {
+      return nullptr;
+    }
+    return std::unique_ptr<Filter>(new Ewma(alpha.as<float>()));
+  }
+
+  JsonVariantConst window = filter[window_key_];
+  if (!window.is<unsigned int>() || window.as<unsigned int>() == 0 ||
+      window.as<unsigned int>() > max_window_) {
+    return nullptr;
+  }
+  const size_t window_size = window.as<unsigned int>();
+
+  if (type == median_type_) {
+    return std::unique_ptr<Filter>(new SlidingMedian(window_size));
+  }
+  if (type == average_type_) {
+    return std::unique_ptr<Filter>(new MovingAverage(window_size));
+  }
+  if (type == hampel_type_) {
+    float threshold = default_threshold_;
+    JsonVariantConst threshold_variant = filter[threshold_key_];
+    if (!threshold_variant.isNull()) {
+      if (!threshold_variant.is<float>() ||
+          threshold_variant.as<float>() < 0) {
+        return nullptr;
+      }
+      threshold = threshold_variant.as<float>();
+    }
+    return std::unique_ptr<Filter>(new HampelFilter(window_size, threshold));
+  }
+
+  return nullptr;
+}
+
+const __FlashStringHelper* ValueFilter::filter_key_ = F("filter");
+const __FlashStringHelper* ValueFilter::filter_key_error_ =
+    F("Wrong type for optional property: filter (object or array of objects "
+      "with type median, hampel, average or ewma, window up to 64 and "
+      "optional threshold or alpha)");
+const size_t ValueFilter::max_window_ = 64;
+
+const __FlashStringHelper* ValueFilter::type_key_ = F("type");
+const __FlashStringHelper* ValueFilter::median_type_ = F("median");
+const __FlashStringHelper* ValueFilter::hampel_type_ = F("hampel");
+const __FlashStringHelper* ValueFilter::average_type_ = F("average");
+const __FlashStringHelper* ValueFilter::ewma_type_ = F("ewma");
+const __FlashStringHelper* ValueFilter::window_key_ = F("window");
+const __FlashStringHelper* ValueFilter::threshold_key_ = F("threshold");
+const __FlashStringHelper* ValueFilter::alpha_key_ = F("alpha");
+
+const float ValueFilter::default_threshold_ = 3;
+
+}  // namespace utils
+}  // namespace bernd_box
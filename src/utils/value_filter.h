@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include <memory>
+#include <vector>
+
+#include "filter.h"
+#include "value_unit.h"
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Filters the readings of a peripheral per data point type
+ *
+ * The filter is configured by the optional "filter" property, which is an
+ * object or an array of objects applied in order:
+ *
+ *     {"type": "median", "window": 5}
+ *     {"type": "hampel", "window": 7, "threshold": 3}
+ *     {"type": "average", "window": 10}
+ *     {"type": "ewma", "alpha": 0.2}
+ *
+ * Each data point type gets its own copy of the filters on its first reading.
+ * Later readings are filtered without allocating.
+ */
+class ValueFilter {
+ public:
+  /// Creates a disabled filter which passes the readings unchanged
+  ValueFilter() = default;
+
+  /**
+   * Creates the filter from the "filter" property, if set
+   *
+   * \param parameters The object with the optional "filter" property
+   */
+  ValueFilter(const JsonObjectConst& parameters);
+
+  /// Creates a filter with the same configuration and no samples
+  ValueFilter(const ValueFilter& other);
+  ValueFilter& operator=(const ValueFilter& other) = delete;
+
+  bool isEnabled() const;
+  bool isValid() const;
+
+  /**
+   * Replaces the values by their filtered values
+   *
+   * \param values The values read from the peripheral
+   */
+  void apply(std::vector<ValueUnit>& values);
+
+  /**
+   * Creates the filters of a "filter" property
+   *
+   * \param filter An object or an array of objects describing the filters
+   * \return The filters or a nullptr if the property is invalid
+   */
+  static std::unique_ptr<Filter> makeFilter(const JsonVariantConst& filter);
+
+  static const __FlashStringHelper* filter_key_;
+  static const __FlashStringHelper* filter_key_error_;
+
+  /// The largest window of a filter. Bounds the memory of a filter
+  static const size_t max_window_;
+
+ private:
+  /**
+   * Creates a single filter
+   *
+   * \param filter The object describing the filter
+   * \return The filter or a nullptr if the object is invalid
+   */
+  static std::unique_ptr<Filter> makeSingleFilter(
+      const JsonObjectConst& filter);
+
+  struct DataPoint {
+    UUID data_point_type;
+    std::unique_ptr<Filter> filter;
+  };
+
+  /// The configured filters, cloned for each data point type
+  std::unique_ptr<Filter> prototype_;
+  std::vector<DataPoint> data_points_;
+  bool is_valid_ = true;
+
+  static const __FlashStringHelper* type_key_;
+  static const __FlashStringHelper* median_type_;
+  static const __FlashStringHelper* hampel_type_;
+  static const __FlashStringHelper* average_type_;
+  static const __FlashStringHelper* ewma_type_;
+  static const __FlashStringHelper* window_key_;
+  static const __FlashStringHelper* threshold_key_;
+  static const __FlashStringHelper* alpha_key_;
+
+  /// Threshold of the Hampel filter if not set, in standard deviations
+  static const float default_threshold_;
+};
+
+}  // namespace utils
+}  // namespace bernd_box
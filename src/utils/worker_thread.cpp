@@ -0,0 +1,73 @@
+#include "worker_thread.h"
+
+namespace bernd_box {
+namespace utils {
+
+WorkerThread::WorkerThread(const char* name, int core, uint32_t stack_size)
+    : name_(name), core_(core), stack_size_(stack_size) {}
+
+WorkerThread::~WorkerThread() { stop(); }
+
+bool WorkerThread::start(std::function<void()> function) {
+  if (is_running_) {
+    return false;
+  }
+
+  function_ = function;
+  is_running_ = true;
+  is_stopped_ = false;
+
+#ifdef ARDUINO_ARCH_ESP32
+  // Same priority as the Arduino loop task
+  BaseType_t result = xTaskCreatePinnedToCore(&WorkerThread::run, name_,
+                                              stack_size_, this, 1, nullptr,
+                                              core_);
+  if (result != pdPASS) {
+    is_running_ = false;
+    is_stopped_ = true;
+    return false;
+  }
+#else
+  thread_ = std::thread(&WorkerThread::run, this);
+#endif
+  return true;
+}
+
+void WorkerThread::stop() {
+  is_running_ = false;
+
+#ifdef ARDUINO_ARCH_ESP32
+  while (!is_stopped_) {
+    delay(1);
+  }
+#else
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+#endif
+}
+
+bool WorkerThread::isRunning() const { return is_running_; }
+
+void WorkerThread::run(void* worker) {
+  WorkerThread& self = *static_cast<WorkerThread*>(worker);
+  while (self.is_running_) {
+    self.function_();
+
+    // Let other tasks on the core run, which also feeds the idle watchdog
+#ifdef ARDUINO_ARCH_ESP32
+    vTaskDelay(1);
+#else
+    std::this_thread::yield();
+#endif
+  }
+  self.is_stopped_ = true;
+
+#ifdef ARDUINO_ARCH_ESP32
+  // FreeRTOS tasks must not return
+  vTaskDelete(nullptr);
+#endif
+}
+
+}  // namespace utils
+}  // namespace bernd_box
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <functional>
+
+#ifndef ARDUINO_ARCH_ESP32
+#include <thread>
+#endif
+
+namespace bernd_box {
+namespace utils {
+
+/**
+ * Repeatedly runs a function in a thread of its own
+ *
+ * On the ESP32 the thread is a FreeRTOS task pinned to a core. On the host it
+ * is a std::thread, which allows the cross-thread paths to be tested on a
+ * workstation.
+ */
+class WorkerThread {
+ public:
+  /**
+   * \param name Name of the thread for debugging
+   * \param core The core to pin the thread to. Ignored on the host
+   * \param stack_size Size of the thread's stack in bytes. Ignored on the host
+   */
+  WorkerThread(const char* name, int core, uint32_t stack_size);
+  WorkerThread(const WorkerThread&) = delete;
+  WorkerThread& operator=(const WorkerThread&) = delete;
+
+  /// Stops the thread
+  virtual ~WorkerThread();
+
+  /**
+   * Starts the thread, which calls the function until stopped
+   *
+   * The thread yields between two calls, so that the function should return
+   * whenever it has no work left.
+   *
+   * \param function Function to call repeatedly
+   * \return True if the thread was started, false if already running
+   */
+  bool start(std::function<void()> function);
+
+  /**
+   * Stops the thread after the current call of the function and waits for it
+   */
+  void stop();
+
+  /// Whether the thread has been started and not stopped
+  bool isRunning() const;
+
+ private:
+  /// Entry point of the thread
+  static void run(void* worker);
+
+  const char* name_;
+  const int core_;
+  const uint32_t stack_size_;
+
+  std::function<void()> function_;
+  /// Set while the thread should keep running
+  std::atomic<bool> is_running_{false};
+  /// Set by the thread when it left its loop
+  std::atomic<bool> is_stopped_{true};
+
+#ifndef ARDUINO_ARCH_ESP32
+  std::thread thread_;
+#endif
+};
+
+}  // namespace utils
+}  // namespace bernd_box